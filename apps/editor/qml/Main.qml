@@ -150,6 +150,14 @@ ApplicationWindow {
                 shortcut: "Ctrl+0"
                 onTriggered: TimelineController.zoomToFit()
             }
+            MenuSeparator {}
+            Action {
+                text: qsTr("Performance &Overlay")
+                shortcut: "Ctrl+Shift+P"
+                checkable: true
+                checked: PreviewController.stats.enabled
+                onTriggered: PreviewController.stats.enabled = checked
+            }
         }
         
         Menu {
@@ -272,7 +280,14 @@ ApplicationWindow {
         id: openDialog
         title: qsTr("Open Project")
         nameFilters: ["Phoenix Project (*.phoenix)", "All files (*)"]
-        onAccepted: ProjectController.openProject(selectedFile)
+        onAccepted: {
+            if (ProjectController.hasRecoveryData(selectedFile)) {
+                recoveryDialog.projectUrl = selectedFile
+                recoveryDialog.open()
+            } else {
+                ProjectController.openProject(selectedFile)
+            }
+        }
     }
     
     FileDialog {
@@ -412,6 +427,35 @@ ApplicationWindow {
         standardButtons: Dialog.Ok
     }
     
+    Dialog {
+        id: recoveryDialog
+        title: qsTr("Recover Unsaved Changes")
+        modal: true
+        closePolicy: Popup.NoAutoClose
+        anchors.centerIn: parent
+        width: 420
+        
+        property url projectUrl
+        
+        background: Rectangle {
+            color: Theme.bg3
+            radius: Theme.radiusLg
+            border.color: Theme.border
+        }
+        
+        Text {
+            width: parent.width
+            color: Theme.textPrimary
+            font.pixelSize: Theme.fontSizeMd
+            wrapMode: Text.WordWrap
+            text: qsTr("Phoenix Editor closed unexpectedly while this project had unsaved changes. Recover them? Choosing No opens the last saved version and discards them.")
+        }
+        
+        standardButtons: Dialog.Yes | Dialog.No
+        onAccepted: ProjectController.openProject(projectUrl, true)
+        onRejected: ProjectController.openProject(projectUrl, false)
+    }
+    
     // ========== Keyboard Shortcuts ==========
     
     Shortcut {
@@ -439,4 +483,14 @@ ApplicationWindow {
         sequence: "K"
         onActivated: PreviewController.pause()
     }
+    
+    Shortcut {
+        sequence: "Up"
+        onActivated: TimelineController.goToPrevClip()
+    }
+    
+    Shortcut {
+        sequence: "Down"
+        onActivated: TimelineController.goToNextClip()
+    }
 }
@@ -97,10 +97,10 @@ Rectangle {
                         color: Theme.bg5
                         radius: Theme.radiusSm
                         
-                        // Video icon placeholder
+                        // Video icon placeholder (warning while the file is missing)
                         Text {
                             anchors.centerIn: parent
-                            text: item.hasVideo ? "🎬" : "🎵"
+                            text: !item.online ? "⚠️" : (item.hasVideo ? "🎬" : "🎵")
                             font.pixelSize: 20
                         }
                     }
@@ -111,10 +111,10 @@ Rectangle {
                         spacing: 2
                         
                         Text {
-                            text: item.name
+                            text: item.online ? item.name : qsTr("%1 (offline)").arg(item.name)
                             font.pixelSize: Theme.fontSizeSm
                             font.weight: Theme.fontWeightMedium
-                            color: Theme.textPrimary
+                            color: item.online ? Theme.textPrimary : Theme.error
                             elide: Text.ElideMiddle
                             Layout.fillWidth: true
                         }
@@ -158,6 +158,15 @@ Rectangle {
                         dragItem.Drag.drop()
                     }
                     
+                    // Start decoding an item the pointer rests on
+                    onEntered: {
+                        if (item.online && item.hasVideo) {
+                            ProjectController.hintMedia(item.id, 0)
+                        }
+                    }
+                    
+                    onExited: ProjectController.cancelMediaHint(item.id)
+                    
                     onDoubleClicked: {
                         // Add to timeline at playhead
                         if (TimelineController.videoTrackCount > 0) {
@@ -72,36 +72,24 @@ Rectangle {
                             PropertyRow {
                                 label: qsTr("Name")
                                 value: {
-                                    let clips = []
-                                    for (let t of TimelineController.videoTracks) {
-                                        for (let c of t.clips) clips.push(c)
-                                    }
-                                    let clip = clips.find(c => c.id === TimelineController.selectedClipId)
-                                    return clip ? clip.name : ""
+                                    let clip = TimelineController.selectedClip
+                                    return clip.id ? clip.name : ""
                                 }
                             }
                             
                             PropertyRow {
                                 label: qsTr("Duration")
                                 value: {
-                                    let clips = []
-                                    for (let t of TimelineController.videoTracks) {
-                                        for (let c of t.clips) clips.push(c)
-                                    }
-                                    let clip = clips.find(c => c.id === TimelineController.selectedClipId)
-                                    return clip ? TimelineController.formatTime(clip.duration) : ""
+                                    let clip = TimelineController.selectedClip
+                                    return clip.id ? TimelineController.formatTime(clip.duration) : ""
                                 }
                             }
                             
                             PropertyRow {
                                 label: qsTr("Position")
                                 value: {
-                                    let clips = []
-                                    for (let t of TimelineController.videoTracks) {
-                                        for (let c of t.clips) clips.push(c)
-                                    }
-                                    let clip = clips.find(c => c.id === TimelineController.selectedClipId)
-                                    return clip ? TimelineController.formatTime(clip.timelineIn) : ""
+                                    let clip = TimelineController.selectedClip
+                                    return clip.id ? TimelineController.formatTime(clip.timelineIn) : ""
                                 }
                             }
                         }
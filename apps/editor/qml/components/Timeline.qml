@@ -246,6 +246,8 @@ Rectangle {
                             height: Theme.trackHeight
                             trackData: modelData
                             pixelsPerSecond: TimelineController.pixelsPerSecond
+                            viewportX: timelineContent.contentX
+                            viewportWidth: timelineContent.width
                         }
                     }
                 }
@@ -3,6 +3,9 @@ import QtQuick.Controls
 
 /**
  * Single clip on the timeline
+ *
+ * Zoomed out, clips too small to draw apart arrive as one block
+ * (clipData.clipCount > 1), which is drawn but not editable.
  */
 Rectangle {
     id: root
@@ -11,11 +14,15 @@ Rectangle {
     property var trackData
     property real pixelsPerSecond: 100
     
+    readonly property bool isBlock: clipData.clipCount > 1
+    readonly property bool editable: !isBlock && !trackData.locked
+    
     x: TimelineController.timeToPixels(clipData.timelineIn)
     width: TimelineController.timeToPixels(clipData.duration)
     height: parent.height
     
-    color: clipData.selected ? 
+    color: isBlock ? Qt.darker(trackData.type === "video" ? Theme.clipVideo : Theme.clipAudio, 1.3) :
+           clipData.selected ? 
            (trackData.type === "video" ? Theme.clipVideoSelected : Theme.clipAudioSelected) :
            (trackData.type === "video" ? Theme.clipVideo : Theme.clipAudio)
     
@@ -33,7 +40,7 @@ Rectangle {
         Text {
             anchors.left: parent.left
             anchors.top: parent.top
-            text: clipData.name
+            text: root.isBlock ? qsTr("%1 clips").arg(clipData.clipCount) : clipData.name
             font.pixelSize: Theme.fontSizeXs
             font.weight: Theme.fontWeightMedium
             color: "white"
@@ -49,14 +56,14 @@ Rectangle {
             font.pixelSize: Theme.fontSizeXs
             font.family: Theme.monoFont
             color: Qt.rgba(1, 1, 1, 0.7)
-            visible: root.width > 60
+            visible: root.width > 60 && !root.isBlock
         }
         
         // Waveform placeholder (for audio)
         Canvas {
             anchors.fill: parent
             anchors.topMargin: 16
-            visible: trackData.type === "audio"
+            visible: trackData.type === "audio" && !root.isBlock
             opacity: 0.5
             
             onPaint: {
@@ -92,6 +99,7 @@ Rectangle {
         MouseArea {
             id: leftHandleArea
             anchors.fill: parent
+            enabled: !root.isBlock
             hoverEnabled: true
             cursorShape: Qt.SizeHorCursor
             
@@ -106,8 +114,9 @@ Rectangle {
             onPositionChanged: {
                 if (pressed) {
                     let delta = mouseX - startX
-                    let newIn = startIn + TimelineController.pixelsToTime(delta)
-                    TimelineController.trimClipStart(clipData.id, Math.max(0, newIn))
+                    let newIn = TimelineController.snapTime(
+                        startIn + TimelineController.pixelsToTime(delta), clipData.clipId)
+                    TimelineController.trimClipStart(clipData.clipId, Math.max(0, newIn))
                 }
             }
         }
@@ -125,6 +134,7 @@ Rectangle {
         MouseArea {
             id: rightHandleArea
             anchors.fill: parent
+            enabled: !root.isBlock
             hoverEnabled: true
             cursorShape: Qt.SizeHorCursor
             
@@ -139,8 +149,9 @@ Rectangle {
             onPositionChanged: {
                 if (pressed) {
                     let delta = mouseX - startX
-                    let newOut = startOut + TimelineController.pixelsToTime(delta)
-                    TimelineController.trimClipEnd(clipData.id, newOut)
+                    let newOut = TimelineController.snapTime(
+                        startOut + TimelineController.pixelsToTime(delta), clipData.clipId)
+                    TimelineController.trimClipEnd(clipData.clipId, newOut)
                 }
             }
         }
@@ -153,14 +164,14 @@ Rectangle {
         anchors.leftMargin: 6
         anchors.rightMargin: 6
         hoverEnabled: true
-        cursorShape: trackData.locked ? Qt.ForbiddenCursor : Qt.OpenHandCursor
+        cursorShape: root.editable ? Qt.OpenHandCursor : Qt.ForbiddenCursor
         
         property real startX: 0
         property real startClipX: 0
         
         onPressed: {
-            if (!trackData.locked) {
-                TimelineController.selectClip(clipData.id)
+            if (root.editable) {
+                TimelineController.selectClip(clipData.clipId)
                 startX = mouse.x
                 startClipX = root.x
                 cursorShape = Qt.ClosedHandCursor
@@ -171,12 +182,26 @@ Rectangle {
             cursorShape = Qt.OpenHandCursor
         }
         
+        // Start decoding a clip the pointer rests on
+        onEntered: {
+            if (clipData.mediaId) {
+                ProjectController.hintMedia(clipData.mediaId, clipData.sourceIn)
+            }
+        }
+        
+        onExited: {
+            if (!clipData.selected) {
+                ProjectController.cancelMediaHint(clipData.mediaId)
+            }
+        }
+        
         onPositionChanged: {
-            if (pressed && !trackData.locked) {
+            if (pressed && root.editable) {
                 let delta = mouse.x - startX
                 let newX = startClipX + delta
-                let newTime = TimelineController.pixelsToTime(newX)
-                TimelineController.moveClip(clipData.id, trackData.id, Math.max(0, newTime))
+                let newTime = TimelineController.snapClipPosition(
+                    clipData.clipId, Math.max(0, TimelineController.pixelsToTime(newX)))
+                TimelineController.moveClip(clipData.clipId, trackData.id, newTime)
             }
         }
         
@@ -189,9 +214,10 @@ Rectangle {
     MouseArea {
         anchors.fill: parent
         acceptedButtons: Qt.RightButton
+        enabled: !root.isBlock
         
         onClicked: {
-            TimelineController.selectClip(clipData.id)
+            TimelineController.selectClip(clipData.clipId)
             contextMenu.popup()
         }
     }
@@ -201,14 +227,14 @@ Rectangle {
         
         Action {
             text: qsTr("Split at Playhead")
-            onTriggered: TimelineController.splitClipAtPlayhead(clipData.id)
+            onTriggered: TimelineController.splitClipAtPlayhead(clipData.clipId)
         }
         
         MenuSeparator {}
         
         Action {
             text: qsTr("Delete")
-            onTriggered: TimelineController.deleteClip(clipData.id)
+            onTriggered: TimelineController.deleteClip(clipData.clipId)
         }
     }
     
@@ -3,6 +3,8 @@ import QtQuick.Controls
 
 /**
  * Single timeline track containing clips
+ *
+ * Only clips within the viewport get delegates; see TimelineClipModel.
  */
 Rectangle {
     id: root
@@ -10,6 +12,26 @@ Rectangle {
     property var trackData
     property real pixelsPerSecond: 100
     
+    // Visible part of the track, in content pixels
+    property real viewportX: 0
+    property real viewportWidth: width
+    
+    readonly property QtObject clipModel: TimelineController.clipModel(trackData.id)
+    
+    Binding {
+        target: root.clipModel
+        property: "viewportX"
+        value: root.viewportX
+        when: root.clipModel !== null
+    }
+    
+    Binding {
+        target: root.clipModel
+        property: "viewportWidth"
+        value: root.viewportWidth
+        when: root.clipModel !== null
+    }
+    
     color: trackData.type === "video" ? Theme.videoTrack : Theme.audioTrack
     
     // Track content
@@ -20,10 +42,10 @@ Rectangle {
         
         // Clips
         Repeater {
-            model: trackData.clips || []
+            model: root.clipModel
             
             delegate: TimelineClip {
-                clipData: modelData
+                clipData: model
                 trackData: root.trackData
                 pixelsPerSecond: root.pixelsPerSecond
             }
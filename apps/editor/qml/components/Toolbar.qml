@@ -29,7 +29,10 @@ Rectangle {
         ToolButton {
             icon.source: "qrc:/Phoenix/resources/icons/undo.svg"
             enabled: ProjectController.canUndo
-            ToolTip.text: qsTr("Undo (Ctrl+Z)")
+            ToolTip.text: qsTr("Undo (Ctrl+Z)") + "\n" +
+                          qsTr("History: %1 of %2 MB")
+                              .arg((ProjectController.undoMemoryUsage / 1048576).toFixed(1))
+                              .arg((ProjectController.undoMemoryLimit / 1048576).toFixed(0))
             ToolTip.visible: hovered
             onClicked: ProjectController.undo()
         }
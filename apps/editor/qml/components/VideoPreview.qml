@@ -38,30 +38,18 @@ Rectangle {
             border.color: Theme.border
             border.width: 1
             
-            Image {
-                id: previewImage
+            // Engine frames, uploaded straight to a texture
+            PreviewItem {
+                id: previewItem
                 anchors.fill: parent
                 anchors.margins: 1
-                fillMode: Image.PreserveAspectFit
-                cache: false
-                
-                // Use image provider
-                source: "image://preview/frame"
-                
-                // Refresh when frame changes
-                Connections {
-                    target: PreviewController
-                    function onFrameChanged() {
-                        previewImage.source = ""
-                        previewImage.source = "image://preview/frame?" + Date.now()
-                    }
-                }
+                controller: PreviewController
             }
             
             // No content placeholder
             Column {
                 anchors.centerIn: parent
-                visible: !previewImage.status === Image.Ready || 
+                visible: !previewItem.hasFrame || 
                          ProjectController.mediaItems.length === 0
                 spacing: Theme.spacingSm
                 
@@ -109,6 +97,63 @@ Rectangle {
         }
     }
     
+    // Performance overlay (View > Performance Overlay)
+    Rectangle {
+        id: statsOverlay
+        
+        readonly property QtObject stats: PreviewController.stats
+        
+        function ms(value) { return value.toFixed(1) + " ms" }
+        
+        visible: stats.enabled
+        anchors.bottom: parent.bottom
+        anchors.left: parent.left
+        anchors.margins: Theme.spacingMd
+        width: statsText.width + Theme.spacingSm * 2
+        height: statsText.height + Theme.spacingSm * 2
+        color: Theme.bg1
+        opacity: 0.85
+        radius: Theme.radiusSm
+        
+        // One text item, updated once per sample
+        Text {
+            id: statsText
+            anchors.centerIn: parent
+            font.pixelSize: Theme.fontSizeXs
+            font.family: Theme.monoFont
+            color: Theme.textSecondary
+            text: {
+                let s = statsOverlay.stats
+                if (!statsOverlay.visible) return ""
+                return [
+                    qsTr("Frames   %1 fps, %2 dropped/s")
+                        .arg(s.deliveredFps.toFixed(1))
+                        .arg(s.droppedFps.toFixed(1)),
+                    qsTr("Decode   p50 %1  p95 %2  p99 %3")
+                        .arg(statsOverlay.ms(s.decodeP50))
+                        .arg(statsOverlay.ms(s.decodeP95))
+                        .arg(statsOverlay.ms(s.decodeP99)),
+                    qsTr("Compose  p50 %1  p95 %2  p99 %3")
+                        .arg(statsOverlay.ms(s.composeP50))
+                        .arg(statsOverlay.ms(s.composeP95))
+                        .arg(statsOverlay.ms(s.composeP99)),
+                    qsTr("Seek     %1").arg(statsOverlay.ms(s.seekLatency)),
+                    qsTr("Cache    %1% hits, %2 frames, %3 MB")
+                        .arg((s.cacheHitRate * 100).toFixed(0))
+                        .arg(s.cacheFrames)
+                        .arg(s.cacheMemoryMB.toFixed(0)),
+                    qsTr("Decoders %1 active, %2 pooled, %3 queued")
+                        .arg(s.activeDecoders)
+                        .arg(s.pooledDecoders)
+                        .arg(s.queuedJobs),
+                    qsTr("Prefetch %1 / %2 frames ahead")
+                        .arg(s.prefetchHorizon)
+                        .arg(s.prefetchLookahead)
+                ].join("\n")
+            }
+        }
+    }
+    
     // Playback indicator
     Rectangle {
         anchors.top: parent.top
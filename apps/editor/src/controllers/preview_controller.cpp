@@ -6,50 +6,34 @@
 #include "preview_controller.hpp"
 #include "project_controller.hpp"
 #include "timeline_controller.hpp"
+#include "../preview_stats.hpp"
+#include "../qt_dispatcher.hpp"
 
 #include <phoenix/model/project.hpp>
 #include <phoenix/model/sequence.hpp>
+#include <phoenix/model/sequence_snapshot.hpp>
 #include <phoenix/engine/playback_engine.hpp>
 #include <phoenix/engine/compositor.hpp>
-#include <phoenix/media/decoder_pool.hpp>
+#include <phoenix/engine/media_service.hpp>
 #include <phoenix/media/frame.hpp>
 
+#include <QGuiApplication>
 #include <QMutexLocker>
+#include <QScreen>
 
-namespace phoenix::editor {
+#include <algorithm>
+#include <chrono>
 
-// ============================================================================
-// PreviewImageProvider
-// ============================================================================
+namespace phoenix::editor {
 
-PreviewImageProvider::PreviewImageProvider()
-    : QQuickImageProvider(QQuickImageProvider::Image)
-{}
+namespace {
 
-QImage PreviewImageProvider::requestImage(const QString& id, QSize* size,
-                                          const QSize& requestedSize) {
-    Q_UNUSED(id)
-    
-    QMutexLocker locker(&m_mutex);
-    
-    QImage result = m_currentFrame;
-    
-    if (size) {
-        *size = result.size();
-    }
-    
-    if (requestedSize.isValid() && !result.isNull()) {
-        result = result.scaled(requestedSize, Qt::KeepAspectRatio, 
-                               Qt::SmoothTransformation);
-    }
-    
-    return result;
+int64_t steadyMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-void PreviewImageProvider::setCurrentFrame(const QImage& image) {
-    QMutexLocker locker(&m_mutex);
-    m_currentFrame = image;
-}
+} // namespace
 
 // ============================================================================
 // PreviewController
@@ -61,8 +45,21 @@ PreviewController::PreviewController(ProjectController* projectController,
     : QObject(parent)
     , m_projectController(projectController)
     , m_timelineController(timelineController)
-    , m_imageProvider(new PreviewImageProvider())
+    , m_stats(new PreviewStats(this))
 {
+    // Scrub drafts at most once per displayed frame
+    qreal refreshRate = 60.0;
+    if (auto* screen = QGuiApplication::primaryScreen()) {
+        refreshRate = std::max(screen->refreshRate(), qreal(1.0));
+    }
+    m_scrubTimer.setTimerType(Qt::PreciseTimer);
+    m_scrubTimer.setInterval(std::max(1, qRound(1000.0 / refreshRate)));
+    connect(&m_scrubTimer, &QTimer::timeout, this, &PreviewController::onScrubTick);
+    
+    m_settleTimer.setSingleShot(true);
+    m_settleTimer.setInterval(kScrubSettleMs);
+    connect(&m_settleTimer, &QTimer::timeout, this, &PreviewController::onScrubSettled);
+    
     setupEngine();
     
     // Connect to timeline playhead changes
@@ -77,84 +74,138 @@ PreviewController::PreviewController(ProjectController* projectController,
                 emit durationChanged();
                 emit previewSizeChanged();
             });
+    
+    // Drop decoders and frames of media that changed on disk
+    connect(m_projectController, &ProjectController::mediaStatusChanged,
+            this, &PreviewController::onMediaStatusChanged);
 }
 
 PreviewController::~PreviewController() = default;
 
 void PreviewController::setupEngine() {
+    // The engine's threads use the compositor; retire them first
+    m_stats->clearSources();
+    m_playbackEngine.reset();
+    m_projectConnections.clear();
+    
     auto* project = m_projectController->project();
     if (!project) return;
     
     auto sequence = project->activeSequence();
     if (!sequence) return;
     
-    // Create decoder pool
-    m_decoderPool = std::make_unique<media::DecoderPool>();
-    
     // Create compositor
     int width = sequence->settings().resolution.width;
     int height = sequence->settings().resolution.height;
     m_compositor = std::make_unique<engine::Compositor>(width, height);
     m_compositor->setSequence(sequence.get());
     
-    // Set up frame decoder callback
-    m_compositor->setFrameDecoder([this](const engine::FrameRequest& request) 
+    // Re-render only when an edit touches the displayed frame
+    m_sequenceConnection = sequence->changed.connectScoped(
+        [this](const model::SequenceChange& change) {
+            onSequenceChanged(change);
+        });
+    
+    // Decode through the shared media service, as the program viewer
+    m_mediaClient = m_projectController->mediaService()->attach(
+        "Program", engine::MediaPriority::Visible);
+    
+    m_compositor->setFrameDecoder([client = m_mediaClient](const engine::FrameRequest& request) 
         -> std::shared_ptr<media::VideoFrame> {
-        auto* project = m_projectController->project();
-        if (!project) return nullptr;
-        
-        auto mediaItem = project->mediaBin().getItem(request.mediaItemId);
-        if (!mediaItem) return nullptr;
-        
-        // Use convenience method that handles acquire/release
-        auto result = m_decoderPool->decodeFrame(
-            mediaItem->path(), request.mediaTime);
+        auto frame = client->decodeFrame(request.mediaItemId, request.mediaTime);
         
-        if (!result) return nullptr;
-        return std::make_shared<media::VideoFrame>(std::move(result.value()));
+        // Keep the service's workers a few frames ahead of playback
+        if (client->priority() == engine::MediaPriority::Playback) {
+            client->prefetch(request.mediaItemId, request.mediaTime, kPlaybackLookahead);
+        }
+        return frame;
+    });
+    
+    // Nested clips render through child compositors; loading the
+    // active sequence already loaded the sequences it nests. The
+    // resolver runs on render threads, so it reads the published map.
+    publishSequences();
+    auto republish = [this](const auto&) { publishSequences(); };
+    m_projectConnections.push_back(project->sequenceAdded.connectScoped(republish));
+    m_projectConnections.push_back(project->sequenceRemoved.connectScoped(republish));
+    m_projectConnections.push_back(project->sequenceLoaded.connectScoped(republish));
+    
+    m_compositor->setSequenceResolver([this](const UUID& sequenceId)
+        -> std::shared_ptr<const model::Sequence> {
+        auto sequences = m_loadedSequences.load(std::memory_order_acquire);
+        if (!sequences) return nullptr;
+        auto it = sequences->find(sequenceId);
+        return it != sequences->end() ? it->second : nullptr;
     });
     
     // Create playback engine
     m_playbackEngine = std::make_unique<engine::PlaybackEngine>();
     m_playbackEngine->setSequence(sequence.get());
     m_playbackEngine->setCompositor(m_compositor.get());
+    m_playbackEngine->setFrameCache(m_projectController->mediaService()->frameCache());
     
-    // Connect frame callback
+    // Connect frame callback (playback or seek thread)
     m_playbackEngine->onFrame([this](auto frame, auto pts) {
         Q_UNUSED(pts)
-        if (frame) {
-            m_currentFrame = frameToImage(frame);
-            m_imageProvider->setCurrentFrame(m_currentFrame);
-            emit frameChanged();
-        }
+        deliverFrame(frame);
     });
     
-    // Connect signals (ignore returned Connection, engine lifetime manages connections)
-    (void)m_playbackEngine->stateChanged.connect([this](engine::PlaybackState state) {
-        emit playbackStateChanged();
+    // Engine signals fire on the playback thread; deliver them on the UI
+    // thread. Position is coalesced to the latest value per event loop turn.
+    // (Returned Connections are ignored; engine lifetime manages them.)
+    auto dispatcher = std::make_shared<QtDispatcher>(this);
+    
+    // Playing preempts background viewers and thumbnail work; switch
+    // on the playback thread rather than an event loop turn later
+    (void)m_playbackEngine->stateChanged.connect(
+        [client = m_mediaClient](engine::PlaybackState state) {
+            client->setPriority(state == engine::PlaybackState::Playing
+                ? engine::MediaPriority::Playback
+                : engine::MediaPriority::Visible);
+        });
+    
+    (void)m_playbackEngine->stateChanged.connectQueued(dispatcher,
+        [this](engine::PlaybackState state) {
+            emit playbackStateChanged();
         
-        switch (state) {
-            case engine::PlaybackState::Playing:
-                emit playbackStarted();
-                break;
-            case engine::PlaybackState::Paused:
-                emit playbackPaused();
-                break;
-            case engine::PlaybackState::Stopped:
-                emit playbackStopped();
-                break;
-            default:
-                break;
-        }
-    });
+            switch (state) {
+                case engine::PlaybackState::Playing:
+                    emit playbackStarted();
+                    break;
+                case engine::PlaybackState::Paused:
+                    emit playbackPaused();
+                    break;
+                case engine::PlaybackState::Stopped:
+                    emit playbackStopped();
+                    break;
+                default:
+                    break;
+            }
+        }, QueuedDelivery::Every);
     
-    (void)m_playbackEngine->positionChanged.connect([this](Timestamp pos) {
-        m_timelineController->setPlayheadPosition(pos);
-        emit positionChanged();
-    });
+    (void)m_playbackEngine->positionChanged.connectQueued(dispatcher,
+        [this](Timestamp pos) {
+            m_timelineController->setPlayheadPosition(pos);
+            emit positionChanged();
+        });
+    
+    m_stats->setSources(m_playbackEngine.get(), m_projectController->mediaService(),
+                        m_mediaClient, static_cast<int>(kPlaybackLookahead));
     
     // Render initial frame
-    renderCurrentFrame();
+    m_playbackEngine->seek(m_timelineController->playheadPosition());
+}
+
+void PreviewController::publishSequences() {
+    auto sequences = std::make_shared<SequenceMap>();
+    if (auto* project = m_projectController->project()) {
+        for (const auto& seq : project->sequences()) {
+            if (project->isSequenceLoaded(seq->id())) {
+                sequences->emplace(seq->id(), seq);
+            }
+        }
+    }
+    m_loadedSequences.store(std::move(sequences), std::memory_order_release);
 }
 
 // ============================================================================
@@ -163,6 +214,7 @@ void PreviewController::setupEngine() {
 
 void PreviewController::play() {
     if (m_playbackEngine) {
+        stopScrubbing();
         m_playbackEngine->setPlaybackSpeed(m_playbackSpeed);
         m_playbackEngine->setLooping(m_looping);
         m_playbackEngine->play();
@@ -196,35 +248,32 @@ void PreviewController::togglePlayPause() {
 void PreviewController::stepForward() {
     if (m_playbackEngine) {
         m_playbackEngine->stepForward();
-        renderCurrentFrame();
     }
 }
 
 void PreviewController::stepBackward() {
     if (m_playbackEngine) {
         m_playbackEngine->stepBackward();
-        renderCurrentFrame();
     }
 }
 
 void PreviewController::goToStart() {
     if (m_playbackEngine) {
         m_playbackEngine->goToStart();
-        renderCurrentFrame();
     }
 }
 
 void PreviewController::goToEnd() {
     if (m_playbackEngine) {
         m_playbackEngine->goToEnd();
-        renderCurrentFrame();
     }
 }
 
 void PreviewController::seek(qint64 position) {
     if (m_playbackEngine) {
+        markFirstPixelRequest();
+        m_mediaClient->cancelPending();  // Lookahead of the old position
         m_playbackEngine->seek(position);
-        renderCurrentFrame();
     }
 }
 
@@ -299,6 +348,14 @@ QString PreviewController::frameInfo() const {
         .arg(m_timelineController->formatTime(duration()));
 }
 
+double PreviewController::timeToFirstPixel() const {
+    return m_timeToFirstPixel.load() / 1000.0;
+}
+
+QObject* PreviewController::stats() const {
+    return m_stats;
+}
+
 // ============================================================================
 // Private Slots
 // ============================================================================
@@ -308,6 +365,73 @@ void PreviewController::onFrameReady() {
 }
 
 void PreviewController::onPlayheadChanged() {
+    if (!m_playbackEngine || isPlaying()) return;
+    
+    // Echo of the engine's own position (seek(), stepping)
+    Timestamp playhead = m_timelineController->playheadPosition();
+    if (playhead == m_playbackEngine->currentTime()) return;
+    
+    if (!m_settleTimer.isActive()) {
+        // First move after a rest (a click, or the start of a drag):
+        // render it exactly
+        markFirstPixelRequest();
+        m_mediaClient->cancelPending();
+        m_draftInFlight = false;
+        m_playbackEngine->seek(playhead);
+    } else {
+        // Moving again before settling: a drag; drafts follow on the
+        // display refresh
+        m_scrubbing = true;
+        m_scrubDirty = true;
+        if (!m_scrubTimer.isActive()) {
+            m_scrubTimer.start();
+            onScrubTick();
+        }
+    }
+    m_settleTimer.start();
+}
+
+void PreviewController::onScrubTick() {
+    if (!m_playbackEngine || !m_scrubDirty) {
+        m_scrubTimer.stop();
+        return;
+    }
+    
+    // One draft at a time: a newer one would discard it half done,
+    // and a fast drag would then show nothing at all
+    if (m_draftInFlight && m_playbackEngine->seekPending()) return;
+    
+    m_scrubDirty = false;
+    m_draftInFlight = true;
+    m_playbackEngine->seek(m_timelineController->playheadPosition(),
+                           engine::RenderQuality::Draft);
+}
+
+void PreviewController::onScrubSettled() {
+    bool wasScrubbing = m_scrubbing;
+    stopScrubbing();
+    
+    // The playhead rests: replace the draft with the exact frame
+    if (wasScrubbing && m_playbackEngine && !isPlaying()) {
+        m_playbackEngine->seek(m_timelineController->playheadPosition());
+    }
+}
+
+void PreviewController::onSequenceChanged(const model::SequenceChange& change) {
+    emit durationChanged();
+    
+    if (!isPlaying() && change.contains(m_timelineController->playheadPosition())) {
+        renderCurrentFrame();
+    }
+}
+
+void PreviewController::onMediaStatusChanged(const QString& id) {
+    Q_UNUSED(id)
+    
+    // The media service has already dropped the item's decoders and
+    // frames; nested output may include the item too
+    if (m_compositor) m_compositor->clearNestedCache();
+    
     if (!isPlaying()) {
         renderCurrentFrame();
     }
@@ -318,52 +442,84 @@ void PreviewController::onPlayheadChanged() {
 // ============================================================================
 
 void PreviewController::renderCurrentFrame() {
-    if (!m_compositor) return;
+    // Composed on the engine's seek thread; arrives through onFrame
+    if (m_playbackEngine) {
+        m_playbackEngine->refreshFrame();
+    }
+}
+
+void PreviewController::stopScrubbing() {
+    m_scrubTimer.stop();
+    m_settleTimer.stop();
+    m_scrubbing = false;
+    m_scrubDirty = false;
+    m_draftInFlight = false;
+}
+
+void PreviewController::markFirstPixelRequest() {
+    // Drafts do not restart the clock: a drag is timed from its start
+    m_firstPixelRequestedAt = steadyMicroseconds();
+}
+
+void PreviewController::deliverFrame(const std::shared_ptr<media::VideoFrame>& frame) {
+    QImage image = frameToImage(frame);
+    if (image.isNull()) return;
     
-    qint64 time = m_timelineController->playheadPosition();
-    auto result = m_compositor->compose(time);
+    if (int64_t requestedAt = m_firstPixelRequestedAt.exchange(0)) {
+        m_timeToFirstPixel = steadyMicroseconds() - requestedAt;
+    }
     
-    if (result.frame) {
-        m_currentFrame = frameToImage(result.frame);
-        m_imageProvider->setCurrentFrame(m_currentFrame);
-        emit frameChanged();
+    {
+        QMutexLocker locker(&m_frameMutex);
+        m_currentFrame = image;
     }
+    
+    emit frameReady(image);
+    emit frameChanged();
 }
 
-QImage PreviewController::frameToImage(
-    const std::shared_ptr<media::VideoFrame>& frame) 
-{
+QImage PreviewController::currentFrame() const {
+    QMutexLocker locker(&m_frameMutex);
+    return m_currentFrame;
+}
+
+QImage PreviewController::frameToImage(std::shared_ptr<media::VideoFrame> frame) {
     if (!frame || !frame->isValid()) {
         return QImage();
     }
     
     // Transfer to CPU if hardware frame
-    media::VideoFrame cpuFrame;
     if (frame->isHardwareFrame()) {
         auto result = frame->transferToCPU();
         if (!result) {
             return QImage();
         }
-        cpuFrame = std::move(result.value());
-    } else {
-        cpuFrame = *frame;
+        frame = std::make_shared<media::VideoFrame>(std::move(result.value()));
     }
     
-    int width = cpuFrame.width();
-    int height = cpuFrame.height();
-    
-    // Create QImage from frame data
-    // Assuming RGBA format for now
-    QImage image(width, height, QImage::Format_RGBA8888);
+    QImage::Format format;
+    switch (frame->format()) {
+        case PixelFormat::RGBA:  format = QImage::Format_RGBA8888; break;
+        case PixelFormat::BGRA:  format = QImage::Format_ARGB32; break;  // Little-endian
+        case PixelFormat::RGB24: format = QImage::Format_RGB888; break;
+        default:
+            return QImage();  // Planar formats need converting first
+    }
     
-    const uint8_t* src = cpuFrame.data(0);
-    int srcStride = cpuFrame.linesize(0);
+    // Wrap the frame's pixels; the image keeps the frame alive and
+    // copies only if someone writes to it
+    const uint8_t* data = frame->data(0);
+    if (!data) return QImage();
     
-    for (int y = 0; y < height; ++y) {
-        memcpy(image.scanLine(y), src + y * srcStride, width * 4);
-    }
+    int width = frame->width();
+    int height = frame->height();
+    qsizetype stride = frame->linesize(0);
+    auto* owner = new std::shared_ptr<media::VideoFrame>(std::move(frame));
     
-    return image;
+    return QImage(data, width, height, stride, format,
+                  [](void* info) {
+                      delete static_cast<std::shared_ptr<media::VideoFrame>*>(info);
+                  }, owner);
 }
 
 } // namespace phoenix::editor
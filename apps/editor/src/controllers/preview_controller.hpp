@@ -10,17 +10,27 @@
 
 #include <QObject>
 #include <QImage>
-#include <QQuickImageProvider>
 #include <QMutex>
+#include <QTimer>
+#include <phoenix/core/signals.hpp>
+#include <phoenix/core/uuid.hpp>
+#include <atomic>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace phoenix::engine {
     class PlaybackEngine;
     class Compositor;
+    class MediaClient;
+}
+
+namespace phoenix::model {
+    class Sequence;
+    struct SequenceChange;
 }
 
 namespace phoenix::media {
-    class DecoderPool;
     class VideoFrame;
 }
 
@@ -28,23 +38,7 @@ namespace phoenix::editor {
 
 class ProjectController;
 class TimelineController;
-
-/**
- * @brief Preview image provider for QML
- */
-class PreviewImageProvider : public QQuickImageProvider {
-public:
-    PreviewImageProvider();
-    
-    QImage requestImage(const QString& id, QSize* size, 
-                        const QSize& requestedSize) override;
-    
-    void setCurrentFrame(const QImage& image);
-    
-private:
-    QImage m_currentFrame;
-    mutable QMutex m_mutex;
-};
+class PreviewStats;
 
 /**
  * @brief Preview controller for QML
@@ -54,6 +48,15 @@ private:
  * - Frame stepping
  * - Playback speed
  * - Loop mode
+ * 
+ * Frames are shown by a PreviewItem connected to frameReady().
+ *  
+ * Scrubbing: while the playhead is dragged, positions are coalesced
+ * to the display refresh rate and rendered as drafts (nearby cached
+ * frames or keyframes). The exact frame follows once the playhead
+ * has rested for kScrubSettleMs.
+ * 
+ * stats exposes sampled performance figures for the preview overlay.
  */
 class PreviewController : public QObject {
     Q_OBJECT
@@ -79,6 +82,10 @@ class PreviewController : public QObject {
     
     // Frame info
     Q_PROPERTY(QString frameInfo READ frameInfo NOTIFY frameChanged)
+    Q_PROPERTY(double timeToFirstPixel READ timeToFirstPixel NOTIFY frameChanged)
+    
+    // Performance
+    Q_PROPERTY(QObject* stats READ stats CONSTANT)
 
 public:
     PreviewController(ProjectController* projectController,
@@ -123,9 +130,16 @@ public:
     
     QString frameInfo() const;
     
-    // ========== Image Provider ==========
+    /// Milliseconds from the latest seek or scrub start to its first frame
+    double timeToFirstPixel() const;
     
-    PreviewImageProvider* imageProvider() const { return m_imageProvider; }
+    /// PreviewStats, sampled while its overlay is shown
+    QObject* stats() const;
+    
+    // ========== Frames ==========
+    
+    /// Latest frame (thread-safe; shares the engine frame's pixels)
+    QImage currentFrame() const;
 
 signals:
     void playbackStateChanged();
@@ -136,6 +150,15 @@ signals:
     void previewSizeChanged();
     void frameChanged();
     
+    /**
+     * @brief A new frame is ready
+     * 
+     * Emitted on the engine thread that produced it. The image wraps
+     * the engine frame without copying and keeps it alive; connect
+     * with Qt::DirectConnection to avoid an event loop hop.
+     */
+    void frameReady(const QImage& frame);
+    
     void playbackStarted();
     void playbackPaused();
     void playbackStopped();
@@ -143,23 +166,57 @@ signals:
 private slots:
     void onFrameReady();
     void onPlayheadChanged();
+    void onScrubTick();
+    void onScrubSettled();
 
 private:
     void setupEngine();
+    void publishSequences();
     void renderCurrentFrame();
-    QImage frameToImage(const std::shared_ptr<media::VideoFrame>& frame);
+    void onSequenceChanged(const model::SequenceChange& change);
+    void onMediaStatusChanged(const QString& id);
+    static QImage frameToImage(std::shared_ptr<media::VideoFrame> frame);
+    void deliverFrame(const std::shared_ptr<media::VideoFrame>& frame);
+    void markFirstPixelRequest();
+    void stopScrubbing();
+    
+    static constexpr size_t kPlaybackLookahead = 6;  // Frames prefetched while playing
+    static constexpr int kScrubSettleMs = 150;       // Rest before the exact frame
     
     ProjectController* m_projectController;
     TimelineController* m_timelineController;
     
+    // Loaded sequences by ID for the nested-sequence resolver. Rebuilt
+    // on the UI thread and swapped in whole; render threads only load
+    // the pointer, never the project's own containers. Declared before
+    // the engine so it outlives the engine's threads.
+    using SequenceMap = std::unordered_map<UUID, std::shared_ptr<const model::Sequence>>;
+    std::atomic<std::shared_ptr<const SequenceMap>> m_loadedSequences;
+    std::vector<ScopedConnection> m_projectConnections;
+    
     std::unique_ptr<engine::PlaybackEngine> m_playbackEngine;
     std::unique_ptr<engine::Compositor> m_compositor;
-    std::unique_ptr<media::DecoderPool> m_decoderPool;
+    std::shared_ptr<engine::MediaClient> m_mediaClient;  // On the project's MediaService
+    
+    ScopedConnection m_sequenceConnection;
     
-    PreviewImageProvider* m_imageProvider;  // Owned by QML engine
+    PreviewStats* m_stats;  // Child object
     
     double m_playbackSpeed = 1.0;
     bool m_looping = false;
+    
+    // Scrubbing (UI thread)
+    QTimer m_scrubTimer;        // Display refresh interval
+    QTimer m_settleTimer;       // Single-shot, restarted by every move
+    bool m_scrubbing = false;
+    bool m_scrubDirty = false;  // Playhead moved since the last draft
+    bool m_draftInFlight = false;
+    
+    // Time to first pixel (steady clock, µs; 0 = none pending)
+    std::atomic<int64_t> m_firstPixelRequestedAt{0};
+    std::atomic<int64_t> m_timeToFirstPixel{0};
+    
+    mutable QMutex m_frameMutex;
     QImage m_currentFrame;
 };
 
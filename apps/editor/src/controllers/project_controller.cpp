@@ -4,30 +4,61 @@
  */
 
 #include "project_controller.hpp"
+#include "../qt_dispatcher.hpp"
 
 #include <phoenix/model/project.hpp>
 #include <phoenix/model/media_item.hpp>
 #include <phoenix/model/media_bin.hpp>
+#include <phoenix/model/media_status_service.hpp>
 #include <phoenix/model/commands/undo_stack.hpp>
+#include <phoenix/model/io/project_io.hpp>
+#include <phoenix/model/io/project_journal.hpp>
 #include <phoenix/media/media_info.hpp>
+#include <phoenix/engine/media_service.hpp>
 #include <phoenix/core/logger.hpp>
 
 #include <QFileInfo>
 #include <QDir>
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <unordered_set>
 
 namespace phoenix::editor {
 
 ProjectController::ProjectController(QObject* parent)
     : QObject(parent)
     , m_undoStack(std::make_unique<model::UndoStack>())
+    , m_mediaStatus(std::make_unique<model::MediaStatusService>(
+          std::make_shared<QtDispatcher>(this)))
+    , m_mediaService(std::make_unique<engine::MediaService>())
 {
+    // Viewers and workers look media up in whichever project is open
+    m_mediaService->setMediaResolver([this](const UUID& id)
+        -> std::optional<engine::MediaSource> {
+        if (!m_project) return std::nullopt;
+        auto item = m_project->mediaBin().getItem(id);
+        if (!item) return std::nullopt;
+        return engine::MediaSource{item->path(), item->videoProperties().frameRate};
+    });
+    
+    // Hints wait behind visible viewers and pause during playback
+    m_hintClient = m_mediaService->attach("Hints", engine::MediaPriority::Background);
+    m_probeClient = m_mediaService->attach("Probe", engine::MediaPriority::Background);
+    m_hintTimer.setSingleShot(true);
+    m_hintTimer.setInterval(kHintDelayMs);
+    connect(&m_hintTimer, &QTimer::timeout, this, &ProjectController::startHint);
+    
     setupConnections();
+    m_mediaStatus->start();
     newProject();  // Start with empty project
 }
 
-ProjectController::~ProjectController() = default;
+ProjectController::~ProjectController() {
+    stopJournal();
+    m_mediaStatus->detach();
+}
 
 void ProjectController::setupConnections() {
     // Connect undo stack signals (ignore returned Connection)
@@ -39,6 +70,11 @@ void ProjectController::setupConnections() {
     (void)m_undoStack->cleanChanged.connect([this](bool) {
         emit modifiedChanged();
     });
+    
+    (void)m_mediaStatus->statusChanged.connect(
+        [this](const std::shared_ptr<model::MediaItem>& item, model::MediaStatus) {
+            onMediaStatusChanged(item);
+        });
 }
 
 // ============================================================================
@@ -46,10 +82,16 @@ void ProjectController::setupConnections() {
 // ============================================================================
 
 void ProjectController::newProject() {
+    stopJournal();
+    m_mediaStatus->detach();
+    cancelMediaHint(m_hintMediaId);
+    m_mediaService->clear();
     m_project = std::make_unique<model::Project>();
     m_projectPath.clear();
+    m_recovered = false;
     m_undoStack->clear();
     
+    watchMedia();
     updateMediaItems();
     
     emit projectChanged();
@@ -57,30 +99,56 @@ void ProjectController::newProject() {
     emit statusMessage(tr("New project created"));
 }
 
-bool ProjectController::openProject(const QUrl& url) {
+bool ProjectController::openProject(const QUrl& url, bool recover) {
     QString path = url.toLocalFile();
+    std::filesystem::path fsPath = path.toStdString();
     
-    // TODO: Implement JSON deserialization
-    // auto result = model::ProjectIO::load(path.toStdString());
-    // if (!result) {
-    //     emit errorOccurred(tr("Failed to open project: %1").arg(QString::fromStdString(result.error().message)));
-    //     return false;
-    // }
+    bool recovered = recover && model::ProjectJournal::hasRecoveryData(fsPath);
+    auto result = recovered
+        ? model::ProjectJournal::recover(fsPath)
+        : model::ProjectIO::load(fsPath);
+    if (!result) {
+        emit errorOccurred(tr("Failed to open project: %1")
+            .arg(QString::fromStdString(result.error().message())));
+        return false;
+    }
     
-    // m_project = std::move(result.value());
+    stopJournal();
+    if (!recovered) {
+        // The user chose the saved file over what a crash left behind
+        model::ProjectJournal::discardRecoveryData(fsPath);
+    }
+    m_mediaStatus->detach();
+    cancelMediaHint(m_hintMediaId);
+    m_mediaService->clear();
+    m_project = std::move(result.value());
     m_projectPath = path;
+    m_recovered = recovered;
     m_undoStack->clear();
     m_undoStack->setClean();
     
+    startJournal();
+    watchMedia();
     updateMediaItems();
     
     emit projectChanged();
     emit settingsChanged();
-    emit statusMessage(tr("Project opened: %1").arg(path));
+    emit statusMessage(recovered
+        ? tr("Recovered unsaved changes: %1").arg(path)
+        : tr("Project opened: %1").arg(path));
+    emit modifiedChanged();
     
     return true;
 }
 
+bool ProjectController::hasRecoveryData(const QUrl& url) const {
+    QString path = url.toLocalFile();
+    
+    // The open project's own autosave is not left over from a crash
+    if (m_journal && path == m_projectPath) return false;
+    return model::ProjectJournal::hasRecoveryData(path.toStdString());
+}
+
 bool ProjectController::saveProject() {
     if (m_projectPath.isEmpty()) {
         emit errorOccurred(tr("No save path specified"));
@@ -92,26 +160,41 @@ bool ProjectController::saveProject() {
 
 bool ProjectController::saveProjectAs(const QUrl& url) {
     QString path = url.toLocalFile();
+    if (!m_project) return false;
     
-    // TODO: Implement JSON serialization
-    // auto result = model::ProjectIO::save(*m_project, path.toStdString());
-    // if (!result) {
-    //     emit errorOccurred(tr("Failed to save project: %1").arg(QString::fromStdString(result.error().message)));
-    //     return false;
-    // }
+    auto result = model::ProjectIO::save(*m_project, path.toStdString());
+    if (!result) {
+        emit errorOccurred(tr("Failed to save project: %1")
+            .arg(QString::fromStdString(result.error().message())));
+        return false;
+    }
     
-    m_projectPath = path;
+    // The saved file is now the recovery base; a save under a new
+    // name also drops the old path's recovery data (stopJournal)
+    if (m_journal && path == m_projectPath) {
+        m_journal->reset();
+    } else {
+        m_projectPath = path;
+        startJournal();
+    }
+    m_recovered = false;
     m_undoStack->setClean();
     
     emit projectChanged();
+    emit modifiedChanged();
     emit statusMessage(tr("Project saved: %1").arg(path));
     
     return true;
 }
 
 void ProjectController::closeProject() {
+    stopJournal();
+    m_mediaStatus->detach();
+    cancelMediaHint(m_hintMediaId);
+    m_mediaService->clear();
     m_project.reset();
     m_projectPath.clear();
+    m_recovered = false;
     m_undoStack->clear();
     m_mediaItems.clear();
     
@@ -123,43 +206,85 @@ void ProjectController::closeProject() {
 // Media Import
 // ============================================================================
 
-void ProjectController::importMedia(const QUrl& url) {
-    if (!m_project) {
-        emit errorOccurred(tr("No project open"));
-        return;
-    }
-    
+std::shared_ptr<model::MediaItem> ProjectController::probeForImport(const QUrl& url) {
     QString path = url.toLocalFile();
     QFileInfo fileInfo(path);
     
     if (!fileInfo.exists()) {
         emit errorOccurred(tr("File not found: %1").arg(path));
-        return;
+        return nullptr;
+    }
+    
+    // Duplicate check: same path, or same content under another path
+    std::filesystem::path fsPath(path.toStdString());
+    auto& bin = m_project->mediaBin();
+    uint64_t hash = model::MediaItem::computeContentHash(fsPath);
+    auto existing = bin.findByPath(fsPath);
+    if (!existing) existing = bin.findByContentHash(hash);
+    if (existing) {
+        emit statusMessage(tr("Already imported: %1")
+            .arg(QString::fromStdString(existing->name())));
+        return nullptr;
     }
     
     // Probe media info using static method
-    auto result = media::MediaInfo::probe(std::filesystem::path(path.toStdString()));
+    auto result = media::MediaInfo::probe(fsPath);
     if (!result) {
         emit errorOccurred(tr("Failed to read media file: %1").arg(path));
-        return;
+        return nullptr;
     }
     
     // MediaInfo::probe returns a fully populated MediaItem
     auto item = result.value();
     item->setName(fileInfo.fileName().toStdString());
+    item->setContentHash(hash);
+    return item;
+}
+
+void ProjectController::importMedia(const QUrl& url) {
+    if (!m_project) {
+        emit errorOccurred(tr("No project open"));
+        return;
+    }
+    
+    auto item = probeForImport(url);
+    if (!item) return;
     
     // Add to project
     m_project->mediaBin().addItem(item);
     
     updateMediaItems();
     
-    emit statusMessage(tr("Imported: %1").arg(fileInfo.fileName()));
+    emit statusMessage(tr("Imported: %1").arg(QString::fromStdString(item->name())));
 }
 
 void ProjectController::importMediaFiles(const QList<QUrl>& urls) {
+    if (!m_project) {
+        emit errorOccurred(tr("No project open"));
+        return;
+    }
+    
+    // Probe everything first, then insert in one batch
+    std::vector<std::shared_ptr<model::MediaItem>> items;
+    std::unordered_set<uint64_t> batchHashes;
+    items.reserve(urls.size());
     for (const auto& url : urls) {
-        importMedia(url);
+        auto item = probeForImport(url);
+        if (!item) continue;
+        
+        // The same file may be listed twice in one import
+        if (item->contentHash() != 0 && !batchHashes.insert(item->contentHash()).second) {
+            continue;
+        }
+        items.push_back(std::move(item));
     }
+    
+    size_t added = m_project->mediaBin().addItems(items);
+    if (added == 0) return;
+    
+    updateMediaItems();
+    
+    emit statusMessage(tr("Imported %n file(s)", nullptr, static_cast<int>(added)));
 }
 
 void ProjectController::removeMediaItem(const QString& id) {
@@ -171,6 +296,42 @@ void ProjectController::removeMediaItem(const QString& id) {
     updateMediaItems();
 }
 
+// ============================================================================
+// Prefetch Hints
+// ============================================================================
+
+void ProjectController::hintMedia(const QString& mediaId, qint64 mediaTime) {
+    if (mediaId.isEmpty()) return;
+    if (mediaId == m_hintMediaId && mediaTime == m_hintTime) return;
+    
+    // Sweeping the pointer over a list starts nothing
+    m_hintClient->cancelHint();
+    m_hintMediaId = mediaId;
+    m_hintTime = mediaTime;
+    m_hintTimer.start();
+}
+
+void ProjectController::cancelMediaHint(const QString& mediaId) {
+    if (mediaId.isEmpty() || mediaId != m_hintMediaId) return;
+    
+    m_hintTimer.stop();
+    m_hintClient->cancelHint();
+    m_hintMediaId.clear();
+}
+
+void ProjectController::startHint() {
+    if (!m_project || m_hintMediaId.isEmpty()) return;
+    
+    UUID id = UUID::fromString(m_hintMediaId.toStdString());
+    auto item = m_project->mediaBin().getItem(id);
+    if (!item || !item->hasVideo() || !item->isOnline()) return;
+    
+    // The poster frame and the second after it
+    double fps = item->videoProperties().frameRate.toDouble();
+    size_t count = std::clamp<size_t>(static_cast<size_t>(std::ceil(fps)) + 1, 1, kMaxHintFrames);
+    m_hintClient->hint(id, m_hintTime, count);
+}
+
 // ============================================================================
 // Undo/Redo
 // ============================================================================
@@ -197,7 +358,7 @@ QString ProjectController::projectPath() const {
 }
 
 bool ProjectController::isModified() const {
-    return m_undoStack && !m_undoStack->isClean();
+    return m_recovered || (m_undoStack && !m_undoStack->isClean());
 }
 
 bool ProjectController::hasProject() const {
@@ -226,6 +387,22 @@ QString ProjectController::redoText() const {
     return QString::fromStdString(m_undoStack->redoText());
 }
 
+qint64 ProjectController::undoMemoryUsage() const {
+    if (!m_undoStack) return 0;
+    return static_cast<qint64>(m_undoStack->memoryUsage());
+}
+
+qint64 ProjectController::undoMemoryLimit() const {
+    if (!m_undoStack) return 0;
+    return static_cast<qint64>(m_undoStack->memoryLimit());
+}
+
+void ProjectController::setUndoMemoryLimit(qint64 bytes) {
+    if (!m_undoStack || bytes <= 0) return;
+    m_undoStack->setMemoryLimit(static_cast<size_t>(bytes));
+    emit undoStateChanged();
+}
+
 int ProjectController::frameWidth() const {
     if (!m_project) return 1920;
     auto seq = m_project->activeSequence();
@@ -248,6 +425,106 @@ double ProjectController::frameRate() const {
 // Private Methods
 // ============================================================================
 
+void ProjectController::startJournal() {
+    stopJournal();
+    if (!m_project || m_projectPath.isEmpty() || !m_project->settings().autoSaveEnabled) {
+        return;
+    }
+    
+    m_journal = std::make_unique<model::ProjectJournal>(m_projectPath.toStdString());
+    if (auto result = m_journal->open(); !result) {
+        LOG_WARN("Autosave journal disabled: {}", result.error().message());
+        m_journal.reset();
+        return;
+    }
+    m_journal->attach(*m_project);
+}
+
+void ProjectController::stopJournal() {
+    if (!m_journal) return;
+    
+    // Closing, replacing or renaming the project is deliberate: unsaved
+    // edits are dropped with it. Only a crash leaves recovery data.
+    m_journal->reset();
+    m_journal.reset();  // Detaches and drains pending records
+}
+
+void ProjectController::watchMedia() {
+    if (m_project) {
+        m_mediaStatus->attach(m_project->mediaBin());
+    }
+}
+
+void ProjectController::onMediaStatusChanged(const std::shared_ptr<model::MediaItem>& item) {
+    if (!m_project || !m_project->mediaBin().contains(item->id())) return;
+    
+    if (item->status() == model::MediaStatus::Modified) {
+        reprobeMedia(item);
+        emit statusMessage(tr("Media changed on disk: %1")
+            .arg(QString::fromStdString(item->name())));
+    }
+    
+    // Drop decoders and frames of the old file
+    m_mediaService->invalidate(item->id());
+    
+    emit mediaStatusChanged(QString::fromStdString(item->id().toString()));
+    scheduleMediaItemsUpdate();
+}
+
+void ProjectController::reprobeMedia(const std::shared_ptr<model::MediaItem>& item) {
+    // Probing and hashing read the file, which may sit on a slow
+    // volume: do both on a worker, into a copy of the item
+    auto dispatcher = std::make_shared<QtDispatcher>(this);
+    m_probeClient->submit([this, dispatcher, id = item->id(), path = item->path()]() {
+        auto probed = std::make_shared<model::MediaItem>(id, path);
+        if (!media::MediaInfo::probe(*probed)) return;
+        uint64_t hash = model::MediaItem::computeContentHash(path);
+        
+        dispatcher->post([this, probed, hash]() {
+            applyReprobe(*probed, hash);
+        });
+    });
+}
+
+void ProjectController::applyReprobe(const model::MediaItem& probed, uint64_t contentHash) {
+    if (!m_project) return;
+    
+    // Removed or relinked meanwhile: the result describes another file
+    auto item = m_project->mediaBin().getItem(probed.id());
+    if (!item || item->path() != probed.path()) return;
+    
+    item->setType(probed.type());
+    item->setDuration(probed.duration());
+    item->setFileSize(probed.fileSize());
+    item->setHasVideo(probed.hasVideo());
+    item->setHasAudio(probed.hasAudio());
+    item->videoProperties() = probed.videoProperties();
+    item->audioProperties() = probed.audioProperties();
+    item->setProbed(true);
+    
+    // The changed file is the new reference
+    m_project->mediaBin().setContentHash(item->id(), contentHash);
+    m_mediaStatus->watch(item);
+    
+    // Frames decoded before the new properties (frame rate) arrived
+    m_mediaService->invalidate(item->id());
+    
+    emit mediaStatusChanged(QString::fromStdString(item->id().toString()));
+    scheduleMediaItemsUpdate();
+}
+
+void ProjectController::scheduleMediaItemsUpdate() {
+    // Status changes arrive in bursts (initial scan, a volume going
+    // away); rebuild the list once per burst
+    if (m_mediaItemsUpdatePending) return;
+    m_mediaItemsUpdatePending = true;
+    
+    QMetaObject::invokeMethod(this, [this]() {
+        m_mediaItemsUpdatePending = false;
+        updateMediaItems();
+    }, Qt::QueuedConnection);
+}
+
 void ProjectController::updateMediaItems() {
     m_mediaItems.clear();
     
@@ -256,7 +533,8 @@ void ProjectController::updateMediaItems() {
         return;
     }
     
-    for (const auto& item : m_project->mediaBin().items()) {
+    m_mediaItems.reserve(static_cast<qsizetype>(m_project->mediaBin().size()));
+    m_project->mediaBin().forEach([this](const std::shared_ptr<model::MediaItem>& item) {
         QVariantMap map;
         map["id"] = QString::fromStdString(item->id().toString());
         map["name"] = QString::fromStdString(item->name());
@@ -266,9 +544,10 @@ void ProjectController::updateMediaItems() {
         map["height"] = item->videoProperties().resolution.height;
         map["hasVideo"] = item->hasVideo();
         map["hasAudio"] = item->hasAudio();
+        map["online"] = item->status() != model::MediaStatus::Offline;  // Unknown until checked
         
         m_mediaItems.append(map);
-    }
+    });
     
     emit mediaItemsChanged();
 }
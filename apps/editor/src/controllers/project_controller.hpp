@@ -13,11 +13,20 @@
 #include <QUrl>
 #include <QStringList>
 #include <QVariantList>
+#include <QTimer>
 #include <memory>
 
 namespace phoenix::model {
     class Project;
+    class MediaItem;
     class UndoStack;
+    class ProjectJournal;
+    class MediaStatusService;
+}
+
+namespace phoenix::engine {
+    class MediaService;
+    class MediaClient;
 }
 
 namespace phoenix::editor {
@@ -52,6 +61,7 @@ public:
  * - Import media files
  * - Undo/Redo
  * - Project settings
+ * - Prefetch hints for media the user is about to play
  */
 class ProjectController : public QObject {
     Q_OBJECT
@@ -70,6 +80,8 @@ class ProjectController : public QObject {
     Q_PROPERTY(bool canRedo READ canRedo NOTIFY undoStateChanged)
     Q_PROPERTY(QString undoText READ undoText NOTIFY undoStateChanged)
     Q_PROPERTY(QString redoText READ redoText NOTIFY undoStateChanged)
+    Q_PROPERTY(qint64 undoMemoryUsage READ undoMemoryUsage NOTIFY undoStateChanged)
+    Q_PROPERTY(qint64 undoMemoryLimit READ undoMemoryLimit WRITE setUndoMemoryLimit NOTIFY undoStateChanged)
     
     // Settings
     Q_PROPERTY(int frameWidth READ frameWidth NOTIFY settingsChanged)
@@ -83,7 +95,18 @@ public:
     // ========== Project Operations ==========
     
     Q_INVOKABLE void newProject();
-    Q_INVOKABLE bool openProject(const QUrl& url);
+    
+    /**
+     * @brief Open a project file
+     * 
+     * @param recover Rebuild unsaved changes left by a crash; otherwise
+     *        they are discarded. Ask the user first (hasRecoveryData).
+     */
+    Q_INVOKABLE bool openProject(const QUrl& url, bool recover = false);
+    
+    /// Whether a crash left unsaved changes of this project behind
+    Q_INVOKABLE bool hasRecoveryData(const QUrl& url) const;
+    
     Q_INVOKABLE bool saveProject();
     Q_INVOKABLE bool saveProjectAs(const QUrl& url);
     Q_INVOKABLE void closeProject();
@@ -94,6 +117,21 @@ public:
     Q_INVOKABLE void importMediaFiles(const QList<QUrl>& urls);
     Q_INVOKABLE void removeMediaItem(const QString& id);
     
+    // ========== Prefetch Hints ==========
+    
+    /**
+     * @brief The user is likely to play this media soon (hover, selection)
+     * 
+     * Once no other hint follows for kHintDelayMs, opens a decoder and
+     * decodes the frame at @p mediaTime and the second after it, in the
+     * background and without evicting frames in use. Replaces the
+     * previous hint.
+     */
+    Q_INVOKABLE void hintMedia(const QString& mediaId, qint64 mediaTime = 0);
+    
+    /// The pointer left @p mediaId: drop its hint if it is the current one
+    Q_INVOKABLE void cancelMediaHint(const QString& mediaId);
+    
     // ========== Undo/Redo ==========
     
     Q_INVOKABLE void undo();
@@ -112,6 +150,9 @@ public:
     bool canRedo() const;
     QString undoText() const;
     QString redoText() const;
+    qint64 undoMemoryUsage() const;
+    qint64 undoMemoryLimit() const;
+    void setUndoMemoryLimit(qint64 bytes);
     
     int frameWidth() const;
     int frameHeight() const;
@@ -121,6 +162,9 @@ public:
     
     model::Project* project() const { return m_project.get(); }
     model::UndoStack* undoStack() const { return m_undoStack.get(); }
+    
+    /// Decoders, frame cache and decode workers shared by all viewers
+    engine::MediaService* mediaService() const { return m_mediaService.get(); }
 
 signals:
     void projectChanged();
@@ -129,17 +173,42 @@ signals:
     void undoStateChanged();
     void settingsChanged();
     
+    /// A media file went offline, came back or changed on disk
+    void mediaStatusChanged(const QString& id);
+    
     void errorOccurred(const QString& message);
     void statusMessage(const QString& message);
 
 private:
     void setupConnections();
     void updateMediaItems();
+    std::shared_ptr<model::MediaItem> probeForImport(const QUrl& url);
+    void startJournal();
+    void stopJournal();
+    void watchMedia();
+    void onMediaStatusChanged(const std::shared_ptr<model::MediaItem>& item);
+    void reprobeMedia(const std::shared_ptr<model::MediaItem>& item);
+    void applyReprobe(const model::MediaItem& probed, uint64_t contentHash);
+    void scheduleMediaItemsUpdate();
+    void startHint();
+    
+    static constexpr int kHintDelayMs = 150;      // Pointer rest before a hint starts
+    static constexpr size_t kMaxHintFrames = 61;  // Poster frame and one second at 60 fps
     
     std::unique_ptr<model::Project> m_project;
     std::unique_ptr<model::UndoStack> m_undoStack;
+    std::unique_ptr<model::ProjectJournal> m_journal;  // Autosave (saved projects only)
+    std::unique_ptr<model::MediaStatusService> m_mediaStatus;
+    std::unique_ptr<engine::MediaService> m_mediaService;  // Outlives the viewers
+    std::shared_ptr<engine::MediaClient> m_hintClient;     // Background priority
+    std::shared_ptr<engine::MediaClient> m_probeClient;    // Re-probes files changed on disk
+    QTimer m_hintTimer;
+    QString m_hintMediaId;
+    qint64 m_hintTime = 0;
     QString m_projectPath;
+    bool m_recovered = false;  // Recovered changes not saved yet
     QVariantList m_mediaItems;
+    bool m_mediaItemsUpdatePending = false;
 };
 
 } // namespace phoenix::editor
@@ -5,6 +5,7 @@
 
 #include "timeline_controller.hpp"
 #include "project_controller.hpp"
+#include "../timeline_clip_model.hpp"
 
 #include <phoenix/model/project.hpp>
 #include <phoenix/model/sequence.hpp>
@@ -14,8 +15,13 @@
 #include <phoenix/model/media_bin.hpp>
 #include <phoenix/model/commands/undo_stack.hpp>
 #include <phoenix/model/commands/clip_commands.hpp>
+#include <phoenix/model/commands/batch_commands.hpp>
+
+#include <QQmlEngine>
 
 #include <algorithm>
+#include <cstdlib>
+#include <optional>
 
 namespace phoenix::editor {
 
@@ -26,8 +32,13 @@ TimelineController::TimelineController(ProjectController* projectController,
 {
     // Connect to project changes
     connect(m_projectController, &ProjectController::projectChanged,
-            this, &TimelineController::updateTracks);
+            this, [this]() {
+                connectSequence();
+                updateTracks();
+                emit selectedClipChanged();
+            });
     
+    connectSequence();
     updateTracks();
 }
 
@@ -63,8 +74,6 @@ void TimelineController::addClip(const QString& mediaItemId,
     UUID trackUuid = UUID::fromString(trackId.toStdString());
     auto cmd = std::make_unique<model::AddClipCommand>(*seq, trackUuid, clip);
     undoStack()->push(std::move(cmd));
-    
-    updateTracks();
     emit clipAdded(QString::fromStdString(clip->id().toString()));
 }
 
@@ -73,6 +82,39 @@ void TimelineController::addClipAtPlayhead(const QString& mediaItemId,
     addClip(mediaItemId, trackId, playheadPosition());
 }
 
+bool TimelineController::addSequenceClip(const QString& sequenceId,
+                                         const QString& trackId,
+                                         qint64 position) {
+    auto* seq = sequence();
+    if (!seq) return false;
+    
+    auto* project = m_projectController->project();
+    if (!project) return false;
+    
+    // A sequence must not end up containing itself
+    UUID childUuid = UUID::fromString(sequenceId.toStdString());
+    if (!project->canNest(seq->id(), childUuid)) return false;
+    
+    auto child = project->getSequence(childUuid);
+    Duration duration = child->duration();
+    if (duration <= 0) return false;
+    
+    // Create nested clip
+    auto clip = std::make_shared<model::Clip>();
+    clip->setSequenceId(childUuid);
+    clip->setTimelineIn(position);
+    clip->setTimelineOut(position + duration);
+    clip->setSourceIn(0);
+    clip->setSourceOut(duration);
+    clip->setName(child->name());
+    
+    UUID trackUuid = UUID::fromString(trackId.toStdString());
+    auto cmd = std::make_unique<model::AddClipCommand>(*seq, trackUuid, clip);
+    undoStack()->push(std::move(cmd));
+    emit clipAdded(QString::fromStdString(clip->id().toString()));
+    return true;
+}
+
 void TimelineController::moveClip(const QString& clipId,
                                   const QString& targetTrackId,
                                   qint64 newPosition) {
@@ -89,8 +131,6 @@ void TimelineController::moveClip(const QString& clipId,
     auto cmd = std::make_unique<model::MoveClipCommand>(
         *seq, sourceUuid, clipUuid, targetUuid, newPosition);
     undoStack()->push(std::move(cmd));
-    
-    updateTracks();
     emit clipMoved(clipId);
 }
 
@@ -108,8 +148,6 @@ void TimelineController::trimClipStart(const QString& clipId, qint64 newIn) {
         *seq, trackUuid, clipUuid, 
         model::TrimClipCommand::Edge::Start, newIn);
     undoStack()->push(std::move(cmd));
-    
-    updateTracks();
 }
 
 void TimelineController::trimClipEnd(const QString& clipId, qint64 newOut) {
@@ -126,8 +164,6 @@ void TimelineController::trimClipEnd(const QString& clipId, qint64 newOut) {
         *seq, trackUuid, clipUuid,
         model::TrimClipCommand::Edge::End, newOut);
     undoStack()->push(std::move(cmd));
-    
-    updateTracks();
 }
 
 void TimelineController::splitClipAtPlayhead(const QString& clipId) {
@@ -143,8 +179,6 @@ void TimelineController::splitClipAtPlayhead(const QString& clipId) {
     auto cmd = std::make_unique<model::SplitClipCommand>(
         *seq, trackUuid, clipUuid, playheadPosition());
     undoStack()->push(std::move(cmd));
-    
-    updateTracks();
 }
 
 void TimelineController::deleteSelectedClip() {
@@ -167,14 +201,52 @@ void TimelineController::deleteClip(const QString& clipId) {
     undoStack()->push(std::move(cmd));
     
     if (m_selectedClipId == clipId) {
-        m_selectedClipId.clear();
-        emit selectionChanged();
+        selectClip(QString());
     }
     
-    updateTracks();
     emit clipRemoved(clipId);
 }
 
+// ============================================================================
+// Batch Operations
+// ============================================================================
+
+namespace {
+
+std::vector<UUID> toUuids(const QStringList& ids) {
+    std::vector<UUID> result;
+    result.reserve(ids.size());
+    for (const auto& id : ids) {
+        result.push_back(UUID::fromString(id.toStdString()));
+    }
+    return result;
+}
+
+} // namespace
+
+void TimelineController::moveClips(const QStringList& clipIds, qint64 offset) {
+    auto* seq = sequence();
+    if (!seq || clipIds.isEmpty()) return;
+    
+    undoStack()->push(std::make_unique<model::MoveClipsCommand>(
+        *seq, toUuids(clipIds), offset));
+}
+
+void TimelineController::slipClips(const QStringList& clipIds, qint64 offset) {
+    auto* seq = sequence();
+    if (!seq || clipIds.isEmpty()) return;
+    
+    undoStack()->push(std::make_unique<model::SlipClipsCommand>(
+        *seq, toUuids(clipIds), offset));
+}
+
+void TimelineController::ripple(qint64 from, qint64 offset) {
+    auto* seq = sequence();
+    if (!seq) return;
+    
+    undoStack()->push(std::make_unique<model::RippleCommand>(*seq, from, offset));
+}
+
 // ============================================================================
 // Track Operations
 // ============================================================================
@@ -211,6 +283,11 @@ void TimelineController::setTrackMuted(const QString& trackId, bool muted) {
     UUID uuid = UUID::fromString(trackId.toStdString());
     if (auto track = seq->getTrack(uuid)) {
         track->setMuted(muted);
+        
+        auto change = model::SequenceChange::wholeTimeline();
+        change.addTrack(uuid);
+        seq->commitChange(std::move(change));
+        
         updateTracks();
     }
 }
@@ -222,6 +299,11 @@ void TimelineController::setTrackHidden(const QString& trackId, bool hidden) {
     UUID uuid = UUID::fromString(trackId.toStdString());
     if (auto track = seq->getTrack(uuid)) {
         track->setHidden(hidden);
+        
+        auto change = model::SequenceChange::wholeTimeline();
+        change.addTrack(uuid);
+        seq->commitChange(std::move(change));
+        
         updateTracks();
     }
 }
@@ -233,10 +315,36 @@ void TimelineController::setTrackLocked(const QString& trackId, bool locked) {
     UUID uuid = UUID::fromString(trackId.toStdString());
     if (auto track = seq->getTrack(uuid)) {
         track->setLocked(locked);
+        
+        // Nothing renders differently: name the track, dirty no range
+        model::SequenceChange change;
+        change.addTrack(uuid);
+        seq->commitChange(std::move(change));
+        
         updateTracks();
     }
 }
 
+QObject* TimelineController::clipModel(const QString& trackId) {
+    if (auto* model = m_clipModels.value(trackId)) return model;
+    
+    auto* seq = sequence();
+    if (!seq) return nullptr;
+    
+    auto track = seq->getTrack(UUID::fromString(trackId.toStdString()));
+    if (!track) return nullptr;
+    
+    auto* model = new TimelineClipModel(trackId, this);
+    model->setPixelsPerSecond(m_pixelsPerSecond);
+    model->setSelectedClipId(m_selectedClipId);
+    model->sync(*track);
+    
+    // Returned to QML, which must not garbage-collect it
+    QQmlEngine::setObjectOwnership(model, QQmlEngine::CppOwnership);
+    m_clipModels.insert(trackId, model);
+    return model;
+}
+
 // ============================================================================
 // Selection
 // ============================================================================
@@ -244,7 +352,20 @@ void TimelineController::setTrackLocked(const QString& trackId, bool locked) {
 void TimelineController::selectClip(const QString& clipId) {
     if (m_selectedClipId != clipId) {
         m_selectedClipId = clipId;
+        for (auto* model : std::as_const(m_clipModels)) {
+            model->setSelectedClipId(clipId);
+        }
         emit selectionChanged();
+        emit selectedClipChanged();
+        
+        // The selected clip is the likeliest to be played next
+        auto* seq = sequence();
+        auto clip = seq && !clipId.isEmpty()
+            ? seq->getClip(UUID::fromString(clipId.toStdString())) : nullptr;
+        if (clip && !clip->mediaItemId().isNull()) {
+            m_projectController->hintMedia(
+                QString::fromStdString(clip->mediaItemId().toString()), clip->sourceIn());
+        }
     }
 }
 
@@ -256,9 +377,12 @@ void TimelineController::selectTrack(const QString& trackId) {
 }
 
 void TimelineController::clearSelection() {
-    m_selectedClipId.clear();
     m_selectedTrackId.clear();
-    emit selectionChanged();
+    if (!m_selectedClipId.isEmpty()) {
+        selectClip(QString());
+    } else {
+        emit selectionChanged();
+    }
 }
 
 // ============================================================================
@@ -277,44 +401,68 @@ void TimelineController::goToNextClip() {
     auto* seq = sequence();
     if (!seq) return;
     
-    qint64 currentPos = playheadPosition();
-    qint64 nextPos = duration();
-    
-    // Find next clip boundary
-    for (const auto& track : seq->videoTracks()) {
-        for (const auto& clip : track->clips()) {
-            if (clip->timelineIn() > currentPos) {
-                nextPos = std::min(nextPos, static_cast<qint64>(clip->timelineIn()));
-            }
-            if (clip->timelineOut() > currentPos) {
-                nextPos = std::min(nextPos, static_cast<qint64>(clip->timelineOut()));
-            }
-        }
-    }
-    
-    setPlayheadPosition(nextPos);
+    auto point = seq->editPoints().next(playheadPosition(),
+        [](const model::EditPoint& p) { return p.kind != model::EditPointKind::Playhead; });
+    setPlayheadPosition(point ? point->time : duration());
 }
 
 void TimelineController::goToPrevClip() {
     auto* seq = sequence();
     if (!seq) return;
     
-    qint64 currentPos = playheadPosition();
-    qint64 prevPos = 0;
+    auto point = seq->editPoints().previous(playheadPosition(),
+        [](const model::EditPoint& p) { return p.kind != model::EditPointKind::Playhead; });
+    setPlayheadPosition(point ? point->time : 0);
+}
+
+// ============================================================================
+// Snapping
+// ============================================================================
+
+qint64 TimelineController::snapTime(qint64 time, const QString& ignoreClipId) const {
+    auto* seq = sequence();
+    if (!seq || !m_snapEnabled) return time;
     
-    // Find previous clip boundary
-    for (const auto& track : seq->videoTracks()) {
-        for (const auto& clip : track->clips()) {
-            if (clip->timelineIn() < currentPos) {
-                prevPos = std::max(prevPos, static_cast<qint64>(clip->timelineIn()));
-            }
-            if (clip->timelineOut() < currentPos) {
-                prevPos = std::max(prevPos, static_cast<qint64>(clip->timelineOut()));
-            }
+    UUID ignored = ignoreClipId.isEmpty() ? UUID() : UUID::fromString(ignoreClipId.toStdString());
+    auto point = seq->editPoints().nearest(time, snapTolerance(),
+        [&ignored](const model::EditPoint& p) { return !p.isClipEdge() || p.clipId != ignored; });
+    return point ? point->time : time;
+}
+
+qint64 TimelineController::snapClipPosition(const QString& clipId, qint64 position) const {
+    auto* seq = sequence();
+    if (!seq || !m_snapEnabled) return position;
+    
+    UUID clipUuid = UUID::fromString(clipId.toStdString());
+    auto clip = seq->getClip(clipUuid);
+    if (!clip) return position;
+    
+    // Skip the clip's own edges; they move with it
+    auto accept = [&clipUuid](const model::EditPoint& p) {
+        return !p.isClipEdge() || p.clipId != clipUuid;
+    };
+    
+    const auto& index = seq->editPoints();
+    Duration tolerance = snapTolerance();
+    auto startSnap = index.nearest(position, tolerance, accept);
+    auto endSnap = index.nearest(position + clip->duration(), tolerance, accept);
+    
+    // Prefer whichever edge needs the smaller correction
+    std::optional<qint64> best;
+    if (startSnap) {
+        best = startSnap->time;
+    }
+    if (endSnap) {
+        qint64 candidate = endSnap->time - clip->duration();
+        if (!best || std::abs(candidate - position) < std::abs(*best - position)) {
+            best = candidate;
         }
     }
-    
-    setPlayheadPosition(prevPos);
+    return std::max<qint64>(0, best.value_or(position));
+}
+
+qint64 TimelineController::snapTolerance() const {
+    return pixelsToTime(kSnapTolerancePixels);
 }
 
 // ============================================================================
@@ -402,6 +550,9 @@ void TimelineController::setPixelsPerSecond(double pps) {
     pps = std::clamp(pps, 10.0, 1000.0);
     if (m_pixelsPerSecond != pps) {
         m_pixelsPerSecond = pps;
+        for (auto* model : std::as_const(m_clipModels)) {
+            model->setPixelsPerSecond(pps);
+        }
         emit zoomChanged();
     }
 }
@@ -432,6 +583,25 @@ QString TimelineController::selectedTrackId() const {
     return m_selectedTrackId;
 }
 
+QVariantMap TimelineController::selectedClip() const {
+    auto* seq = sequence();
+    if (!seq || m_selectedClipId.isEmpty()) return QVariantMap();
+    
+    auto clip = seq->getClip(UUID::fromString(m_selectedClipId.toStdString()));
+    if (!clip) return QVariantMap();
+    
+    QVariantMap clipMap;
+    clipMap["id"] = m_selectedClipId;
+    clipMap["name"] = QString::fromStdString(clip->name());
+    clipMap["timelineIn"] = static_cast<qint64>(clip->timelineIn());
+    clipMap["timelineOut"] = static_cast<qint64>(clip->timelineOut());
+    clipMap["duration"] = static_cast<qint64>(clip->duration());
+    clipMap["sourceIn"] = static_cast<qint64>(clip->sourceIn());
+    clipMap["sourceOut"] = static_cast<qint64>(clip->sourceOut());
+    clipMap["trackId"] = findTrackForClip(m_selectedClipId);
+    return clipMap;
+}
+
 bool TimelineController::snapEnabled() const {
     return m_snapEnabled;
 }
@@ -484,13 +654,24 @@ void TimelineController::updateTracks() {
     m_audioTracks.clear();
     
     auto* seq = sequence();
+    
+    // Models of tracks that are gone (or of the previous project)
+    for (auto it = m_clipModels.begin(); it != m_clipModels.end();) {
+        if (!seq || !seq->getTrack(UUID::fromString(it.key().toStdString()))) {
+            it.value()->deleteLater();
+            it = m_clipModels.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
     if (!seq) {
         emit tracksChanged();
         emit durationChanged();
         return;
     }
     
-    // Build video tracks
+    // Track state only; clips are served by the clip models
     for (const auto& track : seq->videoTracks()) {
         QVariantMap trackMap;
         trackMap["id"] = QString::fromStdString(track->id().toString());
@@ -500,28 +681,9 @@ void TimelineController::updateTracks() {
         trackMap["hidden"] = track->hidden();
         trackMap["locked"] = track->locked();
         trackMap["type"] = "video";
-        
-        // Build clips
-        QVariantList clips;
-        for (const auto& clip : track->clips()) {
-            QVariantMap clipMap;
-            clipMap["id"] = QString::fromStdString(clip->id().toString());
-            clipMap["name"] = QString::fromStdString(clip->name());
-            clipMap["timelineIn"] = static_cast<qint64>(clip->timelineIn());
-            clipMap["timelineOut"] = static_cast<qint64>(clip->timelineOut());
-            clipMap["duration"] = static_cast<qint64>(clip->duration());
-            clipMap["sourceIn"] = static_cast<qint64>(clip->sourceIn());
-            clipMap["sourceOut"] = static_cast<qint64>(clip->sourceOut());
-            clipMap["selected"] = (m_selectedClipId == 
-                QString::fromStdString(clip->id().toString()));
-            clips.append(clipMap);
-        }
-        trackMap["clips"] = clips;
-        
         m_videoTracks.append(trackMap);
     }
     
-    // Build audio tracks (similar)
     for (const auto& track : seq->audioTracks()) {
         QVariantMap trackMap;
         trackMap["id"] = QString::fromStdString(track->id().toString());
@@ -530,21 +692,6 @@ void TimelineController::updateTracks() {
         trackMap["muted"] = track->muted();
         trackMap["locked"] = track->locked();
         trackMap["type"] = "audio";
-        
-        QVariantList clips;
-        for (const auto& clip : track->clips()) {
-            QVariantMap clipMap;
-            clipMap["id"] = QString::fromStdString(clip->id().toString());
-            clipMap["name"] = QString::fromStdString(clip->name());
-            clipMap["timelineIn"] = static_cast<qint64>(clip->timelineIn());
-            clipMap["timelineOut"] = static_cast<qint64>(clip->timelineOut());
-            clipMap["duration"] = static_cast<qint64>(clip->duration());
-            clipMap["selected"] = (m_selectedClipId == 
-                QString::fromStdString(clip->id().toString()));
-            clips.append(clipMap);
-        }
-        trackMap["clips"] = clips;
-        
         m_audioTracks.append(trackMap);
     }
     
@@ -552,4 +699,46 @@ void TimelineController::updateTracks() {
     emit durationChanged();
 }
 
+void TimelineController::connectSequence() {
+    auto* seq = sequence();
+    if (!seq) {
+        m_sequenceConnection = ScopedConnection();
+        return;
+    }
+    
+    // Commands (and their undo) announce what they touched
+    m_sequenceConnection = seq->changed.connectScoped(
+        [this](const model::SequenceChange& change) {
+            onSequenceChanged(change);
+        });
+}
+
+void TimelineController::onSequenceChanged(const model::SequenceChange& change) {
+    syncClipModels(&change);
+    emit durationChanged();
+    
+    if (!m_selectedClipId.isEmpty()) {
+        UUID selected = UUID::fromString(m_selectedClipId.toStdString());
+        if (std::find(change.clipIds.begin(), change.clipIds.end(), selected) !=
+            change.clipIds.end()) {
+            emit selectedClipChanged();
+        }
+    }
+}
+
+void TimelineController::syncClipModels(const model::SequenceChange* change) {
+    auto* seq = sequence();
+    if (!seq || m_clipModels.isEmpty()) return;
+    
+    auto syncTrack = [&](const auto& track) {
+        if (change && !change->affectsTrack(track->id())) return;
+        
+        auto* model = m_clipModels.value(QString::fromStdString(track->id().toString()));
+        if (model) model->sync(*track);
+    };
+    
+    for (const auto& track : seq->videoTracks()) syncTrack(track);
+    for (const auto& track : seq->audioTracks()) syncTrack(track);
+}
+
 } // namespace phoenix::editor
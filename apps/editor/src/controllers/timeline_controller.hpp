@@ -11,16 +11,22 @@
 #include <QObject>
 #include <QString>
 #include <QVariantList>
+#include <QVariantMap>
+#include <QStringList>
 #include <QPointF>
+#include <QHash>
+#include <phoenix/core/signals.hpp>
 
 namespace phoenix::model {
     class Sequence;
     class UndoStack;
+    struct SequenceChange;
 }
 
 namespace phoenix::editor {
 
 class ProjectController;
+class TimelineClipModel;
 
 /**
  * @brief Timeline controller for QML
@@ -30,6 +36,10 @@ class ProjectController;
  * - Track management
  * - Playhead position
  * - Selection
+ * 
+ * Track lists carry track state only; each track's clips are served
+ * by a TimelineClipModel (see clipModel()), kept up to date from the
+ * sequence's change notifications.
  */
 class TimelineController : public QObject {
     Q_OBJECT
@@ -50,6 +60,7 @@ class TimelineController : public QObject {
     // Selection
     Q_PROPERTY(QString selectedClipId READ selectedClipId NOTIFY selectionChanged)
     Q_PROPERTY(QString selectedTrackId READ selectedTrackId NOTIFY selectionChanged)
+    Q_PROPERTY(QVariantMap selectedClip READ selectedClip NOTIFY selectedClipChanged)
     
     // Snap
     Q_PROPERTY(bool snapEnabled READ snapEnabled WRITE setSnapEnabled NOTIFY snapChanged)
@@ -70,6 +81,11 @@ public:
     Q_INVOKABLE void addClipAtPlayhead(const QString& mediaItemId,
                                        const QString& trackId);
     
+    /// Nest another sequence as a clip (refused if it would form a cycle)
+    Q_INVOKABLE bool addSequenceClip(const QString& sequenceId,
+                                     const QString& trackId,
+                                     qint64 position);
+    
     /// Move clip to new position
     Q_INVOKABLE void moveClip(const QString& clipId,
                               const QString& targetTrackId,
@@ -90,6 +106,17 @@ public:
     /// Delete clip by ID
     Q_INVOKABLE void deleteClip(const QString& clipId);
     
+    // ========== Batch Operations ==========
+    
+    /// Move several clips by the same offset (one undo step)
+    Q_INVOKABLE void moveClips(const QStringList& clipIds, qint64 offset);
+    
+    /// Slip the source range of several clips (one undo step)
+    Q_INVOKABLE void slipClips(const QStringList& clipIds, qint64 offset);
+    
+    /// Shift everything at or after a position on all unlocked tracks
+    Q_INVOKABLE void ripple(qint64 from, qint64 offset);
+    
     // ========== Track Operations ==========
     
     Q_INVOKABLE void addVideoTrack();
@@ -99,6 +126,15 @@ public:
     Q_INVOKABLE void setTrackHidden(const QString& trackId, bool hidden);
     Q_INVOKABLE void setTrackLocked(const QString& trackId, bool locked);
     
+    /**
+     * @brief Viewport-culled clip model of a track
+     * 
+     * Created on first use and owned by the controller.
+     * 
+     * @return Model, or nullptr if there is no such track
+     */
+    Q_INVOKABLE QObject* clipModel(const QString& trackId);
+    
     // ========== Selection ==========
     
     Q_INVOKABLE void selectClip(const QString& clipId);
@@ -109,8 +145,17 @@ public:
     
     Q_INVOKABLE void goToStart();
     Q_INVOKABLE void goToEnd();
-    Q_INVOKABLE void goToNextClip();
-    Q_INVOKABLE void goToPrevClip();
+    Q_INVOKABLE void goToNextClip();   // Next edit point on any track
+    Q_INVOKABLE void goToPrevClip();   // Previous edit point on any track
+    
+    // ========== Snapping ==========
+    
+    /// Snap a time to the nearest edit point within a few pixels
+    /// (returned unchanged if snapping is off or nothing is near)
+    Q_INVOKABLE qint64 snapTime(qint64 time, const QString& ignoreClipId = QString()) const;
+    
+    /// Snap a clip's new start so that either of its edges lands on an edit point
+    Q_INVOKABLE qint64 snapClipPosition(const QString& clipId, qint64 position) const;
     
     // ========== Zoom ==========
     
@@ -146,6 +191,9 @@ public:
     QString selectedClipId() const;
     QString selectedTrackId() const;
     
+    /// Name, timing and track of the selected clip (empty if none)
+    QVariantMap selectedClip() const;
+    
     bool snapEnabled() const;
     void setSnapEnabled(bool enabled);
 
@@ -155,6 +203,7 @@ signals:
     void zoomChanged();
     void tracksChanged();
     void selectionChanged();
+    void selectedClipChanged();
     void snapChanged();
     
     void clipAdded(const QString& clipId);
@@ -166,6 +215,12 @@ private:
     model::UndoStack* undoStack() const;
     QString findTrackForClip(const QString& clipId) const;
     void updateTracks();
+    void connectSequence();
+    void onSequenceChanged(const model::SequenceChange& change);
+    void syncClipModels(const model::SequenceChange* change);
+    qint64 snapTolerance() const;
+    
+    static constexpr double kSnapTolerancePixels = 8.0;
     
     ProjectController* m_projectController;
     
@@ -176,6 +231,9 @@ private:
     
     QVariantList m_videoTracks;
     QVariantList m_audioTracks;
+    
+    QHash<QString, TimelineClipModel*> m_clipModels;  // By track ID; children
+    ScopedConnection m_sequenceConnection;
 };
 
 } // namespace phoenix::editor
@@ -57,9 +57,6 @@ int main(int argc, char* argv[]) {
     // QML engine
     QQmlApplicationEngine engine;
     
-    // Register image provider
-    engine.addImageProvider("preview", previewController.imageProvider());
-    
     // Expose theme and controllers to QML as context properties
     QQmlContext* context = engine.rootContext();
     context->setContextProperty("Theme", &theme);
@@ -108,5 +105,8 @@ int main(int argc, char* argv[]) {
     
     LOG_INFO("Phoenix Editor started");
     
-    return app.exec();
+    int result = app.exec();
+    
+    phoenix::shutdownLogging();
+    return result;
 }
@@ -0,0 +1,104 @@
+/**
+ * @file preview_item.cpp
+ * @brief Preview item implementation
+ */
+
+#include "preview_item.hpp"
+#include "controllers/preview_controller.hpp"
+
+#include <QQuickWindow>
+#include <QSGImageNode>
+#include <QMutexLocker>
+
+namespace phoenix::editor {
+
+PreviewItem::PreviewItem(QQuickItem* parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+PreviewItem::~PreviewItem() {
+    disconnect(m_frameConnection);
+}
+
+QObject* PreviewItem::controller() const {
+    return m_controller.data();
+}
+
+void PreviewItem::setController(QObject* controller) {
+    if (m_controller == controller) return;
+    
+    disconnect(m_frameConnection);
+    m_controller = controller;
+    
+    if (auto* preview = qobject_cast<PreviewController*>(controller)) {
+        // Direct: runs on the engine thread that produced the frame
+        m_frameConnection = connect(preview, &PreviewController::frameReady,
+                                    this, &PreviewItem::presentFrame,
+                                    Qt::DirectConnection);
+        presentFrame(preview->currentFrame());
+    }
+    
+    emit controllerChanged();
+}
+
+void PreviewItem::presentFrame(const QImage& image) {
+    if (image.isNull()) return;
+    
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pending = image;  // Shares the pixels; replaces an unshown frame
+        m_dirty = true;
+    }
+    
+    // update() belongs to the UI thread
+    QMetaObject::invokeMethod(this, [this]() {
+        if (!m_hasFrame) {
+            m_hasFrame = true;
+            emit hasFrameChanged();
+        }
+        update();
+    }, Qt::QueuedConnection);
+}
+
+QSGNode* PreviewItem::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) {
+    Q_UNUSED(data)
+    
+    // Render thread, with the UI thread blocked
+    auto* node = static_cast<QSGImageNode*>(oldNode);
+    
+    QImage image;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_dirty) {
+            image = std::move(m_pending);
+            m_pending = QImage();
+            m_dirty = false;
+        }
+    }
+    
+    if (!image.isNull()) {
+        if (!node) {
+            node = window()->createImageNode();
+            node->setOwnsTexture(true);
+            node->setFiltering(QSGTexture::Linear);
+        }
+        
+        // Uploaded once; the image (and with it the engine frame) is
+        // released after the upload
+        node->setTexture(window()->createTextureFromImage(image));
+        m_frameSize = image.size();
+    }
+    
+    if (!node) return nullptr;
+    
+    // Letterbox into the item
+    QSizeF fitted = QSizeF(m_frameSize).scaled(size(), Qt::KeepAspectRatio);
+    node->setRect(QRectF((width() - fitted.width()) / 2.0,
+                         (height() - fitted.height()) / 2.0,
+                         fitted.width(), fitted.height()));
+    return node;
+}
+
+} // namespace phoenix::editor
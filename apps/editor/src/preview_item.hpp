@@ -0,0 +1,79 @@
+/**
+ * @file preview_item.hpp
+ * @brief Scene graph item showing the preview frames
+ * 
+ * Frames go straight from the engine thread into a texture: no
+ * image provider, no per-frame QImage copies, and scaling is done
+ * by the GPU when the texture is drawn.
+ */
+
+#pragma once
+
+#include <QQuickItem>
+#include <QQmlEngine>
+#include <QImage>
+#include <QMutex>
+#include <QPointer>
+
+namespace phoenix::editor {
+
+/**
+ * @brief Video item fed by a PreviewController
+ * 
+ * Usage (QML):
+ * @code
+ *   PreviewItem {
+ *       anchors.fill: parent
+ *       controller: PreviewController
+ *   }
+ * @endcode
+ * 
+ * Only the latest frame is kept; frames arriving faster than the
+ * window renders are dropped. The frame is uploaded once, on the
+ * scene graph's render thread, and letterboxed into the item.
+ */
+class PreviewItem : public QQuickItem {
+    Q_OBJECT
+    QML_ELEMENT
+    
+    Q_PROPERTY(QObject* controller READ controller WRITE setController NOTIFY controllerChanged)
+    Q_PROPERTY(bool hasFrame READ hasFrame NOTIFY hasFrameChanged)
+
+public:
+    explicit PreviewItem(QQuickItem* parent = nullptr);
+    ~PreviewItem() override;
+    
+    QObject* controller() const;
+    void setController(QObject* controller);
+    
+    bool hasFrame() const { return m_hasFrame; }
+    
+    /**
+     * @brief Hand over the next frame (any thread)
+     * 
+     * The image should wrap the frame's pixels (see
+     * PreviewController::frameReady); it is not copied.
+     */
+    void presentFrame(const QImage& image);
+
+signals:
+    void controllerChanged();
+    void hasFrameChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
+
+private:
+    QPointer<QObject> m_controller;
+    QMetaObject::Connection m_frameConnection;
+    
+    // Handed from the engine thread to the render thread
+    QMutex m_mutex;
+    QImage m_pending;
+    bool m_dirty = false;
+    
+    QSize m_frameSize;       // Render thread
+    bool m_hasFrame = false; // UI thread
+};
+
+} // namespace phoenix::editor
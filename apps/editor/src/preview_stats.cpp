@@ -0,0 +1,141 @@
+/**
+ * @file preview_stats.cpp
+ * @brief Preview statistics implementation
+ */
+
+#include "preview_stats.hpp"
+
+#include <phoenix/engine/media_service.hpp>
+
+namespace phoenix::editor {
+
+namespace {
+
+double toMilliseconds(Duration micros) {
+    return static_cast<double>(micros) / 1000.0;
+}
+
+} // namespace
+
+PreviewStats::PreviewStats(QObject* parent)
+    : QObject(parent)
+{
+    m_timer.setInterval(kSampleIntervalMs);
+    connect(&m_timer, &QTimer::timeout, this, &PreviewStats::sample);
+}
+
+// ============================================================================
+// Sources
+// ============================================================================
+
+void PreviewStats::setSources(engine::PlaybackEngine* engine,
+                              engine::MediaService* service,
+                              std::weak_ptr<engine::MediaClient> client,
+                              int lookahead) {
+    m_engine = engine;
+    m_service = service;
+    m_client = std::move(client);
+    m_prefetchLookahead = lookahead;
+    resetBaseline();
+}
+
+void PreviewStats::clearSources() {
+    m_engine = nullptr;
+    m_service = nullptr;
+    m_client.reset();
+}
+
+// ============================================================================
+// Properties
+// ============================================================================
+
+void PreviewStats::setEnabled(bool enabled) {
+    if (enabled == m_timer.isActive()) return;
+    
+    if (enabled) {
+        resetBaseline();
+        m_timer.start();
+    } else {
+        m_timer.stop();
+    }
+    emit enabledChanged();
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+void PreviewStats::resetBaseline() {
+    m_sampledAt = std::chrono::steady_clock::now();
+    if (m_engine) {
+        m_lastPlayback = m_engine->playbackStats();
+        m_lastCompose = m_engine->composeLatency().snapshot();
+    }
+    if (m_service) {
+        m_lastCache = m_service->frameCache()->stats();
+        m_lastDecode = m_service->decodeLatency().snapshot();
+    }
+}
+
+void PreviewStats::sample() {
+    if (!m_engine || !m_service) return;
+    
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - m_sampledAt).count();
+    m_sampledAt = now;
+    
+    // Frame rates
+    auto playback = m_engine->playbackStats();
+    if (seconds > 0.0) {
+        m_deliveredFps = static_cast<double>(
+            playback.framesDelivered - m_lastPlayback.framesDelivered) / seconds;
+        m_droppedFps = static_cast<double>(
+            playback.framesDropped - m_lastPlayback.framesDropped) / seconds;
+    }
+    m_lastPlayback = playback;
+    
+    // Latency over the interval
+    auto decode = m_service->decodeLatency().snapshot();
+    auto decodeWindow = decode.since(m_lastDecode);
+    m_lastDecode = decode;
+    if (decodeWindow.count > 0) {
+        m_decodeP50 = toMilliseconds(decodeWindow.percentile(0.50));
+        m_decodeP95 = toMilliseconds(decodeWindow.percentile(0.95));
+        m_decodeP99 = toMilliseconds(decodeWindow.percentile(0.99));
+    }
+    
+    auto compose = m_engine->composeLatency().snapshot();
+    auto composeWindow = compose.since(m_lastCompose);
+    m_lastCompose = compose;
+    if (composeWindow.count > 0) {
+        m_composeP50 = toMilliseconds(composeWindow.percentile(0.50));
+        m_composeP95 = toMilliseconds(composeWindow.percentile(0.95));
+        m_composeP99 = toMilliseconds(composeWindow.percentile(0.99));
+    }
+    
+    m_seekLatency = toMilliseconds(m_engine->seekStats().lastLatency);
+    
+    // Frame cache (shared by every viewer)
+    auto cache = m_service->frameCache()->stats();
+    uint64_t hits = cache.hits - m_lastCache.hits;
+    uint64_t lookups = hits + (cache.misses - m_lastCache.misses);
+    if (lookups > 0) {
+        m_cacheHitRate = static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+    m_cacheMemoryMB = static_cast<double>(cache.memoryUsage) / (1024.0 * 1024.0);
+    m_cacheFrames = static_cast<int>(cache.currentSize);
+    m_lastCache = cache;
+    
+    // Decoding
+    auto decoders = m_service->decoderPool().stats();
+    m_activeDecoders = static_cast<int>(decoders.activeDecoders);
+    m_pooledDecoders = static_cast<int>(decoders.pooledDecoders);
+    m_queuedJobs = static_cast<int>(m_service->stats().queuedJobs);
+    
+    auto client = m_client.lock();
+    m_prefetchHorizon = client ? static_cast<int>(client->prefetchHorizon()) : 0;
+    
+    emit updated();
+}
+
+} // namespace phoenix::editor
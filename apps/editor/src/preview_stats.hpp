@@ -0,0 +1,165 @@
+/**
+ * @file preview_stats.hpp
+ * @brief Preview performance statistics for QML
+ * 
+ * When preview stutters on a user's machine, the overlay built on
+ * this object shows where the time goes: frames delivered and
+ * dropped, decode and compose latency, cache effectiveness and how
+ * far decoding is ahead of playback.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <phoenix/core/latency_histogram.hpp>
+#include <phoenix/engine/frame_cache.hpp>
+#include <phoenix/engine/playback_engine.hpp>
+#include <chrono>
+#include <memory>
+
+namespace phoenix::engine {
+    class MediaService;
+    class MediaClient;
+}
+
+namespace phoenix::editor {
+
+/**
+ * @brief Sampled preview statistics
+ * 
+ * The engine and media service count and time every frame with
+ * relaxed atomics; this object reads those counters only while
+ * enabled, every kSampleIntervalMs, and reports rates and
+ * percentiles over the last interval. Latency percentiles keep their
+ * previous values through intervals without decodes or composes
+ * (e.g. while paused).
+ * 
+ * Usage (QML):
+ * @code
+ *   Text {
+ *       visible: PreviewController.stats.enabled
+ *       text: PreviewController.stats.deliveredFps.toFixed(1) + " fps"
+ *   }
+ * @endcode
+ */
+class PreviewStats : public QObject {
+    Q_OBJECT
+    
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    
+    // Frame rates over the last interval
+    Q_PROPERTY(double deliveredFps READ deliveredFps NOTIFY updated)
+    Q_PROPERTY(double droppedFps READ droppedFps NOTIFY updated)
+    
+    // Latency percentiles (ms)
+    Q_PROPERTY(double decodeP50 READ decodeP50 NOTIFY updated)
+    Q_PROPERTY(double decodeP95 READ decodeP95 NOTIFY updated)
+    Q_PROPERTY(double decodeP99 READ decodeP99 NOTIFY updated)
+    Q_PROPERTY(double composeP50 READ composeP50 NOTIFY updated)
+    Q_PROPERTY(double composeP95 READ composeP95 NOTIFY updated)
+    Q_PROPERTY(double composeP99 READ composeP99 NOTIFY updated)
+    Q_PROPERTY(double seekLatency READ seekLatency NOTIFY updated)
+    
+    // Frame cache
+    Q_PROPERTY(double cacheHitRate READ cacheHitRate NOTIFY updated)
+    Q_PROPERTY(double cacheMemoryMB READ cacheMemoryMB NOTIFY updated)
+    Q_PROPERTY(int cacheFrames READ cacheFrames NOTIFY updated)
+    
+    // Decoding
+    Q_PROPERTY(int activeDecoders READ activeDecoders NOTIFY updated)
+    Q_PROPERTY(int pooledDecoders READ pooledDecoders NOTIFY updated)
+    Q_PROPERTY(int queuedJobs READ queuedJobs NOTIFY updated)
+    Q_PROPERTY(int prefetchHorizon READ prefetchHorizon NOTIFY updated)
+    Q_PROPERTY(int prefetchLookahead READ prefetchLookahead NOTIFY updated)
+
+public:
+    static constexpr int kSampleIntervalMs = 500;
+    
+    explicit PreviewStats(QObject* parent = nullptr);
+    
+    // ========== Sources (PreviewController) ==========
+    
+    /**
+     * @brief Read from a viewer's engine and media client
+     * 
+     * @param lookahead Frames the viewer prefetches while playing
+     */
+    void setSources(engine::PlaybackEngine* engine,
+                    engine::MediaService* service,
+                    std::weak_ptr<engine::MediaClient> client,
+                    int lookahead);
+    
+    /// Stop reading (the engine is being replaced)
+    void clearSources();
+    
+    // ========== Properties ==========
+    
+    bool enabled() const { return m_timer.isActive(); }
+    void setEnabled(bool enabled);
+    
+    double deliveredFps() const { return m_deliveredFps; }
+    double droppedFps() const { return m_droppedFps; }
+    
+    double decodeP50() const { return m_decodeP50; }
+    double decodeP95() const { return m_decodeP95; }
+    double decodeP99() const { return m_decodeP99; }
+    double composeP50() const { return m_composeP50; }
+    double composeP95() const { return m_composeP95; }
+    double composeP99() const { return m_composeP99; }
+    double seekLatency() const { return m_seekLatency; }
+    
+    double cacheHitRate() const { return m_cacheHitRate; }
+    double cacheMemoryMB() const { return m_cacheMemoryMB; }
+    int cacheFrames() const { return m_cacheFrames; }
+    
+    int activeDecoders() const { return m_activeDecoders; }
+    int pooledDecoders() const { return m_pooledDecoders; }
+    int queuedJobs() const { return m_queuedJobs; }
+    int prefetchHorizon() const { return m_prefetchHorizon; }
+    int prefetchLookahead() const { return m_prefetchLookahead; }
+
+signals:
+    void enabledChanged();
+    void updated();
+
+private slots:
+    void sample();
+
+private:
+    /// Start a new interval from the current counters
+    void resetBaseline();
+    
+    QTimer m_timer;
+    
+    engine::PlaybackEngine* m_engine = nullptr;
+    engine::MediaService* m_service = nullptr;
+    std::weak_ptr<engine::MediaClient> m_client;
+    
+    // Counters at the start of the interval
+    std::chrono::steady_clock::time_point m_sampledAt;
+    engine::PlaybackStats m_lastPlayback;
+    engine::FrameCacheStats m_lastCache;
+    LatencyHistogram::Snapshot m_lastDecode;
+    LatencyHistogram::Snapshot m_lastCompose;
+    
+    double m_deliveredFps = 0.0;
+    double m_droppedFps = 0.0;
+    double m_decodeP50 = 0.0;
+    double m_decodeP95 = 0.0;
+    double m_decodeP99 = 0.0;
+    double m_composeP50 = 0.0;
+    double m_composeP95 = 0.0;
+    double m_composeP99 = 0.0;
+    double m_seekLatency = 0.0;
+    double m_cacheHitRate = 0.0;
+    double m_cacheMemoryMB = 0.0;
+    int m_cacheFrames = 0;
+    int m_activeDecoders = 0;
+    int m_pooledDecoders = 0;
+    int m_queuedJobs = 0;
+    int m_prefetchHorizon = 0;
+    int m_prefetchLookahead = 0;
+};
+
+} // namespace phoenix::editor
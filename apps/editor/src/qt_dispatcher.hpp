@@ -0,0 +1,49 @@
+/**
+ * @file qt_dispatcher.hpp
+ * @brief Dispatcher that delivers onto a QObject's thread
+ * 
+ * Bridges queued phoenix::Signal connections into the Qt event
+ * loop, so engine signals fired on worker threads run their slots
+ * on the UI thread.
+ */
+
+#pragma once
+
+#include <phoenix/core/signals.hpp>
+
+#include <QObject>
+#include <QPointer>
+#include <QMetaObject>
+
+namespace phoenix::editor {
+
+/**
+ * @brief Posts tasks to the thread of a context object
+ * 
+ * Tasks are queued events on the context object; they are dropped
+ * if the object is destroyed before they run.
+ * 
+ * Usage:
+ * @code
+ *   auto dispatcher = std::make_shared<QtDispatcher>(this);
+ *   (void)engine->positionChanged.connectQueued(dispatcher, [this](Timestamp pos) {
+ *       ...  // Runs on this object's thread
+ *   });
+ * @endcode
+ */
+class QtDispatcher : public Dispatcher {
+public:
+    explicit QtDispatcher(QObject* context)
+        : m_context(context) {}
+    
+    void post(std::function<void()> task) override {
+        QObject* context = m_context.data();
+        if (!context) return;
+        QMetaObject::invokeMethod(context, std::move(task), Qt::QueuedConnection);
+    }
+    
+private:
+    QPointer<QObject> m_context;
+};
+
+} // namespace phoenix::editor
@@ -0,0 +1,270 @@
+/**
+ * @file timeline_clip_model.cpp
+ * @brief Timeline clip model implementation
+ */
+
+#include "timeline_clip_model.hpp"
+
+#include <phoenix/model/track.hpp>
+#include <phoenix/model/clip.hpp>
+
+#include <QSet>
+
+#include <algorithm>
+
+namespace phoenix::editor {
+
+TimelineClipModel::TimelineClipModel(const QString& trackId, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_trackId(trackId)
+{
+}
+
+// ============================================================================
+// QAbstractListModel
+// ============================================================================
+
+int TimelineClipModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant TimelineClipModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) {
+        return QVariant();
+    }
+    
+    const Row& row = m_rows[index.row()];
+    switch (role) {
+        case ClipIdRole:      return row.clipId;
+        case NameRole:        return row.name;
+        case TimelineInRole:  return row.timelineIn;
+        case TimelineOutRole: return row.timelineOut;
+        case DurationRole:    return row.timelineOut - row.timelineIn;
+        case SourceInRole:    return row.sourceIn;
+        case SourceOutRole:   return row.sourceOut;
+        case SelectedRole:    return row.clipCount == 1 && row.clipId == m_selectedClipId;
+        case ClipCountRole:   return row.clipCount;
+        case MediaIdRole:     return row.mediaId;
+        default:              return QVariant();
+    }
+}
+
+QHash<int, QByteArray> TimelineClipModel::roleNames() const {
+    return {
+        {ClipIdRole, "clipId"},
+        {NameRole, "name"},
+        {TimelineInRole, "timelineIn"},
+        {TimelineOutRole, "timelineOut"},
+        {DurationRole, "duration"},
+        {SourceInRole, "sourceIn"},
+        {SourceOutRole, "sourceOut"},
+        {SelectedRole, "selected"},
+        {ClipCountRole, "clipCount"},
+        {MediaIdRole, "mediaId"},
+    };
+}
+
+// ============================================================================
+// Feeding
+// ============================================================================
+
+void TimelineClipModel::sync(const model::Track& track) {
+    const auto& clips = track.clips();
+    
+    std::vector<Row> next;
+    next.reserve(clips.size());
+    for (const auto& clip : clips) {
+        Row row;
+        row.clipId = QString::fromStdString(clip->id().toString());
+        row.name = QString::fromStdString(clip->name());
+        if (!clip->mediaItemId().isNull()) {
+            row.mediaId = QString::fromStdString(clip->mediaItemId().toString());
+        }
+        row.timelineIn = clip->timelineIn();
+        row.timelineOut = clip->timelineOut();
+        row.sourceIn = clip->sourceIn();
+        row.sourceOut = clip->sourceOut();
+        next.push_back(std::move(row));
+    }
+    
+    bool countChanged = next.size() != m_clips.size();
+    m_clips = std::move(next);
+    regroup();
+    updateRows();
+    
+    if (countChanged) emit clipCountChanged();
+}
+
+void TimelineClipModel::clear() {
+    if (m_clips.empty()) return;
+    
+    m_clips.clear();
+    regroup();
+    updateRows();
+    emit clipCountChanged();
+}
+
+void TimelineClipModel::setPixelsPerSecond(double pps) {
+    if (pps <= 0.0 || pps == m_pixelsPerSecond) return;
+    
+    m_pixelsPerSecond = pps;
+    regroup();
+    updateRows();
+}
+
+void TimelineClipModel::setSelectedClipId(const QString& clipId) {
+    if (clipId == m_selectedClipId) return;
+    
+    int oldRow = rowOf(m_selectedClipId);
+    m_selectedClipId = clipId;
+    int newRow = rowOf(m_selectedClipId);
+    
+    for (int row : {oldRow, newRow}) {
+        if (row >= 0) emit dataChanged(index(row), index(row), {SelectedRole});
+    }
+}
+
+// ============================================================================
+// Properties
+// ============================================================================
+
+void TimelineClipModel::setViewportX(double x) {
+    if (x == m_viewportX) return;
+    
+    m_viewportX = x;
+    updateRows();
+    emit viewportChanged();
+}
+
+void TimelineClipModel::setViewportWidth(double width) {
+    if (width == m_viewportWidth) return;
+    
+    m_viewportWidth = width;
+    updateRows();
+    emit viewportChanged();
+}
+
+// ============================================================================
+// Private Methods
+// ============================================================================
+
+void TimelineClipModel::regroup() {
+    m_items.clear();
+    m_items.reserve(m_clips.size());
+    
+    // Shortest span that still draws as a clip of its own
+    auto minSpan = static_cast<qint64>(kMinClipPixels / m_pixelsPerSecond * 1'000'000.0);
+    
+    for (const auto& clip : m_clips) {
+        bool small = clip.timelineOut - clip.timelineIn < minSpan;
+        if (small && !m_items.empty()) {
+            Row& last = m_items.back();
+            bool lastSmall = last.clipCount > 1 || last.timelineOut - last.timelineIn < minSpan;
+            if (lastSmall && clip.timelineIn - last.timelineOut < minSpan) {
+                if (last.clipCount == 1) {
+                    // A block has no single name or source range
+                    last.name.clear();
+                    last.mediaId.clear();
+                    last.sourceIn = 0;
+                    last.sourceOut = 0;
+                }
+                last.timelineOut = std::max(last.timelineOut, clip.timelineOut);
+                ++last.clipCount;
+                continue;
+            }
+        }
+        m_items.push_back(clip);
+    }
+}
+
+void TimelineClipModel::updateRows() {
+    // Items are sorted and do not overlap, so both edges are sorted
+    auto toTime = [this](double x) {
+        return static_cast<qint64>(x / m_pixelsPerSecond * 1'000'000.0);
+    };
+    qint64 start = toTime(m_viewportX - kOverscanPixels);
+    qint64 end = toTime(m_viewportX + m_viewportWidth + kOverscanPixels);
+    
+    auto first = std::partition_point(m_items.begin(), m_items.end(),
+        [start](const Row& r) { return r.timelineOut <= start; });
+    auto last = std::partition_point(first, m_items.end(),
+        [end](const Row& r) { return r.timelineIn < end; });
+    if (m_viewportWidth <= 0.0) last = first;
+    
+    std::vector<Row> next(first, last);
+    
+    // Remove rows that are gone, in contiguous runs from the back
+    QSet<QString> nextIds;
+    nextIds.reserve(static_cast<qsizetype>(next.size()));
+    for (const auto& row : next) nextIds.insert(row.clipId);
+    
+    for (int i = static_cast<int>(m_rows.size()) - 1; i >= 0; --i) {
+        if (nextIds.contains(m_rows[i].clipId)) continue;
+        
+        int runEnd = i;
+        while (i > 0 && !nextIds.contains(m_rows[i - 1].clipId)) --i;
+        beginRemoveRows(QModelIndex(), i, runEnd);
+        m_rows.erase(m_rows.begin() + i, m_rows.begin() + runEnd + 1);
+        endRemoveRows();
+    }
+    
+    // Walk the new order: keep, move into place, or insert runs
+    QSet<QString> currentIds;
+    currentIds.reserve(static_cast<qsizetype>(m_rows.size()));
+    for (const auto& row : m_rows) currentIds.insert(row.clipId);
+    
+    for (int i = 0; i < static_cast<int>(next.size()); ++i) {
+        const Row& wanted = next[i];
+        
+        if (!currentIds.contains(wanted.clipId)) {
+            int runEnd = i;
+            while (runEnd + 1 < static_cast<int>(next.size()) &&
+                   !currentIds.contains(next[runEnd + 1].clipId)) {
+                ++runEnd;
+            }
+            beginInsertRows(QModelIndex(), i, runEnd);
+            m_rows.insert(m_rows.begin() + i, next.begin() + i, next.begin() + runEnd + 1);
+            endInsertRows();
+            for (int j = i; j <= runEnd; ++j) currentIds.insert(next[j].clipId);
+            i = runEnd;
+            continue;
+        }
+        
+        if (m_rows[i].clipId != wanted.clipId) {
+            // A clip moved past its neighbours. If the rest is only
+            // shifted by one, the clip here moved later: move it alone
+            int size = static_cast<int>(m_rows.size());
+            if (i + 1 < size && m_rows[i + 1].clipId == wanted.clipId) {
+                const QString& movedId = m_rows[i].clipId;
+                auto target = std::find_if(next.begin() + i + 1, next.end(),
+                    [&movedId](const Row& r) { return r.clipId == movedId; });
+                int to = std::min(static_cast<int>(target - next.begin()), size - 1);
+                beginMoveRows(QModelIndex(), i, i, QModelIndex(), to + 1);
+                std::rotate(m_rows.begin() + i, m_rows.begin() + i + 1, m_rows.begin() + to + 1);
+                endMoveRows();
+            } else {
+                auto it = std::find_if(m_rows.begin() + i + 1, m_rows.end(),
+                    [&wanted](const Row& r) { return r.clipId == wanted.clipId; });
+                int from = static_cast<int>(it - m_rows.begin());
+                beginMoveRows(QModelIndex(), from, from, QModelIndex(), i);
+                std::rotate(m_rows.begin() + i, it, it + 1);
+                endMoveRows();
+            }
+        }
+        
+        if (!(m_rows[i] == wanted)) {
+            m_rows[i] = wanted;
+            emit dataChanged(index(i), index(i));
+        }
+    }
+}
+
+int TimelineClipModel::rowOf(const QString& clipId) const {
+    if (clipId.isEmpty()) return -1;
+    
+    auto it = std::find_if(m_rows.begin(), m_rows.end(),
+        [&clipId](const Row& r) { return r.clipId == clipId; });
+    return it != m_rows.end() ? static_cast<int>(it - m_rows.begin()) : -1;
+}
+
+} // namespace phoenix::editor
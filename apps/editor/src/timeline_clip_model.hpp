@@ -0,0 +1,143 @@
+/**
+ * @file timeline_clip_model.hpp
+ * @brief Viewport-culled list model of one track's clips
+ * 
+ * A track with thousands of clips used to become thousands of QML
+ * items, all recreated on every edit. This model only exposes the
+ * clips inside the visible time window, merges clips too small to
+ * draw into blocks, and turns sequence changes into row-level
+ * inserts, removes, moves and data changes.
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QString>
+#include <vector>
+
+namespace phoenix::model {
+    class Track;
+}
+
+namespace phoenix::editor {
+
+/**
+ * @brief Clips of one track within the viewport
+ * 
+ * Owned by TimelineController (see TimelineController::clipModel()),
+ * which feeds it the track on every change touching it, the zoom
+ * level and the selection. The view sets the viewport.
+ * 
+ * Usage (QML):
+ * @code
+ *   property QtObject clipModel: TimelineController.clipModel(trackData.id)
+ * 
+ *   Binding { target: clipModel; property: "viewportX"; value: flickable.contentX }
+ *   Binding { target: clipModel; property: "viewportWidth"; value: flickable.width }
+ * 
+ *   Repeater {
+ *       model: clipModel
+ *       delegate: TimelineClip { clipData: model }
+ *   }
+ * @endcode
+ */
+class TimelineClipModel : public QAbstractListModel {
+    Q_OBJECT
+    
+    Q_PROPERTY(QString trackId READ trackId CONSTANT)
+    Q_PROPERTY(double viewportX READ viewportX WRITE setViewportX NOTIFY viewportChanged)
+    Q_PROPERTY(double viewportWidth READ viewportWidth WRITE setViewportWidth NOTIFY viewportChanged)
+    Q_PROPERTY(int clipCount READ clipCount NOTIFY clipCountChanged)
+
+public:
+    enum Roles {
+        ClipIdRole = Qt::UserRole + 1,
+        NameRole,
+        TimelineInRole,
+        TimelineOutRole,
+        DurationRole,
+        SourceInRole,
+        SourceOutRole,
+        SelectedRole,
+        ClipCountRole,    ///< > 1 for a block of merged clips
+        MediaIdRole,      ///< Empty for blocks and nested sequences
+    };
+    
+    /**
+     * @brief A clip, or a block of clips too small to draw apart
+     */
+    struct Row {
+        QString clipId;      ///< First clip of a block
+        QString name;
+        QString mediaId;
+        qint64 timelineIn = 0;
+        qint64 timelineOut = 0;
+        qint64 sourceIn = 0;
+        qint64 sourceOut = 0;
+        int clipCount = 1;
+        
+        bool operator==(const Row& other) const = default;
+    };
+    
+    /// Clips narrower than this (and closer than this) merge into blocks
+    static constexpr double kMinClipPixels = 3.0;
+    
+    /// Extra width kept on each side of the viewport
+    static constexpr double kOverscanPixels = 200.0;
+    
+    explicit TimelineClipModel(const QString& trackId, QObject* parent = nullptr);
+    
+    // ========== QAbstractListModel ==========
+    
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    
+    // ========== Feeding (TimelineController) ==========
+    
+    /// Re-read the track's clips and apply the difference as row updates
+    void sync(const model::Track& track);
+    
+    /// Drop every clip (the track is gone)
+    void clear();
+    
+    /// Zoom level; regroups blocks
+    void setPixelsPerSecond(double pps);
+    
+    /// Highlight the selected clip
+    void setSelectedClipId(const QString& clipId);
+    
+    // ========== Properties ==========
+    
+    QString trackId() const { return m_trackId; }
+    
+    double viewportX() const { return m_viewportX; }
+    void setViewportX(double x);
+    
+    double viewportWidth() const { return m_viewportWidth; }
+    void setViewportWidth(double width);
+    
+    /// Clips on the track, visible or not
+    int clipCount() const { return static_cast<int>(m_clips.size()); }
+
+signals:
+    void viewportChanged();
+    void clipCountChanged();
+
+private:
+    void regroup();
+    void updateRows();
+    int rowOf(const QString& clipId) const;
+    
+    QString m_trackId;
+    double m_pixelsPerSecond = 100.0;
+    double m_viewportX = 0.0;
+    double m_viewportWidth = 0.0;
+    QString m_selectedClipId;
+    
+    std::vector<Row> m_clips;   // Every clip on the track, by start
+    std::vector<Row> m_items;   // m_clips with small neighbours merged
+    std::vector<Row> m_rows;    // Items in the viewport (the model's rows)
+};
+
+} // namespace phoenix::editor
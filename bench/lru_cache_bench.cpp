@@ -0,0 +1,79 @@
+/**
+ * @file lru_cache_bench.cpp
+ * @brief Shared cache throughput, ShardedLRUCache vs LRUCache
+ * 
+ * Every thread of a run reads and writes one shared cache. The
+ * argument is the share of lookups, in percent, that go to a hot set
+ * filled up front. The rest draw keys from twice the cache's
+ * capacity. A miss is followed by a put, as a thumbnail or metadata
+ * lookup would be. LRUCache takes its exclusive lock on every get();
+ * the sharded cache reads under per-shard shared locks.
+ */
+
+#include <phoenix/core/lru_cache.hpp>
+#include <phoenix/core/sharded_lru_cache.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+using namespace phoenix;
+
+namespace {
+
+constexpr size_t kCapacity = 1 << 14;
+constexpr uint64_t kHotKeys = kCapacity / 2;
+constexpr uint64_t kKeySpace = kCapacity * 2;
+constexpr int kMaxThreads = 16;
+
+using Sharded = ShardedLRUCache<uint64_t, uint64_t>;
+using Single = LRUCache<uint64_t, uint64_t>;
+
+// Shared by the threads of one run, created and dropped by thread 0
+template<typename Cache>
+std::unique_ptr<Cache> g_cache;
+
+template<typename Cache>
+void BM_CacheMixed(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_cache<Cache> = std::make_unique<Cache>(kCapacity);
+        for (uint64_t key = 0; key < kHotKeys; ++key) {
+            g_cache<Cache>->put(key, key);
+        }
+    }
+    
+    const auto hotPercent = static_cast<uint32_t>(state.range(0));
+    std::mt19937_64 rng(static_cast<uint64_t>(state.thread_index()) + 1);
+    std::uniform_int_distribution<uint64_t> hot(0, kHotKeys - 1);
+    std::uniform_int_distribution<uint64_t> any(0, kKeySpace - 1);
+    std::uniform_int_distribution<uint32_t> percent(0, 99);
+    
+    int64_t hits = 0;
+    for (auto _ : state) {
+        uint64_t key = percent(rng) < hotPercent ? hot(rng) : any(rng);
+        if (auto value = g_cache<Cache>->get(key)) {
+            benchmark::DoNotOptimize(*value);
+            ++hits;
+        } else {
+            g_cache<Cache>->put(key, key);
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_rate"] = benchmark::Counter(
+        static_cast<double>(hits) / static_cast<double>(state.iterations()),
+        benchmark::Counter::kAvgThreads);
+    
+    if (state.thread_index() == 0) {
+        g_cache<Cache>.reset();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_CacheMixed, Sharded)
+    ->Arg(100)->Arg(90)->ThreadRange(1, kMaxThreads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CacheMixed, Single)
+    ->Arg(100)->Arg(90)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,95 @@
+/**
+ * @file object_pool_bench.cpp
+ * @brief Shared pool throughput, ConcurrentObjectPool vs ObjectPool
+ * 
+ * Every thread of a run acquires an object from one shared pool and
+ * releases it again. ObjectPool takes its single mutex on both calls;
+ * ConcurrentObjectPool locks only the calling thread's slot. The
+ * mutex benchmarks price that slot lock: once uncontended, as on the
+ * fast path, and once shared by every thread, as when more than
+ * kThreadSlots threads map onto the same slots.
+ */
+
+#include <phoenix/core/concurrent_object_pool.hpp>
+#include <phoenix/core/object_pool.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace phoenix;
+
+namespace {
+
+constexpr size_t kCapacity = 256;
+constexpr int kMaxThreads = 16;
+
+using Buffer = std::vector<uint8_t>;
+
+// Shared by the threads of one run, created and dropped by thread 0
+std::unique_ptr<ConcurrentObjectPool<Buffer>> g_concurrentPool;
+std::unique_ptr<ObjectPool<Buffer>> g_pool;
+std::mutex g_sharedMutex;
+
+// ========== Acquire and release ==========
+
+void BM_ConcurrentPoolCycle(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_concurrentPool = std::make_unique<ConcurrentObjectPool<Buffer>>(kCapacity, kCapacity);
+    }
+    for (auto _ : state) {
+        Buffer buffer = g_concurrentPool->acquireOrCreate();
+        benchmark::DoNotOptimize(buffer.data());
+        g_concurrentPool->release(std::move(buffer));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        g_concurrentPool.reset();
+    }
+}
+BENCHMARK(BM_ConcurrentPoolCycle)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+void BM_ObjectPoolCycle(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_pool = std::make_unique<ObjectPool<Buffer>>(kCapacity, kCapacity);
+    }
+    for (auto _ : state) {
+        Buffer buffer = g_pool->acquireOrCreate();
+        benchmark::DoNotOptimize(buffer.data());
+        g_pool->release(std::move(buffer));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        g_pool.reset();
+    }
+}
+BENCHMARK(BM_ObjectPoolCycle)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+// ========== Slot lock ==========
+
+/// Two lock/unlock pairs per cycle, as acquire and release take
+void BM_SlotMutexUncontended(benchmark::State& state) {
+    std::mutex mutex;
+    for (auto _ : state) {
+        { std::lock_guard lock(mutex); }
+        { std::lock_guard lock(mutex); }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SlotMutexUncontended)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+void BM_SlotMutexShared(benchmark::State& state) {
+    for (auto _ : state) {
+        { std::lock_guard lock(g_sharedMutex); }
+        { std::lock_guard lock(g_sharedMutex); }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SlotMutexShared)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+} // namespace
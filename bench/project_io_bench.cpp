@@ -0,0 +1,114 @@
+/**
+ * @file project_io_bench.cpp
+ * @brief Open/save time for generated projects, binary vs JSON
+ * 
+ * Projects have 200 media items and eight tracks (four video, four
+ * audio) sharing the clip count evenly. Files go to the system temp
+ * directory and are removed afterwards.
+ */
+
+#include <phoenix/model/io/project_io.hpp>
+#include <phoenix/model/project.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace phoenix;
+using namespace phoenix::model;
+
+namespace {
+
+constexpr size_t kMediaItems = 200;
+constexpr int kTracksPerKind = 4;
+constexpr Duration kClipLength = 2'000'000;
+
+std::unique_ptr<Project> makeProject(size_t clipCount) {
+    auto project = std::make_unique<Project>("Bench");
+    
+    std::vector<MediaBin::ItemPtr> media;
+    for (size_t i = 0; i < kMediaItems; ++i) {
+        auto item = std::make_shared<MediaItem>("/media/clip_" + std::to_string(i) + ".mov");
+        item->setDuration(60'000'000);
+        item->setHasVideo(true);
+        item->setHasAudio(true);
+        project->mediaBin().addItem(item);
+        media.push_back(std::move(item));
+    }
+    
+    auto seq = project->activeSequence();
+    std::vector<std::shared_ptr<Track>> tracks;
+    for (int i = 0; i < kTracksPerKind; ++i) {
+        tracks.push_back(seq->addVideoTrack());
+        tracks.push_back(seq->addAudioTrack());
+    }
+    
+    for (size_t i = 0; i < clipCount; ++i) {
+        auto& track = tracks[i % tracks.size()];
+        const auto& item = media[i % media.size()];
+        auto clip = std::make_shared<Clip>(item->id());
+        clip->setName(item->name());
+        Timestamp in = static_cast<Timestamp>(i / tracks.size()) * kClipLength;
+        clip->setTimelineIn(in);
+        clip->setTimelineOut(in + kClipLength);
+        clip->setSourceIn(1'000'000);
+        clip->setSourceOut(1'000'000 + kClipLength);
+        track->addClip(std::move(clip));
+    }
+    seq->commitChange(SequenceChange::wholeTimeline());
+    return project;
+}
+
+std::filesystem::path benchPath(ProjectFormat format) {
+    auto name = format == ProjectFormat::Binary ? "phoenix_bench.phoenix" : "phoenix_bench.json";
+    return std::filesystem::temp_directory_path() / name;
+}
+
+void BM_Save(benchmark::State& state, ProjectFormat format) {
+    auto project = makeProject(static_cast<size_t>(state.range(0)));
+    auto path = benchPath(format);
+    
+    for (auto _ : state) {
+        if (!ProjectIO::save(*project, path, format).ok()) {
+            state.SkipWithError("save failed");
+            break;
+        }
+    }
+    state.counters["bytes"] = static_cast<double>(std::filesystem::file_size(path));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+
+/// Open, decoding the active sequence (the only one here)
+void BM_Open(benchmark::State& state, ProjectFormat format) {
+    auto path = benchPath(format);
+    if (!ProjectIO::save(*makeProject(static_cast<size_t>(state.range(0))), path, format).ok()) {
+        state.SkipWithError("save failed");
+        return;
+    }
+    
+    for (auto _ : state) {
+        auto result = ProjectIO::load(path);
+        if (!result.ok()) {
+            state.SkipWithError("load failed");
+            break;
+        }
+        benchmark::DoNotOptimize(result.value().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+
+BENCHMARK_CAPTURE(BM_Save, Binary, ProjectFormat::Binary)
+    ->RangeMultiplier(4)->Range(1 << 12, 1 << 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Save, Json, ProjectFormat::Json)
+    ->RangeMultiplier(4)->Range(1 << 12, 1 << 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Open, Binary, ProjectFormat::Binary)
+    ->RangeMultiplier(4)->Range(1 << 12, 1 << 16)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Open, Json, ProjectFormat::Json)
+    ->RangeMultiplier(4)->Range(1 << 12, 1 << 16)->Unit(benchmark::kMillisecond);
+
+} // namespace
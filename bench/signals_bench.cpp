@@ -0,0 +1,163 @@
+/**
+ * @file signals_bench.cpp
+ * @brief Signal emission cost, RCU slot list vs lock-and-copy
+ * 
+ * LegacySignal is the previous Signal::fire() (lock the mutex, copy
+ * the slot vector, call outside the lock), kept here as the baseline.
+ * Slots only count calls, so the numbers are the dispatch overhead.
+ * The threaded variants emit one shared signal from every thread.
+ */
+
+#include <phoenix/core/signals.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace phoenix;
+
+namespace {
+
+class LegacySignal {
+public:
+    void connect(std::function<void(int)> func) {
+        std::lock_guard lock(m_mutex);
+        m_slots.push_back({std::move(func), false});
+    }
+    
+    void fire(int value) {
+        std::vector<Slot> slotsCopy;
+        {
+            std::lock_guard lock(m_mutex);
+            slotsCopy = m_slots;
+        }
+        for (auto& slot : slotsCopy) {
+            if (!slot.blocked && slot.func) {
+                slot.func(value);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        std::function<void(int)> func;
+        bool blocked;
+    };
+    
+    std::mutex m_mutex;
+    std::vector<Slot> m_slots;
+};
+
+std::atomic<int64_t> g_calls{0};
+
+void countCall(int value) {
+    g_calls.fetch_add(value, std::memory_order_relaxed);
+}
+
+// Shared across the threads of one threaded run
+std::unique_ptr<Signal<int>> g_signal;
+std::unique_ptr<LegacySignal> g_legacySignal;
+std::vector<Connection> g_connections;
+
+// ========== Single thread ==========
+
+void BM_SignalFire(benchmark::State& state) {
+    Signal<int> signal;
+    std::vector<ScopedConnection> connections;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        connections.push_back(signal.connectScoped(countCall));
+    }
+    for (auto _ : state) {
+        signal.fire(1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SignalFire)->Arg(1)->Arg(4)->Arg(16);
+
+void BM_LegacySignalFire(benchmark::State& state) {
+    LegacySignal signal;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        signal.connect(countCall);
+    }
+    for (auto _ : state) {
+        signal.fire(1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LegacySignalFire)->Arg(1)->Arg(4)->Arg(16);
+
+// ========== Contended ==========
+
+void BM_SignalFireThreaded(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_signal = std::make_unique<Signal<int>>();
+        for (int i = 0; i < 4; ++i) {
+            g_connections.push_back(g_signal->connect(countCall));
+        }
+    }
+    for (auto _ : state) {
+        g_signal->fire(1);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        g_connections.clear();
+        g_signal.reset();
+    }
+}
+BENCHMARK(BM_SignalFireThreaded)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_LegacySignalFireThreaded(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_legacySignal = std::make_unique<LegacySignal>();
+        for (int i = 0; i < 4; ++i) {
+            g_legacySignal->connect(countCall);
+        }
+    }
+    for (auto _ : state) {
+        g_legacySignal->fire(1);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        g_legacySignal.reset();
+    }
+}
+BENCHMARK(BM_LegacySignalFireThreaded)->ThreadRange(1, 8)->UseRealTime();
+
+// ========== Queued ==========
+
+/// Emissions coalesced into one delivery per drain
+void BM_SignalFireQueuedLatest(benchmark::State& state) {
+    Signal<int> signal;
+    auto queue = std::make_shared<EventQueue>();
+    auto connection = signal.connectQueued(queue, countCall, QueuedDelivery::Latest);
+    for (auto _ : state) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            signal.fire(1);
+        }
+        queue->drain();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SignalFireQueuedLatest)->Arg(1)->Arg(64);
+
+/// Every emission posted and delivered
+void BM_SignalFireQueuedEvery(benchmark::State& state) {
+    Signal<int> signal;
+    auto queue = std::make_shared<EventQueue>();
+    auto connection = signal.connectQueued(queue, countCall, QueuedDelivery::Every);
+    for (auto _ : state) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            signal.fire(1);
+        }
+        queue->drain();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SignalFireQueuedEvery)->Arg(1)->Arg(64);
+
+} // namespace
@@ -0,0 +1,139 @@
+/**
+ * @file track_bench.cpp
+ * @brief Track build and gap search on large generated tracks
+ * 
+ * LegacyTrack is the previous Track algorithm (append and re-sort on
+ * every insert, linear overlap check and gap scan), kept here as the
+ * baseline the sorted index is measured against.
+ */
+
+#include <phoenix/model/track.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace phoenix;
+using namespace phoenix::model;
+
+namespace {
+
+constexpr Duration kClipLength = 1'000'000;
+
+/// Clips laid end to end with a 1us gap, shuffled unless @p sorted
+std::vector<Track::ClipPtr> makeClips(size_t count, bool sorted = false) {
+    std::vector<Track::ClipPtr> clips;
+    clips.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto clip = std::make_shared<Clip>();
+        Timestamp in = static_cast<Timestamp>(i) * (kClipLength + 1);
+        clip->setTimelineIn(in);
+        clip->setTimelineOut(in + kClipLength);
+        clips.push_back(std::move(clip));
+    }
+    if (!sorted) std::shuffle(clips.begin(), clips.end(), std::mt19937(42));
+    return clips;
+}
+
+class LegacyTrack {
+public:
+    LegacyTrack() = default;
+    
+    /// Adopt clips already sorted by timelineIn
+    explicit LegacyTrack(std::vector<Track::ClipPtr> sorted)
+        : m_clips(std::move(sorted)) {}
+    
+    bool addClip(Track::ClipPtr clip) {
+        if (hasOverlap(clip->timelineIn(), clip->timelineOut())) return false;
+        
+        m_clips.push_back(std::move(clip));
+        std::sort(m_clips.begin(), m_clips.end(),
+            [](const Track::ClipPtr& a, const Track::ClipPtr& b) {
+                return a->timelineIn() < b->timelineIn();
+            });
+        return true;
+    }
+    
+    [[nodiscard]] bool hasOverlap(Timestamp start, Timestamp end) const {
+        for (const auto& clip : m_clips) {
+            if (!(end <= clip->timelineIn() || clip->timelineOut() <= start)) return true;
+        }
+        return false;
+    }
+    
+    [[nodiscard]] Timestamp findGap(Timestamp afterTime, Duration minDuration) const {
+        for (size_t i = 0; i + 1 < m_clips.size(); ++i) {
+            Timestamp gapStart = m_clips[i]->timelineOut();
+            Timestamp gapEnd = m_clips[i + 1]->timelineIn();
+            if (gapStart >= afterTime && gapEnd - gapStart >= minDuration) return gapStart;
+        }
+        return m_clips.back()->timelineOut();
+    }
+
+private:
+    std::vector<Track::ClipPtr> m_clips;
+};
+
+// ========== Build ==========
+
+void BM_TrackBuild(benchmark::State& state) {
+    auto clips = makeClips(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        Track track(TrackType::Video);
+        for (const auto& clip : clips) track.addClip(clip);
+        benchmark::DoNotOptimize(track.clipCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrackBuild)->RangeMultiplier(4)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+
+/// Clips in timeline order, as a saved project loads them
+void BM_TrackBuildSorted(benchmark::State& state) {
+    auto clips = makeClips(static_cast<size_t>(state.range(0)), true);
+    for (auto _ : state) {
+        Track track(TrackType::Video);
+        track.reserveClips(clips.size());
+        for (const auto& clip : clips) track.addClip(clip);
+        benchmark::DoNotOptimize(track.clipCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrackBuildSorted)->RangeMultiplier(4)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+
+void BM_LegacyTrackBuild(benchmark::State& state) {
+    auto clips = makeClips(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        LegacyTrack track;
+        for (const auto& clip : clips) track.addClip(clip);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LegacyTrackBuild)->RangeMultiplier(4)->Range(1 << 10, 1 << 14)->Unit(benchmark::kMillisecond);
+
+// ========== Gap search ==========
+
+/// Only the gap after the last clip is wide enough
+void BM_TrackFindGap(benchmark::State& state) {
+    auto clips = makeClips(static_cast<size_t>(state.range(0)));
+    Track track(TrackType::Video);
+    for (const auto& clip : clips) track.addClip(clip);
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(track.findGap(0, kClipLength));
+    }
+}
+BENCHMARK(BM_TrackFindGap)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+void BM_LegacyTrackFindGap(benchmark::State& state) {
+    LegacyTrack track(makeClips(static_cast<size_t>(state.range(0)), true));
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(track.findGap(0, kClipLength));
+    }
+}
+BENCHMARK(BM_LegacyTrackFindGap)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+} // namespace
@@ -0,0 +1,294 @@
+/**
+ * @file async_log_sink.hpp
+ * @brief spdlog sink that hands messages to a background writer
+ * 
+ * A synchronous console or file sink makes the logging thread wait
+ * for the write. A burst of warnings from a decode error storm then
+ * stalls the render thread on I/O. AsyncLogSink copies each message
+ * into a bounded lock-free queue and returns; a writer thread passes
+ * the messages on to the real sinks. When the queue is full the
+ * message is dropped instead of waiting.
+ */
+
+#pragma once
+
+#include <spdlog/details/log_msg_buffer.h>
+#include <spdlog/formatter.h>
+#include <spdlog/sinks/sink.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace phoenix {
+
+/**
+ * @brief Asynchronous, non-blocking spdlog sink
+ * 
+ * log() claims a cell of a bounded multi-producer ring (one sequence
+ * number per cell), copies the message into it and publishes it.
+ * Short messages fit in the cell's inline buffer, so logging does not
+ * allocate, and it locks only to wake a parked writer. With every cell
+ * taken the message is counted as dropped, and the writer reports the
+ * count once there is room.
+ * 
+ * The writer parks on a condition variable while the queue is empty.
+ * flush() only asks the writer to flush; stop() closes the queue,
+ * writes out every message claimed before that and flushes
+ * synchronously. After stop(), messages are written on the calling
+ * thread.
+ * 
+ * Usage:
+ * @code
+ *   auto console = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+ *   auto sink = std::make_shared<AsyncLogSink>(std::vector<spdlog::sink_ptr>{console});
+ *   auto logger = std::make_shared<spdlog::logger>("app", sink);
+ * @endcode
+ */
+class AsyncLogSink : public spdlog::sinks::sink {
+public:
+    static constexpr size_t kDefaultQueueSize = 4096;
+    
+    /**
+     * @brief Construct sink and start the writer
+     * 
+     * @param sinks Sinks to write to (must be thread-safe, *_mt)
+     * @param queueSize Queued messages before dropping (rounded up to a power of 2)
+     */
+    explicit AsyncLogSink(std::vector<spdlog::sink_ptr> sinks,
+                          size_t queueSize = kDefaultQueueSize)
+        : m_sinks(std::move(sinks))
+        , m_capacity(roundToPowerOf2(std::max<size_t>(queueSize, 2)))
+        , m_mask(m_capacity - 1)
+        , m_cells(std::make_unique<Cell[]>(m_capacity))
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_writer = std::thread([this] { writerLoop(); });
+    }
+    
+    ~AsyncLogSink() override {
+        stop();
+    }
+    
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+    
+    // ========== spdlog::sinks::sink ==========
+    
+    void log(const spdlog::details::log_msg& msg) override {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            if (pos & kClosed) {
+                // Stopped: nobody drains the queue any more
+                write(msg);
+                return;
+            }
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                       std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Queue full: drop rather than wait for the writer
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        
+        cell->msg = spdlog::details::log_msg_buffer(msg);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        
+        // Pairs with the fence in park(): either the writer sees the
+        // message before parking, or this thread sees it parked
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_parked.load(std::memory_order_relaxed)) {
+            wakeWriter();
+        }
+    }
+    
+    void flush() override {
+        if (m_running.load(std::memory_order_acquire)) {
+            m_flushRequested.store(true, std::memory_order_release);
+            wakeWriter();
+        } else {
+            flushSinks();
+        }
+    }
+    
+    void set_pattern(const std::string& pattern) override {
+        for (auto& sink : m_sinks) {
+            sink->set_pattern(pattern);
+        }
+    }
+    
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override {
+        for (auto& sink : m_sinks) {
+            sink->set_formatter(formatter->clone());
+        }
+    }
+    
+    // ========== Control ==========
+    
+    /**
+     * @brief Stop the writer, write out queued messages and flush
+     * 
+     * Call before exit so nothing queued is lost. Idempotent.
+     */
+    void stop() {
+        if (!m_running.exchange(false, std::memory_order_acq_rel)) return;
+        
+        // No claims after this; later log() calls write synchronously
+        const size_t end = m_enqueuePos.fetch_or(kClosed, std::memory_order_acq_rel);
+        
+        wakeWriter();
+        if (m_writer.joinable()) {
+            m_writer.join();
+        }
+        
+        // The writer is gone, this thread is now the only consumer.
+        // Producers that claimed a cell before closing publish it shortly.
+        while (m_dequeuePos != end) {
+            if (drain() == 0) std::this_thread::yield();
+        }
+        reportDropped();
+        flushSinks();
+    }
+    
+    // ========== Statistics ==========
+    
+    /// Messages dropped because the queue was full
+    [[nodiscard]] uint64_t dropped() const {
+        return m_droppedTotal.load(std::memory_order_relaxed) +
+               m_dropped.load(std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] size_t queueSize() const { return m_capacity; }
+
+private:
+    /// Set in m_enqueuePos by stop(); fails every later claim
+    static constexpr size_t kClosed = ~(SIZE_MAX >> 1);
+    
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        spdlog::details::log_msg_buffer msg;
+    };
+    
+    static size_t roundToPowerOf2(size_t n) {
+        size_t power = 1;
+        while (power < n) power <<= 1;
+        return power;
+    }
+    
+    void writerLoop() {
+        while (m_running.load(std::memory_order_acquire)) {
+            size_t written = drain();
+            reportDropped();
+            
+            if (m_flushRequested.exchange(false, std::memory_order_acq_rel)) {
+                flushSinks();
+            }
+            if (written == 0) {
+                park();
+            }
+        }
+    }
+    
+    /// Wait until a message is published, a flush is asked for or stop()
+    void park() {
+        std::unique_lock lock(m_parkMutex);
+        m_parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_parkCv.wait(lock, [this] {
+            return hasPending() ||
+                   m_flushRequested.load(std::memory_order_acquire) ||
+                   !m_running.load(std::memory_order_acquire);
+        });
+        m_parked.store(false, std::memory_order_relaxed);
+    }
+    
+    void wakeWriter() {
+        std::lock_guard lock(m_parkMutex);
+        m_parkCv.notify_one();
+    }
+    
+    [[nodiscard]] bool hasPending() const {
+        const Cell& cell = m_cells[m_dequeuePos & m_mask];
+        return cell.sequence.load(std::memory_order_acquire) == m_dequeuePos + 1;
+    }
+    
+    /// Write out everything published so far (single consumer)
+    size_t drain() {
+        size_t written = 0;
+        for (;;) {
+            Cell& cell = m_cells[m_dequeuePos & m_mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            if (seq != m_dequeuePos + 1) break;
+            
+            write(cell.msg);
+            cell.sequence.store(m_dequeuePos + m_capacity, std::memory_order_release);
+            ++m_dequeuePos;
+            ++written;
+        }
+        return written;
+    }
+    
+    void reportDropped() {
+        uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped == 0) return;
+        
+        m_droppedTotal.fetch_add(dropped, std::memory_order_relaxed);
+        std::string text = "Log queue full, dropped " + std::to_string(dropped) + " messages";
+        spdlog::details::log_msg notice("", spdlog::level::warn, text);
+        write(notice);
+    }
+    
+    void write(const spdlog::details::log_msg& msg) {
+        for (auto& sink : m_sinks) {
+            if (sink->should_log(msg.level)) {
+                sink->log(msg);
+            }
+        }
+    }
+    
+    void flushSinks() {
+        for (auto& sink : m_sinks) {
+            sink->flush();
+        }
+    }
+    
+    // Sinks and queue (read-mostly)
+    std::vector<spdlog::sink_ptr> m_sinks;
+    size_t m_capacity;
+    size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    std::atomic<bool> m_running{true};
+    
+    // Producers
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    std::atomic<uint64_t> m_dropped{0};
+    
+    // Writer
+    alignas(64) size_t m_dequeuePos = 0;
+    std::atomic<uint64_t> m_droppedTotal{0};
+    std::atomic<bool> m_flushRequested{false};
+    std::atomic<bool> m_parked{false};
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCv;
+    std::thread m_writer;
+};
+
+} // namespace phoenix
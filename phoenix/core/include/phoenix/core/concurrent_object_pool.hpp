@@ -0,0 +1,468 @@
+/**
+ * @file concurrent_object_pool.hpp
+ * @brief Object pool with per-thread magazines and a lock-free depot
+ * 
+ * ObjectPool serialises every acquire and release on one mutex. A
+ * frame pool shared by several decode threads and sinks needs a fast
+ * path that does not contend: each thread works from its own
+ * magazines (small stacks of objects) and exchanges whole magazines
+ * with a lock-free depot only when they run empty or full.
+ * 
+ * The fast path still locks the thread's slot mutex, so a waiter can
+ * collect idle objects from it. That lock is uncontended unless more
+ * than kThreadSlots threads share slots; bench/object_pool_bench.cpp
+ * measures its cost.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace phoenix {
+
+namespace detail {
+
+/**
+ * @brief Small index of the calling thread, reused after it exits
+ * 
+ * Indexes per-thread slots in ConcurrentObjectPool. Allocated once
+ * per thread.
+ */
+inline size_t threadSlotIndex() {
+    struct Registry {
+        std::mutex mutex;
+        std::vector<size_t> free;
+        size_t next = 0;
+    };
+    static Registry& registry = *new Registry;  // Outlives exiting threads
+    
+    struct Holder {
+        size_t index;
+        
+        Holder() {
+            std::lock_guard lock(registry.mutex);
+            if (registry.free.empty()) {
+                index = registry.next++;
+            } else {
+                index = registry.free.back();
+                registry.free.pop_back();
+            }
+        }
+        
+        ~Holder() {
+            std::lock_guard lock(registry.mutex);
+            registry.free.push_back(index);
+        }
+    };
+    thread_local Holder holder;
+    return holder.index;
+}
+
+} // namespace detail
+
+/**
+ * @brief Pool counters
+ */
+struct ConcurrentObjectPoolStats {
+    uint64_t hits = 0;          ///< Acquired from the thread's own magazines
+    uint64_t depotHits = 0;     ///< Acquired after a magazine refill from the depot
+    uint64_t misses = 0;        ///< Nothing pooled (created, or acquire failed)
+    uint64_t depotReturns = 0;  ///< Magazines handed to the depot
+    uint64_t dropped = 0;       ///< Released with the pool full (destroyed)
+    size_t available = 0;       ///< Objects pooled now
+};
+
+/**
+ * @brief Thread-safe object pool for objects crossing threads
+ * 
+ * Every thread gets a slot with two magazines of up to magazineSize
+ * objects. acquire() and release() work on the slot alone. A thread
+ * that runs out refills from a lock-free stack of full magazines (the
+ * depot); a thread with both magazines full hands one to the depot.
+ * Objects acquired on a decode thread and released on a sink thread
+ * therefore travel in batches, one depot operation per magazine.
+ * 
+ * The depot holds up to capacity objects; with both magazines of
+ * every active thread full, further releases are dropped. Threads are
+ * assigned slots by a reused thread index, so objects left in the
+ * slot of a thread that exited serve the next thread given its index.
+ * 
+ * @tparam T Object type (must be default constructible and movable)
+ * 
+ * Usage:
+ * @code
+ *   ConcurrentObjectPool<FrameBuffer> pool(64);
+ * 
+ *   // Decode thread
+ *   FrameBuffer buffer = pool.acquireOrCreate();
+ * 
+ *   // Sink thread, when done with it
+ *   pool.release(std::move(buffer));
+ * @endcode
+ * 
+ * Blocking acquire() gives backpressure over a fixed set of objects:
+ * while a thread waits, releases go straight to the depot and the
+ * waiter collects objects idling in other threads' magazines.
+ */
+template<typename T>
+class ConcurrentObjectPool {
+public:
+    using Recycler = std::function<void(T)>;
+    
+    static constexpr size_t kDefaultMagazineSize = 8;
+    static constexpr size_t kThreadSlots = 64;      ///< Threads beyond this share slots
+    
+    /**
+     * @brief Construct pool
+     * 
+     * @param capacity Objects the depot can hold
+     * @param initialObjects Objects to create up front (at most capacity)
+     * @param magazineSize Objects per magazine
+     */
+    explicit ConcurrentObjectPool(size_t capacity, size_t initialObjects = 0,
+                                  size_t magazineSize = kDefaultMagazineSize)
+        : m_capacity(capacity)
+        , m_magazineSize(std::max<size_t>(1, magazineSize))
+        , m_nodeCount(std::max<size_t>(1, capacity))
+        , m_nodes(std::make_unique<Node[]>(m_nodeCount))
+        , m_slots(std::make_unique<Slot[]>(kThreadSlots))
+    {
+        for (size_t i = 0; i < m_nodeCount; ++i) {
+            push(m_free, static_cast<uint32_t>(i));
+        }
+        
+        // Full magazines, straight into the depot
+        initialObjects = std::min(initialObjects, capacity);
+        while (initialObjects > 0) {
+            uint32_t node = pop(m_free);
+            auto& items = m_nodes[node].items;
+            size_t count = std::min(initialObjects, m_magazineSize);
+            for (size_t i = 0; i < count; ++i) items.emplace_back();
+            initialObjects -= count;
+            m_depotObjects.fetch_add(count, std::memory_order_relaxed);
+            push(m_full, node);
+        }
+    }
+    
+    // Non-copyable, non-movable
+    ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+    ConcurrentObjectPool(ConcurrentObjectPool&&) = delete;
+    ConcurrentObjectPool& operator=(ConcurrentObjectPool&&) = delete;
+    
+    // ========== Acquire Operations ==========
+    
+    /**
+     * @brief Acquire object from pool (blocking)
+     * 
+     * @param timeout Maximum wait time (0 = wait forever)
+     * @return Object if available, nullopt on timeout or stop()
+     */
+    std::optional<T> acquire(std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        if (auto obj = tryAcquire()) return obj;
+        
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        m_waiters.fetch_add(1);
+        
+        std::optional<T> obj;
+        while (!m_stopped.load(std::memory_order_acquire)) {
+            // Objects may idle in magazines of threads that stopped releasing
+            collectIdle();
+            if ((obj = takeLocal(false))) break;
+            
+            // Poll as well: a release may miss the waiter count
+            std::chrono::steady_clock::duration wait = kWaitPoll;
+            if (timeout.count() > 0) {
+                auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) break;
+                wait = std::min<std::chrono::steady_clock::duration>(wait, deadline - now);
+            }
+            std::unique_lock lock(m_waitMutex);
+            m_cv.wait_for(lock, wait);
+        }
+        
+        m_waiters.fetch_sub(1);
+        return obj;
+    }
+    
+    /**
+     * @brief Try to acquire without blocking
+     */
+    std::optional<T> tryAcquire() {
+        return takeLocal(true);
+    }
+    
+    /**
+     * @brief Acquire or create new object
+     */
+    T acquireOrCreate() {
+        if (auto obj = tryAcquire()) return std::move(*obj);
+        return T{};
+    }
+    
+    // ========== Release Operations ==========
+    
+    /**
+     * @brief Release object back to pool
+     */
+    void release(T obj) {
+        Slot& slot = currentSlot();
+        bool waiters = m_waiters.load() > 0;
+        {
+            std::lock_guard lock(slot.mutex);
+            
+            if (slot.loaded.size() >= m_magazineSize) {
+                // Both full: hand the older one to the depot
+                if (slot.previous.size() >= m_magazineSize && !spill(slot, slot.previous)) {
+                    ++slot.dropped;
+                    return;
+                }
+                std::swap(slot.loaded, slot.previous);
+            }
+            slot.loaded.push_back(std::move(obj));
+            
+            // A waiter cannot take from this slot's magazines
+            if (waiters) spill(slot, slot.loaded);
+        }
+        if (waiters) {
+            std::lock_guard lock(m_waitMutex);
+            m_cv.notify_one();
+        }
+    }
+    
+    /**
+     * @brief Get a recycler function for this pool
+     */
+    Recycler getRecycler() {
+        return [this](T obj) {
+            this->release(std::move(obj));
+        };
+    }
+    
+    // ========== Pool Management ==========
+    
+    /**
+     * @brief Destroy all pooled objects
+     */
+    void clear() {
+        for (size_t i = 0; i < kThreadSlots; ++i) {
+            std::lock_guard lock(m_slots[i].mutex);
+            m_slots[i].loaded.clear();
+            m_slots[i].previous.clear();
+        }
+        for (uint32_t node = pop(m_full); node != kNil; node = pop(m_full)) {
+            size_t count = m_nodes[node].items.size();
+            m_nodes[node].items.clear();
+            push(m_free, node);
+            m_depotObjects.fetch_sub(count, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Stop the pool (wake up all waiters)
+     */
+    void stop() {
+        m_stopped.store(true, std::memory_order_release);
+        std::lock_guard lock(m_waitMutex);
+        m_cv.notify_all();
+    }
+    
+    /**
+     * @brief Reset pool to running state
+     */
+    void reset() {
+        m_stopped.store(false, std::memory_order_release);
+    }
+    
+    // ========== State Queries ==========
+    
+    [[nodiscard]] bool stopped() const {
+        return m_stopped.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Objects pooled in the depot and all magazines
+     */
+    [[nodiscard]] size_t available() const {
+        return stats().available;
+    }
+    
+    [[nodiscard]] size_t magazineSize() const { return m_magazineSize; }
+    
+    /**
+     * @brief Sum of all slots (each read under its own lock)
+     */
+    [[nodiscard]] ConcurrentObjectPoolStats stats() const {
+        ConcurrentObjectPoolStats s;
+        for (size_t i = 0; i < kThreadSlots; ++i) {
+            const Slot& slot = m_slots[i];
+            std::lock_guard lock(slot.mutex);
+            s.hits += slot.hits;
+            s.depotHits += slot.depotHits;
+            s.misses += slot.misses;
+            s.depotReturns += slot.depotReturns;
+            s.dropped += slot.dropped;
+            s.available += slot.loaded.size() + slot.previous.size();
+        }
+        s.available += m_depotObjects.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    static constexpr uint32_t kNil = UINT32_MAX;
+    static constexpr auto kWaitPoll = std::chrono::milliseconds(5);
+    
+    /// Depot entry: a magazine, on the full or the free stack
+    struct Node {
+        std::vector<T> items;
+        std::atomic<uint32_t> next{kNil};
+    };
+    
+    /// One thread's magazines; the mutex is contended only when
+    /// threads share a slot (thread index modulo kThreadSlots) or a
+    /// waiter collects idle objects
+    struct alignas(64) Slot {
+        mutable std::mutex mutex;
+        std::vector<T> loaded;
+        std::vector<T> previous;
+        
+        uint64_t hits = 0;
+        uint64_t depotHits = 0;
+        uint64_t misses = 0;
+        uint64_t depotReturns = 0;
+        uint64_t dropped = 0;
+    };
+    
+    Slot& currentSlot() {
+        return m_slots[detail::threadSlotIndex() % kThreadSlots];
+    }
+    
+    /// From the thread's magazines, refilled from the depot if empty
+    std::optional<T> takeLocal(bool countMiss) {
+        Slot& slot = currentSlot();
+        std::lock_guard lock(slot.mutex);
+        
+        if (slot.loaded.empty()) std::swap(slot.loaded, slot.previous);
+        if (!slot.loaded.empty()) {
+            ++slot.hits;
+            return take(slot.loaded);
+        }
+        
+        // Both empty: exchange the empty magazine for a full one
+        uint32_t node = pop(m_full);
+        if (node == kNil) {
+            if (countMiss) ++slot.misses;
+            return std::nullopt;
+        }
+        size_t count = m_nodes[node].items.size();
+        std::swap(slot.loaded, m_nodes[node].items);
+        push(m_free, node);
+        m_depotObjects.fetch_sub(count, std::memory_order_relaxed);  // Node free first
+        
+        ++slot.depotHits;
+        return take(slot.loaded);
+    }
+    
+    static T take(std::vector<T>& magazine) {
+        T obj = std::move(magazine.back());
+        magazine.pop_back();
+        return obj;
+    }
+    
+    // ========== Depot (lock-free stacks) ==========
+    //
+    // Heads pack a node index with a tag bumped on every change, so a
+    // node popped and pushed back between a load and a CAS fails the CAS.
+    
+    static uint64_t pack(uint32_t node, uint32_t tag) {
+        return (static_cast<uint64_t>(tag) << 32) | node;
+    }
+    
+    void push(std::atomic<uint64_t>& head, uint32_t node) {
+        uint64_t old = head.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            m_nodes[node].next.store(static_cast<uint32_t>(old), std::memory_order_relaxed);
+            next = pack(node, static_cast<uint32_t>(old >> 32) + 1);
+        } while (!head.compare_exchange_weak(old, next,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+    
+    uint32_t pop(std::atomic<uint64_t>& head) {
+        uint64_t old = head.load(std::memory_order_acquire);
+        uint64_t next;
+        do {
+            auto node = static_cast<uint32_t>(old);
+            if (node == kNil) return kNil;
+            uint32_t after = m_nodes[node].next.load(std::memory_order_relaxed);
+            next = pack(after, static_cast<uint32_t>(old >> 32) + 1);
+        } while (!head.compare_exchange_weak(old, next,
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire));
+        return static_cast<uint32_t>(old);
+    }
+    
+    /// Move a magazine into the depot (slot locked); false if it is full
+    bool spill(Slot& slot, std::vector<T>& magazine) {
+        size_t count = magazine.size();
+        if (count == 0) return true;
+        
+        // A node per object of capacity, and objects count until their
+        // node is free again: within capacity, a free node exists
+        if (m_depotObjects.fetch_add(count, std::memory_order_relaxed) + count > m_capacity) {
+            m_depotObjects.fetch_sub(count, std::memory_order_relaxed);
+            return false;
+        }
+        uint32_t node = pop(m_free);
+        if (node == kNil) {
+            m_depotObjects.fetch_sub(count, std::memory_order_relaxed);
+            return false;
+        }
+        
+        // The node's empty vector keeps its allocation for the next refill
+        std::swap(m_nodes[node].items, magazine);
+        if (magazine.capacity() < m_magazineSize) magazine.reserve(m_magazineSize);
+        push(m_full, node);
+        ++slot.depotReturns;
+        return true;
+    }
+    
+    /// Move objects idling in every slot's magazines to the depot
+    void collectIdle() {
+        for (size_t i = 0; i < kThreadSlots; ++i) {
+            Slot& slot = m_slots[i];
+            std::unique_lock lock(slot.mutex, std::try_to_lock);
+            if (!lock.owns_lock()) continue;     // Busy: it will see the waiter
+            spill(slot, slot.loaded);
+            spill(slot, slot.previous);
+        }
+    }
+    
+    size_t m_capacity;
+    size_t m_magazineSize;
+    size_t m_nodeCount;
+    std::unique_ptr<Node[]> m_nodes;
+    alignas(64) std::atomic<uint64_t> m_full{pack(kNil, 0)};
+    alignas(64) std::atomic<uint64_t> m_free{pack(kNil, 0)};
+    std::atomic<size_t> m_depotObjects{0};
+    
+    std::unique_ptr<Slot[]> m_slots;
+    
+    // Blocking acquire
+    std::atomic<int> m_waiters{0};
+    std::atomic<bool> m_stopped{false};
+    std::mutex m_waitMutex;
+    std::condition_variable m_cv;
+};
+
+} // namespace phoenix
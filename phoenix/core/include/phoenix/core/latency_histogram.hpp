@@ -0,0 +1,149 @@
+/**
+ * @file latency_histogram.hpp
+ * @brief Lock-free latency histogram for always-on timing
+ * 
+ * Decode and compose times are recorded on every frame, so recording
+ * must cost no more than a couple of relaxed atomic increments.
+ * Percentiles are computed by readers from a snapshot, and two
+ * snapshots give the percentiles of the interval between them.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace phoenix {
+
+/**
+ * @brief Log-linear histogram of durations in microseconds
+ * 
+ * Values below 16 µs have a bucket each; above that, every power of
+ * two is split into 8 buckets (at most 12.5% error). Values beyond
+ * about two minutes land in the last bucket.
+ * 
+ * Usage:
+ * @code
+ *   LatencyHistogram decodeTimes;
+ *   decodeTimes.record(elapsedMicros);          // Any thread
+ * 
+ *   auto now = decodeTimes.snapshot();
+ *   auto window = now.since(previous);          // Since the last sample
+ *   Duration p95 = window.percentile(0.95);
+ *   previous = now;
+ * @endcode
+ * 
+ * Thread safety: record() and snapshot() may be called concurrently
+ * from any threads. A snapshot taken during recording may miss the
+ * values being recorded; it is never torn within a bucket.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kLinearLimit = 16;     ///< Values below this have exact buckets
+    static constexpr int kSubBucketBits = 3;    ///< 8 buckets per power of two
+    static constexpr int kMaxBits = 27;         ///< ~134 s
+    static constexpr size_t kBucketCount =
+        kLinearLimit + (kMaxBits - 4) * (1 << kSubBucketBits);
+    
+    /**
+     * @brief Counts at one point in time
+     */
+    struct Snapshot {
+        std::array<uint64_t, kBucketCount> counts{};
+        uint64_t count = 0;
+        Duration total = 0;     ///< Sum of the recorded values
+        
+        /// Values recorded between @p earlier and this snapshot
+        [[nodiscard]] Snapshot since(const Snapshot& earlier) const {
+            Snapshot delta;
+            for (size_t i = 0; i < kBucketCount; ++i) {
+                delta.counts[i] = counts[i] - earlier.counts[i];
+                delta.count += delta.counts[i];
+            }
+            delta.total = total - earlier.total;
+            return delta;
+        }
+        
+        /**
+         * @brief Value at a quantile
+         * 
+         * @param quantile 0.0 to 1.0 (0.95 = 95th percentile)
+         * @return Upper bound of the bucket holding it, or 0 if empty
+         */
+        [[nodiscard]] Duration percentile(double quantile) const {
+            if (count == 0) return 0;
+            
+            auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count));
+            if (rank >= count) rank = count - 1;
+            
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBucketCount; ++i) {
+                seen += counts[i];
+                if (seen > rank) return bucketUpperBound(i);
+            }
+            return bucketUpperBound(kBucketCount - 1);
+        }
+        
+        [[nodiscard]] Duration mean() const {
+            return count > 0 ? total / static_cast<Duration>(count) : 0;
+        }
+    };
+    
+    LatencyHistogram() = default;
+    
+    // Non-copyable (atomics)
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    
+    /**
+     * @brief Record a duration (lock-free)
+     */
+    void record(Duration micros) {
+        m_counts[bucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(micros > 0 ? micros : 0, std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] Snapshot snapshot() const {
+        Snapshot s;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            s.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+            s.count += s.counts[i];
+        }
+        s.total = m_total.load(std::memory_order_relaxed);
+        return s;
+    }
+    
+    // ========== Buckets ==========
+    
+    [[nodiscard]] static size_t bucketOf(Duration micros) {
+        if (micros < kLinearLimit) return micros > 0 ? static_cast<size_t>(micros) : 0;
+        
+        auto value = static_cast<uint64_t>(micros);
+        int bits = std::bit_width(value) - 1;     // >= 4
+        if (bits >= kMaxBits) return kBucketCount - 1;
+        
+        auto sub = static_cast<size_t>((value >> (bits - kSubBucketBits)) &
+                                       ((1u << kSubBucketBits) - 1));
+        return kLinearLimit + static_cast<size_t>(bits - 4) * (1u << kSubBucketBits) + sub;
+    }
+    
+    [[nodiscard]] static Duration bucketUpperBound(size_t bucket) {
+        if (bucket < kLinearLimit) return static_cast<Duration>(bucket);
+        
+        size_t offset = bucket - kLinearLimit;
+        int bits = static_cast<int>(offset >> kSubBucketBits) + 4;
+        uint64_t sub = offset & ((1u << kSubBucketBits) - 1);
+        uint64_t width = uint64_t(1) << (bits - kSubBucketBits);
+        return static_cast<Duration>((((1u << kSubBucketBits) + sub) * width) + width - 1);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> m_counts{};
+    std::atomic<Duration> m_total{0};
+};
+
+} // namespace phoenix
@@ -3,11 +3,20 @@
  * @brief Logging utilities wrapping spdlog
  * 
  * Provides a thin wrapper around spdlog with convenient macros.
+ * 
+ * Messages go through an AsyncLogSink, so logging from a decode or
+ * render thread never waits on console or file I/O; under a burst the
+ * excess is dropped. LOG_TRACE/LOG_DEBUG compile to nothing unless
+ * SPDLOG_ACTIVE_LEVEL allows them (phoenix_core keeps them in Debug
+ * builds only). The *_EVERY macros rate limit a single call site.
  */
 
 #pragma once
 
 #include <spdlog/spdlog.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -16,12 +25,45 @@ namespace phoenix {
 /// Initialize logging system (call once at startup)
 void initLogging(const std::string& appName, spdlog::level::level_enum level = spdlog::level::info);
 
+/// Write out queued messages and stop the background writer (call before exit)
+void shutdownLogging();
+
 /// Get default logger
-std::shared_ptr<spdlog::logger> getLogger();
+const std::shared_ptr<spdlog::logger>& getLogger();
 
 /// Set log level at runtime
 void setLogLevel(spdlog::level::level_enum level);
 
+/// Messages dropped because the log queue was full
+uint64_t droppedLogMessages();
+
+/**
+ * @brief Lets one message through per interval
+ * 
+ * One instance per call site (see the *_EVERY macros). Calls within
+ * the interval after an accepted one are rejected; concurrent callers
+ * race for the next slot with a single compare-exchange.
+ */
+class LogRateLimiter {
+public:
+    explicit LogRateLimiter(std::chrono::milliseconds interval)
+        : m_interval(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count())
+    {
+    }
+    
+    [[nodiscard]] bool allow() {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t next = m_next.load(std::memory_order_relaxed);
+        if (now < next) return false;
+        return m_next.compare_exchange_strong(next, now + m_interval, std::memory_order_relaxed);
+    }
+
+private:
+    int64_t m_interval;
+    std::atomic<int64_t> m_next{0};
+};
+
 } // namespace phoenix
 
 // Convenience macros for logging (global scope, simple names)
@@ -31,3 +73,41 @@ void setLogLevel(spdlog::level::level_enum level);
 #define LOG_WARN(...)     SPDLOG_LOGGER_WARN(phoenix::getLogger(), __VA_ARGS__)
 #define LOG_ERROR(...)    SPDLOG_LOGGER_ERROR(phoenix::getLogger(), __VA_ARGS__)
 #define LOG_CRITICAL(...) SPDLOG_LOGGER_CRITICAL(phoenix::getLogger(), __VA_ARGS__)
+
+// Rate-limited logging: at most one message per intervalMs from this call site
+#define PHOENIX_LOG_EVERY(logMacro, intervalMs, ...)                                \
+    do {                                                                            \
+        static phoenix::LogRateLimiter phoenixLogLimiter{                           \
+            std::chrono::milliseconds(intervalMs)};                                 \
+        if (phoenixLogLimiter.allow()) logMacro(__VA_ARGS__);                       \
+    } while (0)
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LOG_TRACE_EVERY(intervalMs, ...) PHOENIX_LOG_EVERY(LOG_TRACE, intervalMs, __VA_ARGS__)
+#else
+#define LOG_TRACE_EVERY(intervalMs, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LOG_DEBUG_EVERY(intervalMs, ...) PHOENIX_LOG_EVERY(LOG_DEBUG, intervalMs, __VA_ARGS__)
+#else
+#define LOG_DEBUG_EVERY(intervalMs, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_INFO_EVERY(intervalMs, ...) PHOENIX_LOG_EVERY(LOG_INFO, intervalMs, __VA_ARGS__)
+#else
+#define LOG_INFO_EVERY(intervalMs, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define LOG_WARN_EVERY(intervalMs, ...) PHOENIX_LOG_EVERY(LOG_WARN, intervalMs, __VA_ARGS__)
+#else
+#define LOG_WARN_EVERY(intervalMs, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define LOG_ERROR_EVERY(intervalMs, ...) PHOENIX_LOG_EVERY(LOG_ERROR, intervalMs, __VA_ARGS__)
+#else
+#define LOG_ERROR_EVERY(intervalMs, ...) (void)0
+#endif
@@ -10,10 +10,15 @@
  * - Thread-safe with shared mutex (multiple readers, single writer)
  * - Configurable maximum size
  * - Optional eviction callback
+ * 
+ * get() reorders the list, so reads are exclusive too. For caches read
+ * from many threads at once, see ShardedLRUCache.
  */
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <list>
 #include <optional>
@@ -361,6 +366,10 @@ public:
         return m_cache.capacity();
     }
     
+    void resize(size_t newMaxSize) {
+        m_cache.resize(newMaxSize);
+    }
+    
 private:
     LRUCache<Key, ValuePtr> m_cache;
 };
@@ -25,6 +25,9 @@ namespace phoenix {
  * Objects can be acquired (blocking or non-blocking) and released back.
  * When the pool is empty, acquire() blocks until an object is available.
  * 
+ * Every operation takes one mutex. For objects acquired and released
+ * on many threads, see ConcurrentObjectPool.
+ * 
  * @tparam T Object type (must be default constructible)
  */
 template<typename T>
@@ -7,6 +7,8 @@
  * - Lock-free using atomic head/tail pointers
  * - Power-of-2 size for efficient modulo via bitmask
  * - Sized for 400-600ms of audio data at 48kHz stereo 16-bit
+ * - Reserve/commit regions, so a resampler can write into the buffer
+ *   and an audio callback read out of it without a staging copy
  */
 
 #pragma once
@@ -15,92 +17,151 @@
 #include <cstdint>
 #include <cstring>
 #include <algorithm>
+#include <span>
 #include <vector>
 #include <thread>
 
 namespace phoenix {
 
 /**
- * @brief Lock-free single-producer single-consumer ring buffer
+ * @brief Part of a ring buffer, in at most two contiguous pieces
+ * 
+ * The second piece is empty unless the region wraps around the end
+ * of the buffer.
+ */
+template<typename T>
+struct RingRegions {
+    std::span<T> first;
+    std::span<T> second;
+    size_t frames = 0;      ///< Whole frames in both pieces
+    
+    [[nodiscard]] bool empty() const { return frames == 0; }
+};
+
+/**
+ * @brief Fill level history of a ring buffer
+ * 
+ * The watermarks show how close playback came to an underrun, and
+ * whether the buffer is bigger than it needs to be.
+ */
+struct RingBufferStats {
+    size_t lowWatermark = 0;    ///< Least data found by a read (frames)
+    size_t highWatermark = 0;   ///< Most data after a write (frames)
+    uint64_t underruns = 0;     ///< Reads that wanted more than was buffered
+};
+
+/**
+ * @brief Lock-free single-producer single-consumer ring of sample frames
+ * 
+ * A frame is one sample per channel, interleaved. Capacity, positions
+ * and every count are in frames, so regions never split a frame.
+ * 
+ * Zero-copy use:
+ * @code
+ *   // Producer: convert straight into the buffer
+ *   auto regions = ring.beginWrite(frames);
+ *   size_t done = convert(regions.first);
+ *   if (done == regions.first.size() / ring.channels()) done += convert(regions.second);
+ *   ring.commitWrite(done);
+ * 
+ *   // Consumer
+ *   auto data = ring.beginRead(wanted);
+ *   play(data.first); play(data.second);
+ *   ring.commitRead(data.frames);
+ * @endcode
  * 
  * Thread safety:
- * - write(): Single producer thread (audio decode/resample)
- * - read(): Single consumer thread (SDL audio callback)
- * - clear(): Can be called from producer when synchronized
- * - availableRead/Write(): Safe from any thread
+ * - beginWrite()/commitWrite()/write(): Single producer thread
+ * - beginRead()/commitRead()/read()/skip(): Single consumer thread
+ * - clear(): Only while neither side is running
+ * - availableRead/Write(), stats(): Safe from any thread
+ * 
+ * @tparam Sample Sample type (float, int16_t, or uint8_t for bytes)
  */
-class LockFreeRingBuffer {
+template<typename Sample>
+class FrameRingBuffer {
 public:
-    /// Default capacity: 128KB (~680ms at 48kHz/stereo/16-bit)
-    static constexpr size_t kDefaultCapacity = 131072;
-    
-    /// Minimum capacity: 16KB
-    static constexpr size_t kMinCapacity = 16384;
-    
-    /// Maximum capacity: 1MB
-    static constexpr size_t kMaxCapacity = 1048576;
-    
     /**
-     * @brief Construct ring buffer with given capacity
-     * @param capacity Buffer size in bytes (will be rounded to power of 2)
+     * @brief Construct ring buffer
+     * 
+     * @param capacityFrames Capacity (will be rounded to power of 2)
+     * @param channels Samples per frame
      */
-    explicit LockFreeRingBuffer(size_t capacity = kDefaultCapacity)
-        : m_mask(roundToPowerOf2(std::clamp(capacity, kMinCapacity, kMaxCapacity)) - 1)
-        , m_buffer(m_mask + 1)
+    explicit FrameRingBuffer(size_t capacityFrames, size_t channels = 2)
+        : m_channels(std::max<size_t>(1, channels))
+        , m_mask(roundToPowerOf2(capacityFrames) - 1)
+        , m_buffer((m_mask + 1) * m_channels)
+        , m_lowWatermark(m_mask + 1)
     {}
     
     // Non-copyable, non-movable (due to atomic members)
-    LockFreeRingBuffer(const LockFreeRingBuffer&) = delete;
-    LockFreeRingBuffer& operator=(const LockFreeRingBuffer&) = delete;
-    LockFreeRingBuffer(LockFreeRingBuffer&&) = delete;
-    LockFreeRingBuffer& operator=(LockFreeRingBuffer&&) = delete;
+    FrameRingBuffer(const FrameRingBuffer&) = delete;
+    FrameRingBuffer& operator=(const FrameRingBuffer&) = delete;
+    FrameRingBuffer(FrameRingBuffer&&) = delete;
+    FrameRingBuffer& operator=(FrameRingBuffer&&) = delete;
     
     // ========== Producer Interface ==========
     
     /**
-     * @brief Write data to the buffer
+     * @brief Reserve free space to write into
      * 
-     * Non-blocking: writes as much as possible, returns actual bytes written.
+     * Nothing is visible to the consumer until commitWrite(). Another
+     * beginWrite() before that returns the same space.
      * 
-     * @param data Source data pointer
-     * @param size Number of bytes to write
-     * @return Actual bytes written (may be less than size if buffer full)
+     * @param maxFrames Frames wanted
+     * @return Up to maxFrames of free space (empty if full)
      */
-    size_t write(const uint8_t* data, size_t size) {
-        if (size == 0 || !data) return 0;
-        
+    [[nodiscard]] RingRegions<Sample> beginWrite(size_t maxFrames) {
         const size_t writePos = m_writePos.load(std::memory_order_relaxed);
         const size_t readPos = m_readPos.load(std::memory_order_acquire);
         
-        // Calculate available space
         const size_t available = capacity() - (writePos - readPos);
-        const size_t toWrite = std::min(size, available);
-        
-        if (toWrite == 0) return 0;
-        
-        // Write in one or two chunks (handle wrap-around)
-        const size_t writeIdx = writePos & m_mask;
-        const size_t firstChunk = std::min(toWrite, capacity() - writeIdx);
-        const size_t secondChunk = toWrite - firstChunk;
+        return regions<Sample>(writePos, std::min(maxFrames, available));
+    }
+    
+    /**
+     * @brief Publish frames written into the last beginWrite() regions
+     * 
+     * @param frames Frames written, from the start of the first region
+     */
+    void commitWrite(size_t frames) {
+        const size_t writePos = m_writePos.load(std::memory_order_relaxed) + frames;
+        m_writePos.store(writePos, std::memory_order_release);
         
-        std::memcpy(m_buffer.data() + writeIdx, data, firstChunk);
-        if (secondChunk > 0) {
-            std::memcpy(m_buffer.data(), data + firstChunk, secondChunk);
+        const size_t fill = writePos - m_readPos.load(std::memory_order_acquire);
+        if (fill > m_highWatermark.load(std::memory_order_relaxed)) {
+            m_highWatermark.store(fill, std::memory_order_relaxed);
         }
+    }
+    
+    /**
+     * @brief Write frames to the buffer
+     * 
+     * Non-blocking: writes as much as possible, returns actual frames written.
+     * 
+     * @param data Source data pointer (interleaved)
+     * @param frames Number of frames to write
+     * @return Actual frames written (may be less than frames if buffer full)
+     */
+    size_t write(const Sample* data, size_t frames) {
+        if (frames == 0 || !data) return 0;
         
-        // Publish write
-        m_writePos.store(writePos + toWrite, std::memory_order_release);
+        auto space = beginWrite(frames);
+        if (space.empty()) return 0;
         
-        return toWrite;
+        std::memcpy(space.first.data(), data, space.first.size_bytes());
+        std::memcpy(space.second.data(), data + space.first.size(), space.second.size_bytes());
+        commitWrite(space.frames);
+        return space.frames;
     }
     
     /**
-     * @brief Write all data, blocking until space available
+     * @brief Write all frames, blocking until space available
      */
-    bool writeAll(const uint8_t* data, size_t size) {
+    bool writeAll(const Sample* data, size_t frames) {
         size_t written = 0;
-        while (written < size) {
-            size_t n = write(data + written, size - written);
+        while (written < frames) {
+            size_t n = write(data + written * m_channels, frames - written);
             if (n == 0) {
                 std::this_thread::yield();
             }
@@ -121,77 +182,83 @@ public:
     // ========== Consumer Interface ==========
     
     /**
-     * @brief Read data from the buffer
+     * @brief Get buffered frames to read in place
      * 
-     * Non-blocking: reads as much as available, returns actual bytes read.
+     * The frames stay in the buffer until commitRead().
      * 
-     * @param dest Destination buffer
-     * @param size Maximum bytes to read
-     * @return Actual bytes read (may be less than size if buffer empty)
+     * @param maxFrames Frames wanted
+     * @return Up to maxFrames of data (empty if none)
      */
-    size_t read(uint8_t* dest, size_t size) {
-        if (size == 0 || !dest) return 0;
-        
+    [[nodiscard]] RingRegions<const Sample> beginRead(size_t maxFrames) {
         const size_t readPos = m_readPos.load(std::memory_order_relaxed);
         const size_t writePos = m_writePos.load(std::memory_order_acquire);
         
-        // Calculate available data
         const size_t available = writePos - readPos;
-        const size_t toRead = std::min(size, available);
-        
-        if (toRead == 0) return 0;
-        
-        // Read in one or two chunks (handle wrap-around)
-        const size_t readIdx = readPos & m_mask;
-        const size_t firstChunk = std::min(toRead, capacity() - readIdx);
-        const size_t secondChunk = toRead - firstChunk;
-        
-        std::memcpy(dest, m_buffer.data() + readIdx, firstChunk);
-        if (secondChunk > 0) {
-            std::memcpy(dest + firstChunk, m_buffer.data(), secondChunk);
+        if (available < m_lowWatermark.load(std::memory_order_relaxed)) {
+            m_lowWatermark.store(available, std::memory_order_relaxed);
+        }
+        if (available < maxFrames) {
+            m_underruns.store(m_underruns.load(std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
         }
+        return regions<const Sample>(readPos, std::min(maxFrames, available));
+    }
+    
+    /**
+     * @brief Release frames read from the last beginRead() regions
+     * 
+     * @param frames Frames consumed, from the start of the first region
+     */
+    void commitRead(size_t frames) {
+        const size_t readPos = m_readPos.load(std::memory_order_relaxed);
+        m_readPos.store(readPos + frames, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Read frames from the buffer
+     * 
+     * Non-blocking: reads as much as available, returns actual frames read.
+     * 
+     * @param dest Destination buffer (interleaved)
+     * @param frames Maximum frames to read
+     * @return Actual frames read (may be less than frames if buffer empty)
+     */
+    size_t read(Sample* dest, size_t frames) {
+        if (frames == 0 || !dest) return 0;
         
-        // Publish read
-        m_readPos.store(readPos + toRead, std::memory_order_release);
+        auto data = beginRead(frames);
+        if (data.empty()) return 0;
         
-        return toRead;
+        std::memcpy(dest, data.first.data(), data.first.size_bytes());
+        std::memcpy(dest + data.first.size(), data.second.data(), data.second.size_bytes());
+        commitRead(data.frames);
+        return data.frames;
     }
     
     /**
      * @brief Peek at data without consuming
      */
-    [[nodiscard]] size_t peek(uint8_t* dest, size_t size) const {
-        if (size == 0 || !dest) return 0;
+    [[nodiscard]] size_t peek(Sample* dest, size_t frames) const {
+        if (frames == 0 || !dest) return 0;
         
         const size_t readPos = m_readPos.load(std::memory_order_relaxed);
         const size_t writePos = m_writePos.load(std::memory_order_acquire);
         
-        const size_t available = writePos - readPos;
-        const size_t toPeek = std::min(size, available);
-        
-        if (toPeek == 0) return 0;
-        
-        const size_t readIdx = readPos & m_mask;
-        const size_t firstChunk = std::min(toPeek, capacity() - readIdx);
-        const size_t secondChunk = toPeek - firstChunk;
-        
-        std::memcpy(dest, m_buffer.data() + readIdx, firstChunk);
-        if (secondChunk > 0) {
-            std::memcpy(dest + firstChunk, m_buffer.data(), secondChunk);
-        }
-        
-        return toPeek;
+        auto data = regions<const Sample>(readPos, std::min(frames, writePos - readPos));
+        std::memcpy(dest, data.first.data(), data.first.size_bytes());
+        std::memcpy(dest + data.first.size(), data.second.data(), data.second.size_bytes());
+        return data.frames;
     }
     
     /**
      * @brief Skip (consume) data without reading
      */
-    size_t skip(size_t size) {
+    size_t skip(size_t frames) {
         const size_t readPos = m_readPos.load(std::memory_order_relaxed);
         const size_t writePos = m_writePos.load(std::memory_order_acquire);
         
         const size_t available = writePos - readPos;
-        const size_t toSkip = std::min(size, available);
+        const size_t toSkip = std::min(frames, available);
         
         if (toSkip > 0) {
             m_readPos.store(readPos + toSkip, std::memory_order_release);
@@ -220,12 +287,16 @@ public:
     }
     
     /**
-     * @brief Get buffer capacity
+     * @brief Get buffer capacity (frames)
      */
     [[nodiscard]] size_t capacity() const {
         return m_mask + 1;
     }
     
+    [[nodiscard]] size_t channels() const {
+        return m_channels;
+    }
+    
     /**
      * @brief Check if buffer is empty
      */
@@ -247,7 +318,32 @@ public:
         return static_cast<float>(availableRead()) / static_cast<float>(capacity());
     }
     
-private:
+    // ========== Statistics ==========
+    
+    /**
+     * @brief Fill level history since construction or resetStats()
+     */
+    [[nodiscard]] RingBufferStats stats() const {
+        RingBufferStats s;
+        s.lowWatermark = m_lowWatermark.load(std::memory_order_relaxed);
+        s.highWatermark = m_highWatermark.load(std::memory_order_relaxed);
+        s.underruns = m_underruns.load(std::memory_order_relaxed);
+        return s;
+    }
+    
+    /**
+     * @brief Start a new measurement (e.g. after a seek)
+     * 
+     * Call while neither side is running, or accept that a count
+     * racing with the reset may survive it.
+     */
+    void resetStats() {
+        m_lowWatermark.store(capacity(), std::memory_order_relaxed);
+        m_highWatermark.store(0, std::memory_order_relaxed);
+        m_underruns.store(0, std::memory_order_relaxed);
+    }
+
+protected:
     /**
      * @brief Round up to next power of 2
      */
@@ -263,17 +359,76 @@ private:
         return n + 1;
     }
     
+private:
+    /// Frames [pos, pos + frames) as one or two pieces (handle wrap-around)
+    template<typename T>
+    RingRegions<T> regions(size_t pos, size_t frames) const {
+        const size_t index = pos & m_mask;
+        const size_t firstFrames = std::min(frames, capacity() - index);
+        
+        auto* base = const_cast<Sample*>(m_buffer.data());
+        RingRegions<T> r;
+        r.first = std::span<T>(base + index * m_channels, firstFrames * m_channels);
+        r.second = std::span<T>(base, (frames - firstFrames) * m_channels);
+        r.frames = frames;
+        return r;
+    }
+    
+    /// Samples per frame
+    const size_t m_channels;
+    
     /// Bitmask for efficient modulo (capacity - 1)
     const size_t m_mask;
     
     /// Data buffer
-    std::vector<uint8_t> m_buffer;
+    std::vector<Sample> m_buffer;
     
     /// Write position (only modified by producer)
     alignas(64) std::atomic<size_t> m_writePos{0};
     
+    /// Producer statistics (only modified by producer)
+    std::atomic<size_t> m_highWatermark{0};
+    
     /// Read position (only modified by consumer)
     alignas(64) std::atomic<size_t> m_readPos{0};
+    
+    /// Consumer statistics (only modified by consumer)
+    std::atomic<size_t> m_lowWatermark;
+    std::atomic<uint64_t> m_underruns{0};
+};
+
+/// Interleaved float frames (e.g. mixer output)
+using FloatFrameRingBuffer = FrameRingBuffer<float>;
+
+/**
+ * @brief Lock-free single-producer single-consumer byte ring buffer
+ * 
+ * A FrameRingBuffer of one-byte frames: sizes are in bytes.
+ * 
+ * Thread safety:
+ * - write(): Single producer thread (audio decode/resample)
+ * - read(): Single consumer thread (SDL audio callback)
+ * - clear(): Can be called from producer when synchronized
+ * - availableRead/Write(): Safe from any thread
+ */
+class LockFreeRingBuffer : public FrameRingBuffer<uint8_t> {
+public:
+    /// Default capacity: 128KB (~680ms at 48kHz/stereo/16-bit)
+    static constexpr size_t kDefaultCapacity = 131072;
+    
+    /// Minimum capacity: 16KB
+    static constexpr size_t kMinCapacity = 16384;
+    
+    /// Maximum capacity: 1MB
+    static constexpr size_t kMaxCapacity = 1048576;
+    
+    /**
+     * @brief Construct ring buffer with given capacity
+     * @param capacity Buffer size in bytes (will be rounded to power of 2)
+     */
+    explicit LockFreeRingBuffer(size_t capacity = kDefaultCapacity)
+        : FrameRingBuffer(std::clamp(capacity, kMinCapacity, kMaxCapacity), 1)
+    {}
 };
 
 /**
@@ -0,0 +1,419 @@
+/**
+ * @file sharded_lru_cache.hpp
+ * @brief Concurrent cache with per-shard locks and CLOCK eviction
+ * 
+ * LRUCache must reorder its list on every get(), so every read takes
+ * the exclusive lock and concurrent readers queue behind each other.
+ * This cache is for lookups from many threads at once (thumbnails,
+ * metadata, nested frames):
+ * - Keys are spread over independently locked shards
+ * - Hits only set a reference bit under a shared lock (CLOCK), so
+ *   readers of one shard run in parallel
+ * - Capacity is a total weight (e.g. bytes), not an item count
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace phoenix {
+
+/**
+ * @brief Thread-safe, sharded cache with approximate LRU eviction
+ * 
+ * Each shard holds an equal part of the capacity and evicts with the
+ * CLOCK algorithm: a hand sweeps the shard's entries, clearing
+ * reference bits and evicting the first entry whose bit is already
+ * clear. Entries read since the hand last passed survive, which
+ * approximates LRU without touching shared state on a hit.
+ * 
+ * @tparam Key Key type (must be hashable)
+ * @tparam Value Value type (copied out by get())
+ * @tparam Hash Key hash
+ * 
+ * Usage:
+ * @code
+ *   // 256 MB of thumbnails, weighed by their size
+ *   ShardedLRUCache<UUID, std::shared_ptr<Image>> thumbnails(
+ *       256 * 1024 * 1024,
+ *       [](const UUID&, const std::shared_ptr<Image>& image) { return image->byteSize(); });
+ * 
+ *   thumbnails.put(id, image);
+ *   if (auto image = thumbnails.get(id)) {
+ *       // Use *image
+ *   }
+ * @endcode
+ * 
+ * Eviction is per shard, so the entry evicted is the least recently
+ * used of its shard, not of the whole cache. A value heavier than one
+ * shard's capacity is not cached. The eviction callback runs with the
+ * shard locked and must not call back into the cache.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedLRUCache {
+public:
+    /// Weight of an entry against the capacity (default: 1 per entry)
+    using Weigher = std::function<size_t(const Key&, const Value&)>;
+    using EvictionCallback = std::function<void(const Key&, Value&)>;
+    
+    static constexpr size_t kMaxShards = 16;
+    static constexpr size_t kMinShardCapacity = 8;  ///< Below this, fewer shards
+    
+    /**
+     * @brief Construct cache with a total weight capacity
+     * 
+     * @param capacity Maximum total weight
+     * @param weigher Weight of an entry (nullptr: every entry weighs 1)
+     * @param onEvict Optional callback when items are evicted or removed
+     * @param shardCount Number of shards, rounded down to a power of two
+     *                   (0: up to kMaxShards, keeping kMinShardCapacity each)
+     */
+    explicit ShardedLRUCache(size_t capacity, Weigher weigher = nullptr,
+                             EvictionCallback onEvict = nullptr, size_t shardCount = 0)
+        : m_weigher(std::move(weigher))
+        , m_onEvict(std::move(onEvict))
+    {
+        if (shardCount == 0) {
+            shardCount = std::min(kMaxShards, std::max<size_t>(1, capacity / kMinShardCapacity));
+        }
+        m_shardCount = std::bit_floor(shardCount);
+        m_shards = std::make_unique<Shard[]>(m_shardCount);
+        setShardCapacities(capacity);
+    }
+    
+    // Non-copyable, non-movable (shards hold mutexes)
+    ShardedLRUCache(const ShardedLRUCache&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+    ShardedLRUCache(ShardedLRUCache&&) = delete;
+    ShardedLRUCache& operator=(ShardedLRUCache&&) = delete;
+    
+    ~ShardedLRUCache() = default;
+    
+    // ========== Lookup ==========
+    
+    /**
+     * @brief Get a copy of a value and mark it recently used
+     * 
+     * Takes only the shard's shared lock.
+     * 
+     * @return The value, or nullopt if not cached
+     */
+    [[nodiscard]] std::optional<Value> get(const Key& key) {
+        Shard& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            shard.misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        
+        // Skip the store when already set: repeated hits stay read-only
+        Entry& entry = *it->second;
+        if (!entry.referenced.load(std::memory_order_relaxed)) {
+            entry.referenced.store(true, std::memory_order_relaxed);
+        }
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        return entry.value;
+    }
+    
+    /**
+     * @brief Check if a key is cached
+     * 
+     * Does not mark it recently used.
+     */
+    [[nodiscard]] bool contains(const Key& key) const {
+        const Shard& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.find(key) != shard.map.end();
+    }
+    
+    // ========== Modification ==========
+    
+    /**
+     * @brief Put a value into the cache
+     * 
+     * Replaces an existing value for the key. Evicts entries of the
+     * key's shard until the value fits.
+     * 
+     * @return false if the value is heavier than a shard's capacity
+     *         (it is not cached, and any old value is removed)
+     */
+    bool put(const Key& key, Value value) {
+        size_t weight = m_weigher ? m_weigher(key, value) : 1;
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        
+        auto it = shard.map.find(key);
+        if (it != shard.map.end()) {
+            shard.weight -= it->second->weight;
+            unlink(shard, it);
+        }
+        if (weight > shard.capacity) return false;
+        
+        while (shard.weight + weight > shard.capacity) {
+            evictOne(shard);
+        }
+        
+        // Behind the hand: the last entry it reaches
+        auto entry = shard.ring.emplace(shard.hand, key, std::move(value), weight);
+        if (shard.ring.size() == 1) shard.hand = entry;
+        shard.map.emplace(key, entry);
+        shard.weight += weight;
+        return true;
+    }
+    
+    /**
+     * @brief Put a value using emplace semantics
+     */
+    template<typename... Args>
+    bool emplace(const Key& key, Args&&... args) {
+        return put(key, Value(std::forward<Args>(args)...));
+    }
+    
+    /**
+     * @brief Remove a specific key from the cache
+     * 
+     * @return true if the key was found and removed
+     */
+    bool remove(const Key& key) {
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) return false;
+        
+        if (m_onEvict) m_onEvict(it->second->key, it->second->value);
+        shard.weight -= it->second->weight;
+        unlink(shard, it);
+        return true;
+    }
+    
+    /**
+     * @brief Clear all entries from the cache
+     */
+    void clear() {
+        for (size_t i = 0; i < m_shardCount; ++i) {
+            Shard& shard = m_shards[i];
+            std::unique_lock lock(shard.mutex);
+            
+            if (m_onEvict) {
+                for (auto& entry : shard.ring) m_onEvict(entry.key, entry.value);
+            }
+            shard.map.clear();
+            shard.ring.clear();
+            shard.hand = shard.ring.end();
+            shard.weight = 0;
+        }
+    }
+    
+    /**
+     * @brief Change the total capacity
+     * 
+     * The shard count stays; if the new capacity is smaller, entries
+     * are evicted.
+     */
+    void resize(size_t capacity) {
+        setShardCapacities(capacity);
+        for (size_t i = 0; i < m_shardCount; ++i) {
+            Shard& shard = m_shards[i];
+            std::unique_lock lock(shard.mutex);
+            while (shard.weight > shard.capacity) {
+                evictOne(shard);
+            }
+        }
+    }
+    
+    // ========== Statistics ==========
+    
+    struct Stats {
+        size_t size = 0;        ///< Entries
+        size_t weight = 0;      ///< Total weight of the entries
+        size_t capacity = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        
+        [[nodiscard]] double hitRate() const {
+            uint64_t total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+    
+    /**
+     * @brief Sum of all shards (each read under its own lock)
+     */
+    [[nodiscard]] Stats stats() const {
+        Stats s;
+        for (size_t i = 0; i < m_shardCount; ++i) {
+            const Shard& shard = m_shards[i];
+            std::shared_lock lock(shard.mutex);
+            s.size += shard.map.size();
+            s.weight += shard.weight;
+            s.capacity += shard.capacity;
+            s.hits += shard.hits.load(std::memory_order_relaxed);
+            s.misses += shard.misses.load(std::memory_order_relaxed);
+            s.evictions += shard.evictions.load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+    
+    [[nodiscard]] size_t size() const { return stats().size; }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] size_t weight() const { return stats().weight; }
+    [[nodiscard]] size_t capacity() const { return m_capacity.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_t shardCount() const { return m_shardCount; }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t weight;
+        std::atomic<bool> referenced{false};    ///< Read since the hand passed
+        
+        Entry(const Key& k, Value v, size_t w)
+            : key(k), value(std::move(v)), weight(w) {}
+    };
+    
+    using Ring = std::list<Entry>;
+    using Map = std::unordered_map<Key, typename Ring::iterator, Hash>;
+    
+    // One cache line each: shards do not share lock state
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        Ring ring;                                  // CLOCK order
+        typename Ring::iterator hand = ring.end();  // Next entry to examine
+        Map map;
+        size_t weight = 0;
+        size_t capacity = 0;
+        
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> evictions{0};
+    };
+    
+    /// Spread the hash first: std::hash of integers is the identity
+    size_t shardIndex(const Key& key) const {
+        uint64_t h = static_cast<uint64_t>(Hash{}(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h) & (m_shardCount - 1);
+    }
+    
+    Shard& shardFor(const Key& key) { return m_shards[shardIndex(key)]; }
+    const Shard& shardFor(const Key& key) const { return m_shards[shardIndex(key)]; }
+    
+    void setShardCapacities(size_t capacity) {
+        m_capacity.store(capacity, std::memory_order_relaxed);
+        for (size_t i = 0; i < m_shardCount; ++i) {
+            // The remainder goes to the first shards
+            size_t share = capacity / m_shardCount + (i < capacity % m_shardCount ? 1 : 0);
+            std::unique_lock lock(m_shards[i].mutex);
+            m_shards[i].capacity = share;
+        }
+    }
+    
+    /// Erase an entry, keeping the hand valid (shard locked exclusively)
+    void unlink(Shard& shard, typename Map::iterator it) {
+        auto entry = it->second;
+        if (shard.hand == entry) shard.hand = std::next(entry);
+        shard.ring.erase(entry);
+        shard.map.erase(it);
+        if (shard.hand == shard.ring.end()) shard.hand = shard.ring.begin();
+    }
+    
+    /// Advance the hand to an unreferenced entry and evict it
+    void evictOne(Shard& shard) {
+        if (shard.ring.empty()) return;
+        
+        // Terminates within two sweeps: the first clears every bit
+        for (;;) {
+            if (shard.hand == shard.ring.end()) shard.hand = shard.ring.begin();
+            Entry& entry = *shard.hand;
+            if (!entry.referenced.load(std::memory_order_relaxed)) break;
+            entry.referenced.store(false, std::memory_order_relaxed);
+            ++shard.hand;
+        }
+        
+        Entry& victim = *shard.hand;
+        if (m_onEvict) m_onEvict(victim.key, victim.value);
+        shard.weight -= victim.weight;
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        unlink(shard, shard.map.find(victim.key));
+    }
+    
+    size_t m_shardCount = 1;
+    std::unique_ptr<Shard[]> m_shards;
+    std::atomic<size_t> m_capacity{0};
+    Weigher m_weigher;
+    EvictionCallback m_onEvict;
+};
+
+/**
+ * @brief ShardedLRUCache with shared_ptr values
+ * 
+ * Counterpart of SharedLRUCache: get() returns the cached pointer,
+ * which stays valid after eviction.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedSharedLRUCache {
+public:
+    using ValuePtr = std::shared_ptr<Value>;
+    using Weigher = std::function<size_t(const Key&, const Value&)>;
+    using EvictionCallback = std::function<void(const Key&, ValuePtr&)>;
+    
+    explicit ShardedSharedLRUCache(size_t capacity, Weigher weigher = nullptr,
+                                   EvictionCallback onEvict = nullptr, size_t shardCount = 0)
+        : m_cache(capacity, wrap(std::move(weigher)), std::move(onEvict), shardCount)
+    {}
+    
+    [[nodiscard]] ValuePtr get(const Key& key) {
+        return m_cache.get(key).value_or(nullptr);
+    }
+    
+    bool put(const Key& key, ValuePtr value) {
+        return value && m_cache.put(key, std::move(value));
+    }
+    
+    template<typename... Args>
+    ValuePtr emplace(const Key& key, Args&&... args) {
+        auto ptr = std::make_shared<Value>(std::forward<Args>(args)...);
+        m_cache.put(key, ptr);
+        return ptr;
+    }
+    
+    [[nodiscard]] bool contains(const Key& key) const { return m_cache.contains(key); }
+    bool remove(const Key& key) { return m_cache.remove(key); }
+    void clear() { m_cache.clear(); }
+    void resize(size_t capacity) { m_cache.resize(capacity); }
+    
+    [[nodiscard]] auto stats() const { return m_cache.stats(); }
+    [[nodiscard]] size_t size() const { return m_cache.size(); }
+    [[nodiscard]] size_t weight() const { return m_cache.weight(); }
+    [[nodiscard]] size_t capacity() const { return m_cache.capacity(); }
+
+private:
+    using Inner = ShardedLRUCache<Key, ValuePtr, Hash>;
+    
+    static typename Inner::Weigher wrap(Weigher weigher) {
+        if (!weigher) return nullptr;
+        return [weigher = std::move(weigher)](const Key& key, const ValuePtr& value) {
+            return weigher(key, *value);
+        };
+    }
+    
+    Inner m_cache;
+};
+
+} // namespace phoenix
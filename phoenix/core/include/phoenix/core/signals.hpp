@@ -8,7 +8,8 @@
  * Features:
  * - Type-safe callbacks with variadic arguments
  * - Automatic disconnection via Connection RAII
- * - Thread-safe signal emission
+ * - Thread-safe signal emission without locks or copies
+ * - Queued delivery to another thread, optionally coalesced
  * - No external dependencies
  */
 
@@ -16,8 +17,13 @@
 
 #include <functional>
 #include <vector>
+#include <deque>
+#include <iterator>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 #include <algorithm>
 #include <atomic>
 
@@ -125,6 +131,69 @@ private:
     Connection m_connection;
 };
 
+/**
+ * @brief Runs tasks on a particular thread
+ * 
+ * Target of queued connections. Implementations hand posted tasks
+ * to the thread that owns the receiver (an event loop, a worker's
+ * queue). post() may be called from any thread.
+ */
+class Dispatcher {
+public:
+    virtual ~Dispatcher() = default;
+    
+    /// Schedule a task; must be thread-safe
+    virtual void post(std::function<void()> task) = 0;
+};
+
+/**
+ * @brief Dispatcher backed by a queue drained by its owner
+ * 
+ * For threads without an event loop: the owning thread calls
+ * drain() from its own loop to run everything posted so far.
+ */
+class EventQueue : public Dispatcher {
+public:
+    void post(std::function<void()> task) override {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    
+    /**
+     * @brief Run all pending tasks on the calling thread
+     * 
+     * @return Number of tasks run
+     */
+    size_t drain() {
+        std::deque<std::function<void()>> tasks;
+        {
+            std::lock_guard lock(m_mutex);
+            tasks.swap(m_tasks);
+        }
+        for (auto& task : tasks) {
+            task();
+        }
+        return tasks.size();
+    }
+    
+    [[nodiscard]] size_t pendingCount() const {
+        std::lock_guard lock(m_mutex);
+        return m_tasks.size();
+    }
+    
+private:
+    mutable std::mutex m_mutex;
+    std::deque<std::function<void()>> m_tasks;
+};
+
+/**
+ * @brief How a queued connection delivers emissions
+ */
+enum class QueuedDelivery {
+    Every,      // Every emission is delivered, in order
+    Latest,     // Coalesced: at most one delivery pending, with the newest values
+};
+
 /**
  * @brief Type-safe signal for event emission
  * 
@@ -142,6 +211,13 @@ private:
  *   
  *   conn.disconnect();  // Or let ScopedConnection handle it
  * @endcode
+ * 
+ * The slot list is published read-copy-update style: connect and
+ * disconnect build a new list under a mutex, fire() only loads the
+ * current list. Emission never takes the writer mutex and never
+ * copies slots, so it is cheap enough for per-frame signals. A slot
+ * disconnected during an emission on another thread may still be
+ * called by that emission.
  */
 template<typename... Args>
 class Signal {
@@ -171,11 +247,80 @@ public:
         std::lock_guard lock(m_mutex);
         
         uint64_t id = m_nextId++;
-        m_slots.push_back({id, std::move(slot), false});
+        auto list = std::make_shared<SlotList>();
+        if (auto current = m_slots.load(std::memory_order_relaxed)) {
+            list->reserve(current->size() + 1);
+            *list = *current;
+        }
+        list->push_back({id, std::make_shared<const SlotType>(std::move(slot))});
+        m_slots.store(std::move(list), std::memory_order_release);
         
         return Connection(id, m_disconnector);
     }
     
+    /**
+     * @brief Connect a slot that runs on another thread
+     * 
+     * Each emission is handed to @p dispatcher instead of running
+     * on the emitting thread. With QueuedDelivery::Latest, emissions
+     * that arrive while a delivery is still pending only replace its
+     * values, so a per-frame signal costs the receiver at most one
+     * call per turn of its event loop.
+     * 
+     * Deliveries already posted when the connection is dropped are
+     * skipped once the slot has been released.
+     * 
+     * @param dispatcher Target thread's dispatcher
+     * @param slot Callable to invoke on the target thread
+     * @param delivery Deliver every emission or only the latest
+     */
+    [[nodiscard]] Connection connectQueued(
+        std::shared_ptr<Dispatcher> dispatcher,
+        SlotType slot,
+        QueuedDelivery delivery = QueuedDelivery::Latest)
+    {
+        auto state = std::make_shared<QueuedState>();
+        state->slot = std::move(slot);
+        state->dispatcher = std::move(dispatcher);
+        
+        if (delivery == QueuedDelivery::Every) {
+            return connect([state](Args... args) {
+                std::weak_ptr<QueuedState> weak = state;
+                state->dispatcher->post(
+                    [weak, values = std::make_tuple(std::decay_t<Args>(args)...)]() mutable {
+                        if (auto target = weak.lock()) {
+                            std::apply(target->slot, std::move(values));
+                        }
+                    });
+            });
+        }
+        
+        return connect([state](Args... args) {
+            {
+                std::lock_guard lock(state->mutex);
+                state->latest.emplace(std::decay_t<Args>(args)...);
+                if (state->pending) return;
+                state->pending = true;
+            }
+            
+            std::weak_ptr<QueuedState> weak = state;
+            state->dispatcher->post([weak]() {
+                auto target = weak.lock();
+                if (!target) return;
+                
+                std::optional<Values> values;
+                {
+                    std::lock_guard lock(target->mutex);
+                    values.swap(target->latest);
+                    target->pending = false;
+                }
+                if (values) {
+                    std::apply(target->slot, std::move(*values));
+                }
+            });
+        });
+    }
+    
     /**
      * @brief Connect and return scoped connection
      */
@@ -186,24 +331,18 @@ public:
     /**
      * @brief Fire the signal, invoking all connected slots
      * 
-     * Thread-safe: slots are copied before invocation to prevent
-     * issues if a slot modifies connections during emission.
+     * Thread-safe: the current slot list is pinned for the duration
+     * of the emission, so slots may connect or disconnect (even
+     * themselves) while it runs.
      * 
      * Note: Named 'fire' instead of 'emit' to avoid conflict with Qt's emit keyword.
      */
     void fire(Args... args) {
-        // Copy slots under lock
-        std::vector<Slot> slotsCopy;
-        {
-            std::lock_guard lock(m_mutex);
-            slotsCopy = m_slots;
-        }
+        auto list = m_slots.load(std::memory_order_acquire);
+        if (!list) return;
         
-        // Invoke outside lock
-        for (auto& slot : slotsCopy) {
-            if (!slot.blocked && slot.func) {
-                slot.func(args...);
-            }
+        for (const auto& slot : *list) {
+            (*slot.func)(args...);
         }
     }
     
@@ -219,15 +358,15 @@ public:
      */
     void disconnectAll() {
         std::lock_guard lock(m_mutex);
-        m_slots.clear();
+        m_slots.store(nullptr, std::memory_order_release);
     }
     
     /**
      * @brief Get number of connected slots
      */
     [[nodiscard]] size_t slotCount() const {
-        std::lock_guard lock(m_mutex);
-        return m_slots.size();
+        auto list = m_slots.load(std::memory_order_acquire);
+        return list ? list->size() : 0;
     }
     
     /**
@@ -240,8 +379,19 @@ public:
 private:
     struct Slot {
         uint64_t id;
-        SlotType func;
-        bool blocked;
+        std::shared_ptr<const SlotType> func;   // Shared between list versions
+    };
+    
+    using SlotList = std::vector<Slot>;
+    using Values = std::tuple<std::decay_t<Args>...>;
+    
+    /// Receiver side of a queued connection
+    struct QueuedState {
+        SlotType slot;
+        std::shared_ptr<Dispatcher> dispatcher;
+        std::mutex mutex;
+        std::optional<Values> latest;   // Latest mode: newest undelivered values
+        bool pending = false;           // Latest mode: a delivery is posted
     };
     
     /// Disconnector implementation
@@ -259,15 +409,20 @@ private:
     
     void disconnectById(uint64_t id) {
         std::lock_guard lock(m_mutex);
-        m_slots.erase(
-            std::remove_if(m_slots.begin(), m_slots.end(),
-                [id](const Slot& s) { return s.id == id; }),
-            m_slots.end()
-        );
+        auto current = m_slots.load(std::memory_order_relaxed);
+        if (!current) return;
+        
+        auto list = std::make_shared<SlotList>();
+        list->reserve(current->size());
+        std::copy_if(current->begin(), current->end(), std::back_inserter(*list),
+            [id](const Slot& s) { return s.id != id; });
+        if (list->size() == current->size()) return;
+        
+        m_slots.store(list->empty() ? nullptr : std::move(list), std::memory_order_release);
     }
     
-    mutable std::mutex m_mutex;
-    std::vector<Slot> m_slots;
+    std::mutex m_mutex;                                     // Serializes writers only
+    std::atomic<std::shared_ptr<const SlotList>> m_slots;   // Published slot list
     std::shared_ptr<DisconnectorImpl> m_disconnector;
     std::atomic<uint64_t> m_nextId{1};
 };
@@ -4,24 +4,36 @@
  */
 
 #include <phoenix/core/logger.hpp>
+#include <phoenix/core/async_log_sink.hpp>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 namespace phoenix {
 
 static std::shared_ptr<spdlog::logger> s_logger;
+static std::shared_ptr<AsyncLogSink> s_asyncSink;
 
 void initLogging(const std::string& appName, spdlog::level::level_enum level) {
     auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     console_sink->set_level(level);
     
-    s_logger = std::make_shared<spdlog::logger>(appName, console_sink);
+    // Console writes happen on the sink's writer thread
+    if (s_asyncSink) s_asyncSink->stop();
+    s_asyncSink = std::make_shared<AsyncLogSink>(std::vector<spdlog::sink_ptr>{console_sink});
+    
+    s_logger = std::make_shared<spdlog::logger>(appName, s_asyncSink);
     s_logger->set_level(level);
     s_logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] %v");
     
     spdlog::set_default_logger(s_logger);
 }
 
-std::shared_ptr<spdlog::logger> getLogger() {
+void shutdownLogging() {
+    if (s_asyncSink) {
+        s_asyncSink->stop();
+    }
+}
+
+const std::shared_ptr<spdlog::logger>& getLogger() {
     if (!s_logger) {
         initLogging("phoenix");
     }
@@ -34,4 +46,8 @@ void setLogLevel(spdlog::level::level_enum level) {
     }
 }
 
+uint64_t droppedLogMessages() {
+    return s_asyncSink ? s_asyncSink->dropped() : 0;
+}
+
 } // namespace phoenix
@@ -12,10 +12,48 @@
 #include <phoenix/media/frame.hpp>
 #include <phoenix/model/sequence.hpp>
 #include <phoenix/engine/frame_cache.hpp>
+#include <phoenix/engine/render_plan.hpp>
 
+#include <phoenix/core/sharded_lru_cache.hpp>
+
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <functional>
+#include <unordered_map>
+
+namespace phoenix::engine {
+
+/**
+ * @brief Key of a cached nested-sequence frame
+ *
+ * The stamp covers the nested sequence's revision and those of any
+ * sequences nested inside it, so an edit anywhere below the nest
+ * produces new keys; stale frames simply age out.
+ */
+struct NestedFrameKey {
+    UUID sequenceId;        ///< Nested sequence
+    Timestamp time = 0;     ///< Time within the nested sequence
+    uint64_t stamp = 0;     ///< Content stamp (see Compositor::contentStamp)
+    
+    bool operator==(const NestedFrameKey& other) const {
+        return sequenceId == other.sequenceId && time == other.time && stamp == other.stamp;
+    }
+};
+
+} // namespace phoenix::engine
+
+// Hash specialization for NestedFrameKey
+template<>
+struct std::hash<phoenix::engine::NestedFrameKey> {
+    size_t operator()(const phoenix::engine::NestedFrameKey& key) const noexcept {
+        size_t h = std::hash<phoenix::UUID>{}(key.sequenceId);
+        h ^= std::hash<phoenix::Timestamp>{}(key.time) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<uint64_t>{}(key.stamp) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+};
 
 namespace phoenix::engine {
 
@@ -55,6 +93,30 @@ struct CompositeResult {
     Timestamp timestamp;
     bool hasVideo = false;
     bool hasAudio = false;
+    bool cancelled = false;   ///< Abandoned via ComposeToken; frame is null
+};
+
+/**
+ * @brief Lets the caller abandon a compose between layers
+ * 
+ * The compose was issued for @c generation; once @c current moves
+ * on (a newer request came in), remaining layers are not decoded.
+ */
+struct ComposeToken {
+    const std::atomic<uint64_t>* current = nullptr;
+    uint64_t generation = 0;
+    
+    [[nodiscard]] bool cancelled() const {
+        return current && current->load(std::memory_order_relaxed) != generation;
+    }
+};
+
+/**
+ * @brief How exact a composed frame must be
+ */
+enum class RenderQuality {
+    Full,     ///< Every layer at its exact source frame
+    Draft,    ///< Nearby or keyframe approximations will do (scrubbing)
 };
 
 /**
@@ -65,6 +127,7 @@ struct FrameRequest {
     UUID mediaItemId;
     Timestamp mediaTime;
     int trackIndex;
+    RenderQuality quality = RenderQuality::Full;
 };
 
 /**
@@ -74,6 +137,15 @@ using FrameDecoderCallback = std::function<
     std::shared_ptr<media::VideoFrame>(const FrameRequest&)
 >;
 
+/**
+ * @brief Resolves a nested clip's sequence ID
+ * 
+ * Called from the render thread the first time a nest is seen.
+ */
+using SequenceResolver = std::function<
+    std::shared_ptr<const model::Sequence>(const UUID&)
+>;
+
 /**
  * @brief Video compositor
  * 
@@ -81,6 +153,11 @@ using FrameDecoderCallback = std::function<
  * a sequence's timeline. Handles track stacking order,
  * blending, and basic transforms.
  * 
+ * Nested sequence clips are rendered by a child compositor and
+ * composited as a single layer. Child output is cached by the
+ * nested content's revision, so an unchanged nest costs one
+ * cache lookup per frame instead of re-compositing its tracks.
+ * 
  * Usage:
  * @code
  *   Compositor compositor(1920, 1080);
@@ -94,6 +171,12 @@ using FrameDecoderCallback = std::function<
  */
 class Compositor {
 public:
+    /// Nests deeper than this render as empty
+    static constexpr int kMaxNestingDepth = 16;
+    
+    /// Default number of cached nested-sequence frames
+    static constexpr size_t kDefaultNestedCacheFrames = 32;
+    
     /**
      * @brief Construct compositor with output dimensions
      */
@@ -101,13 +184,23 @@ public:
         : m_outputWidth(width)
         , m_outputHeight(height) {}
     
+    // Non-copyable (owns child compositors)
+    Compositor(const Compositor&) = delete;
+    Compositor& operator=(const Compositor&) = delete;
+    
     // ========== Configuration ==========
     
     /**
      * @brief Set the sequence to composite
+     * 
+     * Composition only reads the sequence's published snapshots, so
+     * compose() may run on a render thread while the UI edits.
      */
     void setSequence(const model::Sequence* sequence) {
         m_sequence = sequence;
+        
+        std::lock_guard lock(m_planMutex);
+        m_plan.reset();
     }
     
     /**
@@ -115,6 +208,17 @@ public:
      */
     void setFrameDecoder(FrameDecoderCallback decoder) {
         m_decoder = std::move(decoder);
+        resetNests();
+    }
+    
+    /**
+     * @brief Set the resolver for nested sequence clips
+     * 
+     * Without one, nested clips render as empty.
+     */
+    void setSequenceResolver(SequenceResolver resolver) {
+        m_sequenceResolver = std::move(resolver);
+        resetNests();
     }
     
     /**
@@ -123,6 +227,15 @@ public:
     void setOutputSize(int width, int height) {
         m_outputWidth = width;
         m_outputHeight = height;
+        resetNests();
+    }
+    
+    /**
+     * @brief Set how many nested-sequence frames to keep
+     */
+    void setNestedCacheSize(size_t frames) {
+        m_nestedCacheFrames = frames;
+        resetNests();
     }
     
     /**
@@ -137,111 +250,269 @@ public:
     /**
      * @brief Compose frame at given timeline position
      * 
+     * Reads the layer list from the render plan of the current
+     * revision, so setup costs a binary search plus O(layers) and
+     * allocates nothing besides the output frame.
+     * 
      * @param time Timeline position
+     * @param token Checked before each layer is decoded
+     * @param quality Passed to the frame decoder with each request
      * @return Composited frame result
      */
-    CompositeResult compose(Timestamp time) {
+    CompositeResult compose(Timestamp time, ComposeToken token = {},
+                            RenderQuality quality = RenderQuality::Full) {
         CompositeResult result;
         result.timestamp = time;
         
-        if (!m_sequence) {
+        // Pin one immutable snapshot for the whole frame
+        auto snapshot = m_sequence ? m_sequence->snapshot() : nullptr;
+        if (!snapshot) {
             result.frame = createBlankFrame();
             return result;
         }
         
-        // Collect layers from all tracks
-        std::vector<CompositeLayer> layers;
+        return composePlan(*renderPlan(std::move(snapshot)), time, token, quality);
+    }
+    
+    /**
+     * @brief Get list of clips visible at given time
+     */
+    std::vector<FrameRequest> getVisibleClips(Timestamp time) {
+        std::vector<FrameRequest> requests;
         
-        // Get clips at current time (bottom to top order)
-        const auto& tracks = m_sequence->videoTracks();
-        for (size_t i = 0; i < tracks.size(); ++i) {
-            const auto& track = tracks[i];
-            
-            // Skip hidden/muted tracks
-            if (track->hidden() || track->muted()) continue;
-            
-            // Find clip at current time
-            auto clip = track->getClipAt(time);
-            if (!clip) continue;
-            
-            // Skip disabled clips
-            if (clip->disabled()) continue;
-            
-            // Calculate source time using clip's mapToSource
-            Timestamp sourceTime = clip->mapToSource(time);
+        auto snapshot = m_sequence ? m_sequence->snapshot() : nullptr;
+        if (!snapshot) return requests;
+        
+        auto plan = renderPlan(std::move(snapshot));
+        const auto* segment = plan->segmentAt(time);
+        if (!segment) return requests;
+        
+        for (const auto& layer : plan->layers(*segment)) {
+            // Nests are rendered, not decoded
+            if (layer.clip->isNested()) continue;
             
-            // Request frame from decoder
-            if (m_decoder) {
-                FrameRequest request{
-                    clip->id(),
-                    clip->mediaItemId(),
-                    sourceTime,
-                    static_cast<int>(i)
-                };
+            requests.push_back({
+                layer.clip->id(),
+                layer.clip->mediaItemId(),
+                layer.clip->mapToSource(time),
+                layer.trackIndex
+            });
+        }
+        
+        return requests;
+    }
+    
+    /**
+     * @brief Render plan for a snapshot of this compositor's sequence
+     * 
+     * Compiled on the first frame of each revision, incrementally
+     * from the previous plan.
+     */
+    std::shared_ptr<const RenderPlan> renderPlan(RenderPlan::SnapshotPtr snapshot) {
+        std::lock_guard lock(m_planMutex);
+        if (m_plan && m_plan->snapshot() == snapshot) return m_plan;
+        
+        // A frame still holding an older snapshot gets a throwaway plan
+        if (m_plan && m_plan->snapshot()->id() == snapshot->id() &&
+            m_plan->revision() > snapshot->revision()) {
+            return RenderPlan::build(std::move(snapshot));
+        }
+        
+        m_plan = RenderPlan::build(std::move(snapshot), m_plan.get());
+        return m_plan;
+    }
+    
+    // ========== Accessors ==========
+    
+    [[nodiscard]] int outputWidth() const { return m_outputWidth; }
+    [[nodiscard]] int outputHeight() const { return m_outputHeight; }
+    
+    /// Number of cached nested-sequence frames
+    [[nodiscard]] size_t nestedCacheSize() const { return m_nestedCache.size(); }
+    
+    /**
+     * @brief Drop cached nested-sequence frames at every level
+     * 
+     * Revisions do not cover source media, so call this when media
+     * changes on disk.
+     */
+    void clearNestedCache() {
+        std::lock_guard lock(m_nestMutex);
+        for (auto& [id, nest] : m_nests) {
+            nest.compositor->clearNestedCache();
+        }
+        m_nestedCache.clear();
+    }
+    
+private:
+    /// Child compositor of one nested sequence
+    struct Nest {
+        std::shared_ptr<const model::Sequence> sequence;  // Keeps it alive
+        std::unique_ptr<Compositor> compositor;
+    };
+    
+    /**
+     * @brief Compose the layers a plan schedules at a time
+     * 
+     * Layers are blended as they arrive; a lone opaque layer is
+     * passed through without a canvas.
+     */
+    CompositeResult composePlan(const RenderPlan& plan, Timestamp time,
+                                ComposeToken token = {},
+                                RenderQuality quality = RenderQuality::Full) {
+        CompositeResult result;
+        result.timestamp = time;
+        
+        std::shared_ptr<media::VideoFrame> canvas;
+        CompositeLayer first;   // Held until a second layer needs a canvas
+        
+        if (const auto* segment = plan.segmentAt(time)) {
+            for (const auto& planned : plan.layers(*segment)) {
+                if (token.cancelled()) {
+                    result.cancelled = true;
+                    return result;
+                }
                 
-                auto frame = m_decoder(request);
-                if (frame) {
-                    CompositeLayer layer;
-                    layer.frame = frame;
-                    layer.opacity = clip->opacity();
-                    // TODO: Get blend mode and transform from clip
-                    
-                    layers.push_back(std::move(layer));
-                    result.hasVideo = true;
+                const auto& clip = *planned.clip;
+                Timestamp sourceTime = clip.mapToSource(time);
+                
+                std::shared_ptr<media::VideoFrame> frame;
+                if (clip.isNested()) {
+                    // A whole nested sequence arrives as one layer
+                    frame = composeNested(clip.sequenceId(), sourceTime, token, quality);
+                } else if (m_decoder) {
+                    frame = m_decoder({clip.id(), clip.mediaItemId(), sourceTime,
+                                       planned.trackIndex, quality});
                 }
+                if (!frame) continue;
+                result.hasVideo = true;
+                
+                // TODO: Get blend mode and transform from clip
+                if (!first.frame) {
+                    first.frame = std::move(frame);
+                    first.opacity = clip.opacity();
+                    continue;
+                }
+                if (!canvas) {
+                    canvas = createBlankFrame();
+                    if (!canvas) break;
+                    blendLayer(*canvas, *first.frame, first.blendMode, first.opacity);
+                }
+                blendLayer(*canvas, *frame, BlendMode::Normal, clip.opacity());
             }
         }
         
-        // Composite layers
-        if (layers.empty()) {
-            result.frame = createBlankFrame();
-        } else if (layers.size() == 1 && 
-                   layers[0].opacity >= 1.0f &&
-                   layers[0].blendMode == BlendMode::Normal) {
+        // A nest may have given up on its last layers
+        if (token.cancelled()) {
+            result.cancelled = true;
+            return result;
+        }
+        
+        if (canvas) {
+            result.frame = std::move(canvas);
+        } else if (first.frame && first.opacity >= 1.0f &&
+                   first.blendMode == BlendMode::Normal) {
             // Single layer, no processing needed
-            result.frame = layers[0].frame;
+            result.frame = std::move(first.frame);
         } else {
-            result.frame = compositeLayers(layers);
+            result.frame = createBlankFrame();
+            if (result.frame && first.frame) {
+                blendLayer(*result.frame, *first.frame, first.blendMode, first.opacity);
+            }
         }
         
         return result;
     }
     
     /**
-     * @brief Get list of clips visible at given time
+     * @brief Content stamp of a plan at a time
+     * 
+     * Combines the plan's revision with the stamps of the nests
+     * scheduled at @p time. Equal stamps mean equal output.
      */
-    std::vector<FrameRequest> getVisibleClips(Timestamp time) const {
-        std::vector<FrameRequest> requests;
+    uint64_t contentStamp(const RenderPlan& plan, Timestamp time) {
+        uint64_t stamp = plan.revision();
+        const auto* segment = plan.segmentAt(time);
+        if (!segment || !segment->hasNests) return stamp;
         
-        if (!m_sequence) return requests;
-        
-        const auto& tracks = m_sequence->videoTracks();
-        for (size_t i = 0; i < tracks.size(); ++i) {
-            const auto& track = tracks[i];
-            if (track->hidden() || track->muted()) continue;
-            
-            auto clip = track->getClipAt(time);
-            if (!clip || clip->disabled()) continue;
+        for (const auto& layer : plan.layers(*segment)) {
+            if (!layer.clip->isNested()) continue;
             
-            Timestamp sourceTime = clip->mapToSource(time);
-            
-            requests.push_back({
-                clip->id(),
-                clip->mediaItemId(),
-                sourceTime,
-                static_cast<int>(i)
-            });
+            uint64_t nested = 0;
+            if (auto* child = nestedCompositor(layer.clip->sequenceId())) {
+                if (auto childSnapshot = child->m_sequence->snapshot()) {
+                    nested = child->contentStamp(*child->renderPlan(std::move(childSnapshot)),
+                                                 layer.clip->mapToSource(time));
+                }
+            }
+            stamp ^= nested + 0x9e3779b97f4a7c15ULL + (stamp << 6) + (stamp >> 2);
         }
+        return stamp;
+    }
+    
+    /**
+     * @brief Render a nested sequence, from cache when unchanged
+     *  
+     * Draft output is not cached: it would stand in for the exact frame.
+     */
+    std::shared_ptr<media::VideoFrame> composeNested(const UUID& sequenceId, Timestamp time,
+                                                     ComposeToken token = {},
+                                                     RenderQuality quality = RenderQuality::Full) {
+        auto* child = nestedCompositor(sequenceId);
+        if (!child) return nullptr;
         
-        return requests;
+        // One plan for both the key and the render
+        auto snapshot = child->m_sequence->snapshot();
+        if (!snapshot) return nullptr;
+        auto plan = child->renderPlan(std::move(snapshot));
+        
+        NestedFrameKey key{sequenceId, time, child->contentStamp(*plan, time)};
+        if (auto frame = m_nestedCache.get(key)) return frame;
+        
+        // Nothing visible: no layer rather than a transparent one
+        auto result = child->composePlan(*plan, time, token, quality);
+        if (!result.hasVideo || !result.frame) return nullptr;
+        
+        if (quality == RenderQuality::Full) m_nestedCache.put(key, result.frame);
+        return result.frame;
     }
     
-    // ========== Accessors ==========
+    /**
+     * @brief Get or create the child compositor of a nested sequence
+     * 
+     * @return nullptr if unresolved or nested too deeply
+     */
+    Compositor* nestedCompositor(const UUID& sequenceId) {
+        if (m_depth >= kMaxNestingDepth || !m_sequenceResolver) return nullptr;
+        
+        std::lock_guard lock(m_nestMutex);
+        auto it = m_nests.find(sequenceId);
+        if (it == m_nests.end()) {
+            auto sequence = m_sequenceResolver(sequenceId);
+            if (!sequence) return nullptr;
+            
+            auto child = std::make_unique<Compositor>(m_outputWidth, m_outputHeight);
+            child->m_depth = m_depth + 1;
+            child->m_sequence = sequence.get();
+            child->m_decoder = m_decoder;
+            child->m_sequenceResolver = m_sequenceResolver;
+            child->m_bgColor = {0, 0, 0, 0};  // Layers below show through
+            child->m_nestedCacheFrames = m_nestedCacheFrames;
+            child->m_nestedCache.resize(m_nestedCacheFrames);
+            
+            it = m_nests.emplace(sequenceId, Nest{std::move(sequence), std::move(child)}).first;
+        }
+        return it->second.compositor.get();
+    }
     
-    [[nodiscard]] int outputWidth() const { return m_outputWidth; }
-    [[nodiscard]] int outputHeight() const { return m_outputHeight; }
+    /// Drop child compositors and their output (configuration changed)
+    void resetNests() {
+        std::lock_guard lock(m_nestMutex);
+        m_nests.clear();
+        m_nestedCache.clear();
+        m_nestedCache.resize(m_nestedCacheFrames);
+    }
     
-private:
     /**
      * @brief Create blank (background color) frame
      */
@@ -268,24 +539,6 @@ private:
         return frame;
     }
     
-    /**
-     * @brief Composite multiple layers into single frame
-     */
-    std::shared_ptr<media::VideoFrame> compositeLayers(
-            const std::vector<CompositeLayer>& layers) {
-        // Start with blank canvas
-        auto result = createBlankFrame();
-        
-        // Composite each layer (bottom to top)
-        for (const auto& layer : layers) {
-            if (!layer.frame) continue;
-            
-            blendLayer(*result, *layer.frame, layer.blendMode, layer.opacity);
-        }
-        
-        return result;
-    }
-    
     /**
      * @brief Blend source layer onto destination
      */
@@ -426,6 +679,18 @@ private:
 private:
     const model::Sequence* m_sequence = nullptr;
     FrameDecoderCallback m_decoder;
+    SequenceResolver m_sequenceResolver;
+    
+    // Layer schedule of the latest revision
+    std::mutex m_planMutex;
+    std::shared_ptr<const RenderPlan> m_plan;
+    
+    // Nested sequences
+    int m_depth = 0;                    // 0 for the top-level compositor
+    std::mutex m_nestMutex;
+    std::unordered_map<UUID, Nest> m_nests;
+    size_t m_nestedCacheFrames = kDefaultNestedCacheFrames;
+    ShardedSharedLRUCache<NestedFrameKey, media::VideoFrame> m_nestedCache{kDefaultNestedCacheFrames};
     
     int m_outputWidth;
     int m_outputHeight;
@@ -2,33 +2,41 @@
  * @file frame_cache.hpp
  * @brief Frame caching system for decoded video frames
  * 
- * Provides an LRU cache for decoded video frames with
- * timeline-aware lookup and prefetching support.
+ * Provides an LRU cache for decoded video frames, keyed by media
+ * item and source frame index, with prefetching support.
  */
 
 #pragma once
 
 #include <phoenix/core/types.hpp>
-#include <phoenix/core/lru_cache.hpp>
+#include <phoenix/core/uuid.hpp>
 #include <phoenix/media/frame.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 namespace phoenix::engine {
 
 /**
  * @brief Key for frame cache lookup
+ * 
+ * Frames belong to the media, not to the clip showing them: every
+ * clip, speed and sequence that lands on the same source frame
+ * shares one entry.
  */
 struct FrameCacheKey {
-    UUID clipId;           ///< Which clip this frame belongs to
-    Timestamp mediaTime;   ///< Time within the media file
+    UUID mediaItemId;      ///< Which media item the frame comes from
+    int64_t frameIndex;    ///< Source frame number (see FrameCache::frameIndex)
     
     bool operator==(const FrameCacheKey& other) const {
-        return clipId == other.clipId && mediaTime == other.mediaTime;
+        return mediaItemId == other.mediaItemId && frameIndex == other.frameIndex;
     }
 };
 
@@ -38,8 +46,8 @@ struct FrameCacheKey {
 template<>
 struct std::hash<phoenix::engine::FrameCacheKey> {
     size_t operator()(const phoenix::engine::FrameCacheKey& key) const noexcept {
-        size_t h1 = std::hash<phoenix::UUID>{}(key.clipId);
-        size_t h2 = std::hash<phoenix::Timestamp>{}(key.mediaTime);
+        size_t h1 = std::hash<phoenix::UUID>{}(key.mediaItemId);
+        size_t h2 = std::hash<int64_t>{}(key.frameIndex);
         return h1 ^ (h2 << 1);
     }
 };
@@ -52,6 +60,7 @@ namespace phoenix::engine {
 struct CachedFrame {
     std::shared_ptr<media::VideoFrame> frame;
     uint64_t accessCount = 0;
+    bool speculative = false;   ///< Stored by putSpeculative() and not read since
     
     CachedFrame() = default;
     explicit CachedFrame(std::shared_ptr<media::VideoFrame> f)
@@ -67,6 +76,7 @@ struct FrameCacheStats {
     size_t currentSize = 0;
     size_t maxSize = 0;
     size_t memoryUsage = 0;
+    size_t speculativeSize = 0;   ///< Unread speculative frames (part of currentSize)
     
     [[nodiscard]] double hitRate() const {
         uint64_t total = hits + misses;
@@ -78,8 +88,14 @@ struct FrameCacheStats {
  * @brief Frame cache with LRU eviction
  * 
  * Caches decoded video frames for quick access during
- * playback and scrubbing. Uses timeline positions for
- * efficient lookup.
+ * playback and scrubbing. Callers quantise source times with
+ * frameIndex(), so clips cut from the same file, at any speed or
+ * sequence frame rate, hit the same entries.
+ * 
+ * Speculative frames (putSpeculative(), for prefetch hints) are kept
+ * apart from the LRU list until first read. They are evicted before
+ * any other frame, and never evict anything but older speculative
+ * frames, so guesses cannot push out the working set.
  * 
  * Thread-safe for concurrent access.
  */
@@ -93,21 +109,57 @@ public:
      */
     explicit FrameCache(size_t maxFrames = 100, size_t maxMemoryMB = 512)
         : m_maxFrames(maxFrames)
-        , m_maxMemory(maxMemoryMB * 1024 * 1024) {}
+        , m_maxMemory(maxMemoryMB * 1024 * 1024)
+        , m_maxSpeculative(std::max<size_t>(1, maxFrames / 4)) {}
+    
+    // ========== Frame Grid ==========
+    
+    /**
+     * @brief Quantise a media time to the source frame grid
+     * 
+     * Returns the frame shown at @p mediaTime. Times up to 1 µs
+     * before a frame boundary count as the next frame, absorbing
+     * the rounding of Clip::mapToSource() at non-1.0 speeds. With
+     * an unknown frame rate the grid is 1 µs.
+     * 
+     * @param mediaTime Time within the media (microseconds)
+     * @param frameRate Media frame rate
+     */
+    [[nodiscard]] static int64_t frameIndex(Timestamp mediaTime, Rational frameRate) {
+        if (frameRate.num <= 0 || frameRate.den <= 0) return mediaTime;
+        
+        int64_t scaled = (mediaTime + 1) * frameRate.num;
+        int64_t unit = static_cast<int64_t>(frameRate.den) * kTimeBaseUs;
+        int64_t index = scaled / unit;
+        return (scaled % unit != 0 && scaled < 0) ? index - 1 : index;
+    }
+    
+    /**
+     * @brief Media time at which a frame starts
+     * 
+     * Inverse of frameIndex(): frameIndex(frameTime(i, r), r) == i.
+     */
+    [[nodiscard]] static Timestamp frameTime(int64_t frameIndex, Rational frameRate) {
+        if (frameRate.num <= 0 || frameRate.den <= 0) return frameIndex;
+        
+        int64_t scaled = frameIndex * frameRate.den * kTimeBaseUs;
+        int64_t time = scaled / frameRate.num;
+        return (scaled % frameRate.num != 0 && scaled > 0) ? time + 1 : time;
+    }
     
     // ========== Cache Operations ==========
     
     /**
      * @brief Get a frame from cache
      * 
-     * @param clipId Clip identifier
-     * @param mediaTime Time within the media
+     * @param mediaItemId Media item identifier
+     * @param frameIndex Source frame number
      * @return Cached frame or nullptr if not found
      */
-    std::shared_ptr<media::VideoFrame> get(const UUID& clipId, Timestamp mediaTime) {
+    std::shared_ptr<media::VideoFrame> get(const UUID& mediaItemId, int64_t frameIndex) {
         std::lock_guard lock(m_mutex);
         
-        FrameCacheKey key{clipId, mediaTime};
+        FrameCacheKey key{mediaItemId, frameIndex};
         auto it = m_cache.find(key);
         if (it != m_cache.end()) {
             m_stats.hits++;
@@ -123,20 +175,50 @@ public:
         return nullptr;
     }
     
+    /**
+     * @brief Get the cached frame closest to a frame
+     * 
+     * For scrubbing, where a nearby frame now beats the exact one
+     * later. Earlier frames win ties. Does not touch the hit/miss
+     * statistics.
+     * 
+     * @param mediaItemId Media item identifier
+     * @param frameIndex Source frame number wanted
+     * @param maxDistance Farthest acceptable frame, in frames
+     * @return Cached frame or nullptr if none is close enough
+     */
+    std::shared_ptr<media::VideoFrame> getNearest(const UUID& mediaItemId, int64_t frameIndex,
+                                                  int64_t maxDistance) {
+        std::lock_guard lock(m_mutex);
+        
+        for (int64_t distance = 0; distance <= maxDistance; ++distance) {
+            for (int64_t index : {frameIndex - distance, frameIndex + distance}) {
+                FrameCacheKey key{mediaItemId, index};
+                auto it = m_cache.find(key);
+                if (it == m_cache.end()) continue;
+                
+                it->second.accessCount++;
+                moveToFront(key);
+                return it->second.frame;
+            }
+        }
+        return nullptr;
+    }
+    
     /**
      * @brief Store a frame in cache
      * 
-     * @param clipId Clip identifier
-     * @param mediaTime Time within the media
+     * @param mediaItemId Media item identifier
+     * @param frameIndex Source frame number
      * @param frame Frame to cache
      */
-    void put(const UUID& clipId, Timestamp mediaTime, 
+    void put(const UUID& mediaItemId, int64_t frameIndex,
              std::shared_ptr<media::VideoFrame> frame) {
         if (!frame) return;
         
         std::lock_guard lock(m_mutex);
         
-        FrameCacheKey key{clipId, mediaTime};
+        FrameCacheKey key{mediaItemId, frameIndex};
         
         // Check if already exists
         auto it = m_cache.find(key);
@@ -152,9 +234,8 @@ public:
         // Calculate frame size
         size_t frameSize = estimateFrameSize(*frame);
         
-        // Evict if necessary
-        while (m_cache.size() >= m_maxFrames || 
-               (m_maxMemory > 0 && m_memoryUsage + frameSize > m_maxMemory)) {
+        // Evict if necessary (speculative frames first)
+        while (isFull(frameSize)) {
             if (!evictOne()) break;
         }
         
@@ -164,60 +245,92 @@ public:
         m_lruMap[key] = m_lruList.begin();
         m_memoryUsage += frameSize;
         
-        m_stats.currentSize = m_cache.size();
-        m_stats.maxSize = std::max(m_stats.maxSize, m_cache.size());
-        m_stats.memoryUsage = m_memoryUsage;
+        updateSizeStats();
+    }
+    
+    /**
+     * @brief Store a frame nobody has asked for yet (prefetch hints)
+     * 
+     * The frame waits outside the LRU list, oldest evicted first,
+     * until it is read. At most a quarter of the frame capacity is
+     * speculative. Only older speculative frames make room for it.
+     * 
+     * @return false if it does not fit without evicting a frame in use
+     */
+    bool putSpeculative(const UUID& mediaItemId, int64_t frameIndex,
+                        std::shared_ptr<media::VideoFrame> frame) {
+        if (!frame) return false;
+        
+        std::lock_guard lock(m_mutex);
+        
+        FrameCacheKey key{mediaItemId, frameIndex};
+        if (m_cache.find(key) != m_cache.end()) return true;
+        
+        size_t frameSize = estimateFrameSize(*frame);
+        while (m_speculativeList.size() >= m_maxSpeculative || isFull(frameSize)) {
+            if (m_speculativeList.empty()) return false;
+            evictOne();
+        }
+        
+        CachedFrame entry{frame};
+        entry.speculative = true;
+        m_cache.emplace(key, std::move(entry));
+        m_speculativeList.push_back(key);
+        m_lruMap[key] = std::prev(m_speculativeList.end());
+        m_memoryUsage += frameSize;
+        
+        updateSizeStats();
+        return true;
     }
     
     /**
      * @brief Check if frame is in cache
      */
-    bool contains(const UUID& clipId, Timestamp mediaTime) const {
+    bool contains(const UUID& mediaItemId, int64_t frameIndex) const {
         std::lock_guard lock(m_mutex);
-        return m_cache.find({clipId, mediaTime}) != m_cache.end();
+        return m_cache.find({mediaItemId, frameIndex}) != m_cache.end();
     }
     
     /**
      * @brief Remove specific frame from cache
      */
-    void remove(const UUID& clipId, Timestamp mediaTime) {
+    void remove(const UUID& mediaItemId, int64_t frameIndex) {
         std::lock_guard lock(m_mutex);
         
-        FrameCacheKey key{clipId, mediaTime};
+        FrameCacheKey key{mediaItemId, frameIndex};
         auto it = m_cache.find(key);
         if (it != m_cache.end()) {
             m_memoryUsage -= estimateFrameSize(*it->second.frame);
+            unlink(key, it->second);
             m_cache.erase(it);
-            
-            auto lruIt = m_lruMap.find(key);
-            if (lruIt != m_lruMap.end()) {
-                m_lruList.erase(lruIt->second);
-                m_lruMap.erase(lruIt);
-            }
+            updateSizeStats();
         }
     }
     
     /**
-     * @brief Remove all frames for a clip
+     * @brief Remove all frames of a media item
+     * 
+     * Call when the file changed on disk.
+     * 
+     * @return Number of frames removed
      */
-    void removeClip(const UUID& clipId) {
+    size_t removeMedia(const UUID& mediaItemId) {
         std::lock_guard lock(m_mutex);
         
+        size_t removed = 0;
         for (auto it = m_cache.begin(); it != m_cache.end(); ) {
-            if (it->first.clipId == clipId) {
+            if (it->first.mediaItemId == mediaItemId) {
                 m_memoryUsage -= estimateFrameSize(*it->second.frame);
-                
-                auto lruIt = m_lruMap.find(it->first);
-                if (lruIt != m_lruMap.end()) {
-                    m_lruList.erase(lruIt->second);
-                    m_lruMap.erase(lruIt);
-                }
-                
+                unlink(it->first, it->second);
                 it = m_cache.erase(it);
+                ++removed;
             } else {
                 ++it;
             }
         }
+        
+        updateSizeStats();
+        return removed;
     }
     
     /**
@@ -227,8 +340,10 @@ public:
         std::lock_guard lock(m_mutex);
         m_cache.clear();
         m_lruList.clear();
+        m_speculativeList.clear();
         m_lruMap.clear();
         m_memoryUsage = 0;
+        updateSizeStats();
     }
     
     // ========== Prefetching ==========
@@ -236,30 +351,30 @@ public:
     /**
      * @brief Get range of frames to prefetch
      * 
-     * Returns frame times that should be decoded and cached
-     * for smooth playback around the given time.
+     * Returns the source frames that should be decoded and cached
+     * for smooth playback from the given frame on.
      * 
-     * @param clipId Clip to prefetch
-     * @param currentTime Current playback time
-     * @param frameDuration Duration of one frame
-     * @param count Number of frames to prefetch
-     * @return List of media times to prefetch
+     * @param mediaItemId Media item to prefetch
+     * @param firstFrame Frame currently shown
+     * @param count Number of frames to look ahead
+     * @param step Frames to advance per output frame (e.g. 2 at 2x speed,
+     *             negative when reversed)
+     * @return Frame indices not yet cached
      */
-    std::vector<Timestamp> getPrefetchRange(
-            const UUID& clipId,
-            Timestamp currentTime,
-            Duration frameDuration,
-            size_t count = 10) const {
+    std::vector<int64_t> getPrefetchRange(
+            const UUID& mediaItemId,
+            int64_t firstFrame,
+            size_t count = 10,
+            int64_t step = 1) const {
         std::lock_guard lock(m_mutex);
         
-        std::vector<Timestamp> result;
+        std::vector<int64_t> result;
         result.reserve(count);
         
         for (size_t i = 0; i < count; ++i) {
-            Timestamp time = currentTime + frameDuration * static_cast<int64_t>(i);
-            FrameCacheKey key{clipId, time};
-            if (m_cache.find(key) == m_cache.end()) {
-                result.push_back(time);
+            int64_t index = firstFrame + step * static_cast<int64_t>(i);
+            if (m_cache.find({mediaItemId, index}) == m_cache.end()) {
+                result.push_back(index);
             }
         }
         
@@ -293,27 +408,65 @@ private:
         return static_cast<size_t>(frame.width()) * frame.height() * 4;
     }
     
+    bool isFull(size_t incomingSize) const {
+        return m_cache.size() >= m_maxFrames ||
+               (m_maxMemory > 0 && m_memoryUsage + incomingSize > m_maxMemory);
+    }
+    
+    void updateSizeStats() {
+        m_stats.currentSize = m_cache.size();
+        m_stats.maxSize = std::max(m_stats.maxSize, m_cache.size());
+        m_stats.memoryUsage = m_memoryUsage;
+        m_stats.speculativeSize = m_speculativeList.size();
+    }
+    
     /**
      * @brief Move key to front of LRU list
+     * 
+     * A speculative frame being read joins the LRU list here.
      */
     void moveToFront(const FrameCacheKey& key) {
         auto it = m_lruMap.find(key);
-        if (it != m_lruMap.end()) {
+        if (it == m_lruMap.end()) return;
+        
+        auto entry = m_cache.find(key);
+        if (entry != m_cache.end() && entry->second.speculative) {
+            entry->second.speculative = false;
+            m_speculativeList.erase(it->second);
+            m_stats.speculativeSize = m_speculativeList.size();
+        } else {
             m_lruList.erase(it->second);
-            m_lruList.push_front(key);
-            it->second = m_lruList.begin();
         }
+        m_lruList.push_front(key);
+        it->second = m_lruList.begin();
     }
     
     /**
-     * @brief Evict least recently used frame
+     * @brief Drop a frame's LRU (or speculative) list entry
+     */
+    void unlink(const FrameCacheKey& key, const CachedFrame& entry) {
+        auto it = m_lruMap.find(key);
+        if (it == m_lruMap.end()) return;
+        
+        (entry.speculative ? m_speculativeList : m_lruList).erase(it->second);
+        m_lruMap.erase(it);
+    }
+    
+    /**
+     * @brief Evict the oldest speculative frame, else the least recently used
      * @return true if a frame was evicted
      */
     bool evictOne() {
-        if (m_lruList.empty()) return false;
-        
-        auto key = m_lruList.back();
-        m_lruList.pop_back();
+        FrameCacheKey key;
+        if (!m_speculativeList.empty()) {
+            key = m_speculativeList.front();
+            m_speculativeList.pop_front();
+        } else if (!m_lruList.empty()) {
+            key = m_lruList.back();
+            m_lruList.pop_back();
+        } else {
+            return false;
+        }
         m_lruMap.erase(key);
         
         auto it = m_cache.find(key);
@@ -330,13 +483,15 @@ private:
     
     size_t m_maxFrames;
     size_t m_maxMemory;
+    size_t m_maxSpeculative;
     size_t m_memoryUsage = 0;
     
     std::unordered_map<FrameCacheKey, CachedFrame> m_cache;
     
     // LRU tracking
     std::list<FrameCacheKey> m_lruList;
-    std::unordered_map<FrameCacheKey, std::list<FrameCacheKey>::iterator> m_lruMap;
+    std::list<FrameCacheKey> m_speculativeList;   // Unread speculative frames, oldest first
+    std::unordered_map<FrameCacheKey, std::list<FrameCacheKey>::iterator> m_lruMap;  // Either list
     
     mutable FrameCacheStats m_stats;
 };
@@ -0,0 +1,766 @@
+/**
+ * @file media_service.hpp
+ * @brief Shared decoders, frame cache and decode workers for all viewers
+ * 
+ * Source monitors, program monitors and thumbnail generators all read
+ * the same media. Giving each its own DecoderPool and FrameCache would
+ * open every file several times, decode shared frames twice and let
+ * hidden viewers compete with the one the user is watching. Viewers
+ * instead attach to one MediaService as prioritised clients.
+ */
+
+#pragma once
+
+#include <phoenix/core/latency_histogram.hpp>
+#include <phoenix/core/types.hpp>
+#include <phoenix/core/uuid.hpp>
+#include <phoenix/media/decoder_pool.hpp>
+#include <phoenix/media/frame.hpp>
+#include <phoenix/engine/compositor.hpp>
+#include <phoenix/engine/frame_cache.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace phoenix::engine {
+
+/**
+ * @brief Scheduling priority of a media client
+ * 
+ * Queued work runs highest priority first. While any client is at
+ * Playback, Background and Thumbnail work is held back.
+ */
+enum class MediaPriority : uint8_t {
+    Thumbnail,    ///< Media bin thumbnails and other batch work
+    Background,   ///< Hidden or unfocused viewers
+    Visible,      ///< A visible viewer that is paused or scrubbing
+    Playback,     ///< A visible viewer that is playing
+};
+
+/**
+ * @brief Where a media item's frames come from
+ */
+struct MediaSource {
+    std::filesystem::path path;
+    Rational frameRate;        ///< Source frame grid (see FrameCache::frameIndex)
+};
+
+/**
+ * @brief Resolves a media item ID to its file
+ * 
+ * Called from viewer and worker threads.
+ */
+using MediaResolver = std::function<std::optional<MediaSource>(const UUID&)>;
+
+/**
+ * @brief Media service configuration
+ */
+struct MediaServiceConfig {
+    size_t workerThreads = 0;          ///< 0 = half the hardware threads (at least 1)
+    size_t cacheFrames = 240;          ///< Frame cache capacity
+    size_t cacheMemoryMB = 1024;       ///< Frame cache memory limit
+    media::DecoderPoolConfig decoders;
+};
+
+class MediaService;
+
+/**
+ * @brief A viewer's (or other consumer's) handle on the media service
+ * 
+ * Synchronous decodes run on the calling thread; prefetches and
+ * submitted work run on the service's workers at the client's
+ * priority. Destroying the client cancels its queued work.
+ * 
+ * Thread-safe: All methods can be called from any thread.
+ */
+class MediaClient : public std::enable_shared_from_this<MediaClient> {
+public:
+    ~MediaClient();
+    
+    // Non-copyable
+    MediaClient(const MediaClient&) = delete;
+    MediaClient& operator=(const MediaClient&) = delete;
+    
+    [[nodiscard]] const std::string& name() const { return m_name; }
+    
+    // ========== Priority ==========
+    
+    [[nodiscard]] MediaPriority priority() const;
+    
+    /**
+     * @brief Change the priority (applies to queued work too)
+     */
+    void setPriority(MediaPriority priority);
+    
+    // ========== Frames ==========
+    
+    /**
+     * @brief Get a frame, decoding it on this thread on a cache miss
+     * 
+     * @param mediaItemId Media item to read
+     * @param mediaTime Time within the media (quantised to its frame grid)
+     * @return Frame or nullptr if the item is unknown or decoding failed
+     */
+    std::shared_ptr<media::VideoFrame> decodeFrame(const UUID& mediaItemId,
+                                                   Timestamp mediaTime);
+    
+    /**
+     * @brief Get a frame near a time, as cheaply as possible (scrubbing)
+     *  
+     * Returns the exact frame or the nearest cached one within
+     * MediaService::kScrubFrameDistance frames; failing that, decodes
+     * the keyframe at or before @p mediaTime (cached as itself).
+     *  
+     * @return Frame or nullptr if the item is unknown or decoding failed
+     */
+    std::shared_ptr<media::VideoFrame> scrubFrame(const UUID& mediaItemId,
+                                                  Timestamp mediaTime);
+    
+    /**
+     * @brief Frame decoder for a Compositor reading through this client
+     * 
+     * Draft requests go to scrubFrame(). The callback keeps the
+     * client alive.
+     */
+    [[nodiscard]] FrameDecoderCallback frameDecoder() {
+        return [client = shared_from_this()](const FrameRequest& request) {
+            if (request.quality == RenderQuality::Draft) {
+                return client->scrubFrame(request.mediaItemId, request.mediaTime);
+            }
+            return client->decodeFrame(request.mediaItemId, request.mediaTime);
+        };
+    }
+    
+    /**
+     * @brief Queue background decodes of upcoming frames
+     * 
+     * Frames already cached or queued by any client are skipped.
+     * 
+     * @param mediaItemId Media item to read
+     * @param mediaTime Time of the first frame
+     * @param count Number of frames
+     * @param step Source frames to advance per frame (negative when reversed)
+     */
+    void prefetch(const UUID& mediaItemId, Timestamp mediaTime,
+                  size_t count, int64_t step = 1);
+    
+    /**
+     * @brief Frames cached in a row after the latest prefetch() start
+     * 
+     * How far decoding is ahead of the reader; at most the count of
+     * that prefetch. Costs a cache lookup per frame: for statistics,
+     * not for every frame.
+     */
+    [[nodiscard]] size_t prefetchHorizon() const;
+    
+    /**
+     * @brief Warm up media the user is likely to play next (hover, selection)
+     * 
+     * Opens a decoder and decodes @p count frames from @p mediaTime,
+     * in order, in one job at this client's priority. The frames are
+     * cached speculatively (see FrameCache::putSpeculative()): they
+     * never evict frames in use, and decoding stops once there is no
+     * room for them. Replaces this client's previous hint.
+     * 
+     * @param mediaItemId Media item to warm up
+     * @param mediaTime First frame (e.g. the poster frame or clip start)
+     * @param count Number of frames
+     */
+    void hint(const UUID& mediaItemId, Timestamp mediaTime, size_t count);
+    
+    /**
+     * @brief Drop this client's hint, stopping it between frames if running
+     */
+    void cancelHint();
+    
+    // ========== Work ==========
+    
+    /**
+     * @brief Run arbitrary work on a service worker at this client's priority
+     */
+    void submit(std::function<void()> work);
+    
+    /**
+     * @brief Drop queued work (e.g. prefetches made stale by a seek)
+     * 
+     * Work already running finishes.
+     */
+    void cancelPending();
+    
+    /// Work queued and not yet started
+    [[nodiscard]] size_t pendingJobs() const;
+
+private:
+    friend class MediaService;
+    
+    MediaClient(MediaService* service, uint64_t id, std::string name)
+        : m_service(service), m_id(id), m_name(std::move(name)) {}
+    
+    /// Latest prefetch() request, for prefetchHorizon()
+    struct PrefetchWindow {
+        UUID mediaItemId;
+        Timestamp mediaTime = 0;
+        size_t count = 0;
+        int64_t step = 1;
+    };
+    
+    MediaService* m_service;
+    uint64_t m_id;
+    std::string m_name;
+    
+    mutable std::mutex m_mutex;
+    std::optional<PrefetchWindow> m_lastPrefetch;
+    std::shared_ptr<std::atomic<bool>> m_hintCancelled;  // Current hint's stop flag
+};
+
+/**
+ * @brief Decoder pool, frame cache and worker pool shared by all viewers
+ * 
+ * Usage:
+ * @code
+ *   MediaService service;
+ *   service.setMediaResolver([&](const UUID& id) { return lookup(id); });
+ * 
+ *   auto program = service.attach("Program", MediaPriority::Visible);
+ *   compositor.setFrameDecoder(program->frameDecoder());
+ * 
+ *   program->setPriority(MediaPriority::Playback);  // Preempts the rest
+ * @endcode
+ * 
+ * The service must outlive its clients.
+ * 
+ * Thread-safe: All methods can be called from any thread.
+ */
+class MediaService {
+public:
+    /// Farthest cached frame scrubFrame() shows instead of decoding
+    static constexpr int64_t kScrubFrameDistance = 12;
+    
+    explicit MediaService(const MediaServiceConfig& config = {})
+        : m_decoderPool(std::make_unique<media::DecoderPool>(config.decoders))
+        , m_frameCache(std::make_shared<FrameCache>(config.cacheFrames, config.cacheMemoryMB))
+    {
+        m_workerCount = config.workerThreads;
+        if (m_workerCount == 0) {
+            m_workerCount = std::max(1u, std::thread::hardware_concurrency() / 2);
+        }
+        
+        m_workers.reserve(m_workerCount);
+        for (size_t i = 0; i < m_workerCount; ++i) {
+            m_workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+    
+    ~MediaService() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+            m_queue.clear();
+        }
+        m_cv.notify_all();
+        
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+    
+    // Non-copyable
+    MediaService(const MediaService&) = delete;
+    MediaService& operator=(const MediaService&) = delete;
+    
+    // ========== Configuration ==========
+    
+    /**
+     * @brief Set how media item IDs map to files
+     */
+    void setMediaResolver(MediaResolver resolver) {
+        std::lock_guard lock(m_mutex);
+        m_resolver = std::make_shared<const MediaResolver>(std::move(resolver));
+    }
+    
+    /**
+     * @brief Register a client
+     * 
+     * @param name Shown in statistics and logs
+     * @param priority Initial priority
+     */
+    [[nodiscard]] std::shared_ptr<MediaClient> attach(std::string name,
+                                                      MediaPriority priority) {
+        std::lock_guard lock(m_mutex);
+        uint64_t id = ++m_nextClientId;
+        m_clients.emplace(id, priority);
+        return std::shared_ptr<MediaClient>(new MediaClient(this, id, std::move(name)));
+    }
+    
+    // ========== Invalidation ==========
+    
+    /**
+     * @brief Drop decoders and frames of a media item changed on disk
+     * 
+     * Frames being decoded when this is called are not cached.
+     */
+    void invalidate(const UUID& mediaItemId) {
+        auto source = resolve(mediaItemId);
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_generation;
+        }
+        
+        if (source) m_decoderPool->invalidate(source->path);
+        m_frameCache->removeMedia(mediaItemId);
+    }
+    
+    /**
+     * @brief Drop all queued work, decoders and frames (e.g. project closed)
+     */
+    void clear() {
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_generation;
+            for (const auto& job : m_queue) {
+                if (job.frame) m_pendingFrames.erase(*job.frame);
+            }
+            m_cancelledJobs += m_queue.size();
+            m_queue.clear();
+        }
+        
+        m_decoderPool->clear();
+        m_frameCache->clear();
+    }
+    
+    // ========== Accessors ==========
+    
+    [[nodiscard]] media::DecoderPool& decoderPool() { return *m_decoderPool; }
+    [[nodiscard]] std::shared_ptr<FrameCache> frameCache() const { return m_frameCache; }
+    [[nodiscard]] size_t workerCount() const { return m_workerCount; }
+    
+    /// Time spent in actual decodes (cache misses, prefetches, keyframes)
+    [[nodiscard]] const LatencyHistogram& decodeLatency() const { return m_decodeLatency; }
+    
+    /**
+     * @brief Service statistics
+     */
+    struct Stats {
+        size_t clients = 0;
+        size_t queuedJobs = 0;
+        size_t runningJobs = 0;
+        uint64_t completedJobs = 0;
+        uint64_t cancelledJobs = 0;
+        bool playbackActive = false;   ///< Some client is at Playback
+    };
+    
+    [[nodiscard]] Stats stats() const {
+        std::lock_guard lock(m_mutex);
+        Stats s;
+        s.clients = m_clients.size();
+        s.queuedJobs = m_queue.size();
+        s.runningJobs = m_running;
+        s.completedJobs = m_completedJobs;
+        s.cancelledJobs = m_cancelledJobs;
+        s.playbackActive = playbackActive();
+        return s;
+    }
+
+private:
+    friend class MediaClient;
+    
+    struct Job {
+        uint64_t clientId = 0;
+        std::optional<FrameCacheKey> frame;    // Set for prefetches
+        std::function<void()> work;
+    };
+    
+    // ========== Decoding ==========
+    
+    std::optional<MediaSource> resolve(const UUID& mediaItemId) const {
+        std::shared_ptr<const MediaResolver> resolver;
+        {
+            std::lock_guard lock(m_mutex);
+            resolver = m_resolver;
+        }
+        if (!resolver || !*resolver) return std::nullopt;
+        return (*resolver)(mediaItemId);
+    }
+    
+    std::shared_ptr<media::VideoFrame> decode(const UUID& mediaItemId,
+                                              Timestamp mediaTime) {
+        auto source = resolve(mediaItemId);
+        if (!source) return nullptr;
+        
+        int64_t index = FrameCache::frameIndex(mediaTime, source->frameRate);
+        if (auto cached = m_frameCache->get(mediaItemId, index)) {
+            return cached;
+        }
+        return decodeIndex(mediaItemId, *source, index);
+    }
+    
+    std::shared_ptr<media::VideoFrame> decodeApproximate(const UUID& mediaItemId,
+                                                         Timestamp mediaTime) {
+        auto source = resolve(mediaItemId);
+        if (!source) return nullptr;
+        
+        int64_t index = FrameCache::frameIndex(mediaTime, source->frameRate);
+        if (auto cached = m_frameCache->getNearest(mediaItemId, index, kScrubFrameDistance)) {
+            return cached;
+        }
+        
+        uint64_t generation = currentGeneration();
+        auto started = std::chrono::steady_clock::now();
+        auto result = m_decoderPool->decodeKeyFrame(
+            source->path, FrameCache::frameTime(index, source->frameRate));
+        recordDecode(started);
+        if (!result) return nullptr;
+        
+        auto frame = std::make_shared<media::VideoFrame>(std::move(result.value()));
+        
+        // Cached under the frame it is, which later scrubs can reuse
+        putIfCurrent(generation, mediaItemId,
+                     FrameCache::frameIndex(frame->pts(), source->frameRate), frame);
+        return frame;
+    }
+    
+    std::shared_ptr<media::VideoFrame> decodeIndex(const UUID& mediaItemId,
+                                                   const MediaSource& source,
+                                                   int64_t index) {
+        uint64_t generation = currentGeneration();
+        
+        // Decode at the frame's own start time, whatever time hit it
+        auto started = std::chrono::steady_clock::now();
+        auto result = m_decoderPool->decodeFrame(
+            source.path, FrameCache::frameTime(index, source.frameRate));
+        recordDecode(started);
+        if (!result) return nullptr;
+        
+        auto frame = std::make_shared<media::VideoFrame>(std::move(result.value()));
+        
+        putIfCurrent(generation, mediaItemId, index, frame);
+        return frame;
+    }
+    
+    void recordDecode(std::chrono::steady_clock::time_point started) {
+        m_decodeLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started).count());
+    }
+    
+    uint64_t currentGeneration() const {
+        std::lock_guard lock(m_mutex);
+        return m_generation;
+    }
+    
+    /**
+     * @brief Cache a decoded frame unless invalidated since generation
+     * 
+     * Invalidated mid-decode, the frame may be of the old file. The
+     * check and the put share the lock that bumps the generation, so
+     * an invalidate() cannot slip in between and miss the frame.
+     * 
+     * @return false if stale, or a speculative frame found no room
+     */
+    bool putIfCurrent(uint64_t generation, const UUID& mediaItemId, int64_t index,
+                      std::shared_ptr<media::VideoFrame> frame, bool speculative = false) {
+        std::lock_guard lock(m_mutex);
+        if (m_generation != generation) return false;
+        if (speculative) {
+            return m_frameCache->putSpeculative(mediaItemId, index, std::move(frame));
+        }
+        m_frameCache->put(mediaItemId, index, std::move(frame));
+        return true;
+    }
+    
+    // ========== Scheduling ==========
+    
+    void enqueue(uint64_t clientId, std::optional<FrameCacheKey> frame,
+                 std::function<void()> work) {
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_stopping || !m_clients.contains(clientId)) return;
+            if (frame && !m_pendingFrames.insert(*frame).second) return;
+            
+            m_queue.push_back({clientId, std::move(frame), std::move(work)});
+        }
+        m_cv.notify_one();
+    }
+    
+    void prefetch(uint64_t clientId, const UUID& mediaItemId, Timestamp mediaTime,
+                  size_t count, int64_t step) {
+        auto source = resolve(mediaItemId);
+        if (!source) return;
+        
+        int64_t first = FrameCache::frameIndex(mediaTime, source->frameRate);
+        for (int64_t index : m_frameCache->getPrefetchRange(mediaItemId, first, count, step)) {
+            if (index < 0) continue;
+            
+            enqueue(clientId, FrameCacheKey{mediaItemId, index},
+                [this, mediaItemId, source = *source, index]() {
+                    if (!m_frameCache->contains(mediaItemId, index)) {
+                        (void)decodeIndex(mediaItemId, source, index);
+                    }
+                });
+        }
+    }
+    
+    void hint(uint64_t clientId, const UUID& mediaItemId, Timestamp mediaTime, size_t count,
+              std::shared_ptr<const std::atomic<bool>> cancelled) {
+        auto source = resolve(mediaItemId);
+        if (!source || count == 0) return;
+        
+        // One job: consecutive frames decode sequentially on one decoder.
+        // Not deduplicated by frame: a cancelled hint may still be
+        // queued when the same item is hinted again.
+        int64_t first = FrameCache::frameIndex(mediaTime, source->frameRate);
+        enqueue(clientId, std::nullopt,
+            [this, mediaItemId, source = *source, first, count, cancelled]() {
+                uint64_t generation = currentGeneration();
+                for (size_t i = 0; i < count && !cancelled->load(); ++i) {
+                    int64_t index = first + static_cast<int64_t>(i);
+                    if (m_frameCache->contains(mediaItemId, index)) continue;
+                    
+                    auto started = std::chrono::steady_clock::now();
+                    auto result = m_decoderPool->decodeFrame(
+                        source.path, FrameCache::frameTime(index, source.frameRate));
+                    recordDecode(started);
+                    if (!result) return;
+                    
+                    auto frame = std::make_shared<media::VideoFrame>(std::move(result.value()));
+                    if (!putIfCurrent(generation, mediaItemId, index, std::move(frame), true)) {
+                        return;  // Invalidated, or no room left that is not in use
+                    }
+                }
+            });
+    }
+    
+    void cancel(uint64_t clientId) {
+        std::lock_guard lock(m_mutex);
+        for (auto it = m_queue.begin(); it != m_queue.end(); ) {
+            if (it->clientId == clientId) {
+                if (it->frame) m_pendingFrames.erase(*it->frame);
+                it = m_queue.erase(it);
+                ++m_cancelledJobs;
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    void detach(uint64_t clientId) {
+        cancel(clientId);
+        {
+            std::lock_guard lock(m_mutex);
+            m_clients.erase(clientId);
+        }
+        
+        // Held work may be admissible now
+        m_cv.notify_all();
+    }
+    
+    MediaPriority clientPriority(uint64_t clientId) const {
+        auto it = m_clients.find(clientId);
+        return it != m_clients.end() ? it->second : MediaPriority::Thumbnail;
+    }
+    
+    void setClientPriority(uint64_t clientId, MediaPriority priority) {
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_clients.find(clientId);
+            if (it == m_clients.end() || it->second == priority) return;
+            it->second = priority;
+        }
+        m_cv.notify_all();
+    }
+    
+    size_t pendingJobs(uint64_t clientId) const {
+        std::lock_guard lock(m_mutex);
+        return static_cast<size_t>(std::count_if(m_queue.begin(), m_queue.end(),
+            [clientId](const Job& job) { return job.clientId == clientId; }));
+    }
+    
+    bool playbackActive() const {
+        return std::any_of(m_clients.begin(), m_clients.end(),
+            [](const auto& c) { return c.second == MediaPriority::Playback; });
+    }
+    
+    /**
+     * @brief Highest priority job allowed to start now (caller holds m_mutex)
+     * 
+     * Background and Thumbnail work waits while something plays, and
+     * never takes the last worker, so a viewer becoming visible does
+     * not queue behind a batch of thumbnails.
+     */
+    std::deque<Job>::iterator nextJob() {
+        bool playing = playbackActive();
+        bool lowSlotFree = m_runningLow + 1 < m_workerCount || m_workerCount == 1;
+        
+        auto best = m_queue.end();
+        MediaPriority bestPriority = MediaPriority::Thumbnail;
+        for (auto it = m_queue.begin(); it != m_queue.end(); ++it) {
+            MediaPriority priority = clientPriority(it->clientId);
+            if (priority < MediaPriority::Visible && (playing || !lowSlotFree)) continue;
+            
+            // Queue order is FIFO, so the first of a priority wins
+            if (best == m_queue.end() || priority > bestPriority) {
+                best = it;
+                bestPriority = priority;
+            }
+        }
+        return best;
+    }
+    
+    void workerLoop() {
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            if (m_stopping) return;
+            
+            auto it = nextJob();
+            if (it == m_queue.end()) {
+                m_cv.wait(lock);
+                continue;
+            }
+            
+            Job job = std::move(*it);
+            m_queue.erase(it);
+            bool low = clientPriority(job.clientId) < MediaPriority::Visible;
+            ++m_running;
+            if (low) ++m_runningLow;
+            
+            lock.unlock();
+            job.work();
+            lock.lock();
+            
+            --m_running;
+            if (low) --m_runningLow;
+            ++m_completedJobs;
+            if (job.frame) m_pendingFrames.erase(*job.frame);
+            
+            // Held low priority work may fit in the freed slot
+            if (low) m_cv.notify_all();
+        }
+    }
+    
+    std::unique_ptr<media::DecoderPool> m_decoderPool;
+    std::shared_ptr<FrameCache> m_frameCache;
+    std::shared_ptr<const MediaResolver> m_resolver;
+    
+    // Clients: id -> priority
+    std::unordered_map<uint64_t, MediaPriority> m_clients;
+    uint64_t m_nextClientId = 0;
+    
+    // Work queue, FIFO within a priority (scanned; small)
+    std::deque<Job> m_queue;
+    std::unordered_set<FrameCacheKey> m_pendingFrames;  // Queued or running prefetches
+    
+    std::vector<std::thread> m_workers;
+    size_t m_workerCount = 0;       // Fixed before the workers start
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopping = false;
+    
+    uint64_t m_generation = 0;      // Bumped by invalidate() and clear()
+    size_t m_running = 0;
+    size_t m_runningLow = 0;        // Running Background/Thumbnail jobs
+    uint64_t m_completedJobs = 0;
+    uint64_t m_cancelledJobs = 0;
+    
+    LatencyHistogram m_decodeLatency;
+};
+
+// ========== MediaClient ==========
+
+inline MediaClient::~MediaClient() {
+    m_service->detach(m_id);
+}
+
+inline MediaPriority MediaClient::priority() const {
+    std::lock_guard lock(m_service->m_mutex);
+    return m_service->clientPriority(m_id);
+}
+
+inline void MediaClient::setPriority(MediaPriority priority) {
+    m_service->setClientPriority(m_id, priority);
+}
+
+inline std::shared_ptr<media::VideoFrame> MediaClient::decodeFrame(
+    const UUID& mediaItemId, Timestamp mediaTime)
+{
+    return m_service->decode(mediaItemId, mediaTime);
+}
+
+inline std::shared_ptr<media::VideoFrame> MediaClient::scrubFrame(
+    const UUID& mediaItemId, Timestamp mediaTime)
+{
+    return m_service->decodeApproximate(mediaItemId, mediaTime);
+}
+
+inline void MediaClient::prefetch(const UUID& mediaItemId, Timestamp mediaTime,
+                                  size_t count, int64_t step) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_lastPrefetch = PrefetchWindow{mediaItemId, mediaTime, count, step};
+    }
+    m_service->prefetch(m_id, mediaItemId, mediaTime, count, step);
+}
+
+inline size_t MediaClient::prefetchHorizon() const {
+    PrefetchWindow window;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_lastPrefetch) return 0;
+        window = *m_lastPrefetch;
+    }
+    
+    auto source = m_service->resolve(window.mediaItemId);
+    if (!source) return 0;
+    
+    int64_t first = FrameCache::frameIndex(window.mediaTime, source->frameRate);
+    size_t ready = 0;
+    while (ready < window.count &&
+           m_service->m_frameCache->contains(
+               window.mediaItemId, first + window.step * static_cast<int64_t>(ready))) {
+        ++ready;
+    }
+    return ready;
+}
+
+inline void MediaClient::hint(const UUID& mediaItemId, Timestamp mediaTime, size_t count) {
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_hintCancelled) *m_hintCancelled = true;
+        m_hintCancelled = cancelled;
+    }
+    m_service->hint(m_id, mediaItemId, mediaTime, count, std::move(cancelled));
+}
+
+inline void MediaClient::cancelHint() {
+    std::lock_guard lock(m_mutex);
+    if (m_hintCancelled) {
+        *m_hintCancelled = true;
+        m_hintCancelled.reset();
+    }
+}
+
+inline void MediaClient::submit(std::function<void()> work) {
+    m_service->enqueue(m_id, std::nullopt, std::move(work));
+}
+
+inline void MediaClient::cancelPending() {
+    m_service->cancel(m_id);
+}
+
+inline size_t MediaClient::pendingJobs() const {
+    return m_service->pendingJobs(m_id);
+}
+
+} // namespace phoenix::engine
@@ -10,6 +10,7 @@
 
 #include <phoenix/core/types.hpp>
 #include <phoenix/core/clock.hpp>
+#include <phoenix/core/latency_histogram.hpp>
 #include <phoenix/core/signals.hpp>
 #include <phoenix/model/sequence.hpp>
 #include <phoenix/engine/compositor.hpp>
@@ -18,8 +19,10 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <optional>
 
 namespace phoenix::engine {
 
@@ -41,6 +44,42 @@ enum class PlaybackDirection {
     Backward,
 };
 
+/**
+ * @brief Seek statistics
+ */
+struct SeekStats {
+    uint64_t requested = 0;     ///< Frames requested by seek() and refreshFrame()
+    uint64_t delivered = 0;     ///< Full-quality frames delivered
+    uint64_t coalesced = 0;     ///< Replaced by a newer seek before composing started
+    uint64_t cancelled = 0;     ///< Abandoned mid-compose or finished stale
+    uint64_t empty = 0;         ///< Composed, but produced no frame
+    Duration lastLatency = 0;   ///< Request to delivery of the latest full-quality frame (µs)
+    Duration maxLatency = 0;
+    Duration totalLatency = 0;  ///< Sum over delivered full-quality frames
+    
+    uint64_t draftsDelivered = 0;    ///< Draft frames delivered
+    Duration lastDraftLatency = 0;   ///< Request to delivery of the latest draft frame (µs)
+    Duration maxDraftLatency = 0;
+    Duration totalDraftLatency = 0;
+    
+    [[nodiscard]] Duration averageLatency() const {
+        return delivered > 0 ? totalLatency / static_cast<Duration>(delivered) : 0;
+    }
+    
+    [[nodiscard]] Duration averageDraftLatency() const {
+        return draftsDelivered > 0
+            ? totalDraftLatency / static_cast<Duration>(draftsDelivered) : 0;
+    }
+};
+
+/**
+ * @brief Frame delivery statistics
+ */
+struct PlaybackStats {
+    uint64_t framesDelivered = 0;   ///< Frames passed to the frame callback (playing or seeking)
+    uint64_t framesDropped = 0;     ///< Playback frame slots missed because composing ran late
+};
+
 /**
  * @brief Frame ready callback
  */
@@ -56,6 +95,11 @@ using FrameCallback = std::function<void(
  * playback. Integrates with the Compositor for frame
  * generation and MasterClock for timing.
  * 
+ * Seeks return at once: the target frame is composed on a seek
+ * thread and delivered through the frame callback. Each seek bumps
+ * a generation, so a newer one abandons older frames between layer
+ * decodes and only the latest target is shown.
+ * 
  * Usage:
  * @code
  *   PlaybackEngine engine;
@@ -79,6 +123,16 @@ public:
         if (m_playbackThread.joinable()) {
             m_playbackThread.join();
         }
+        
+        {
+            std::lock_guard lock(m_seekMutex);
+            m_seekExit = true;
+        }
+        ++m_seekGeneration;
+        m_seekCv.notify_all();
+        if (m_seekThread.joinable()) {
+            m_seekThread.join();
+        }
     }
     
     // Non-copyable
@@ -97,10 +151,12 @@ public:
         m_sequence = sequence;
         
         if (sequence) {
-            m_duration = sequence->duration();
+            auto snapshot = sequence->snapshot();
+            m_duration = snapshot ? snapshot->duration() : 0;
             m_frameRate = sequence->settings().frameRate;
             m_frameDuration = sequence->settings().frameDuration();
-            m_outPoint = m_duration;  // Reset out point to end
+            m_outPoint = m_duration.load();  // Reset out point to end
+            m_seenRevision = snapshot ? snapshot->revision() : 0;
         }
         
         if (wasPlaying) play();
@@ -113,6 +169,13 @@ public:
         m_compositor = compositor;
     }
     
+    /**
+     * @brief Share a frame cache (e.g. a MediaService's) instead of a private one
+     */
+    void setFrameCache(std::shared_ptr<FrameCache> cache) {
+        if (cache) m_frameCache = std::move(cache);
+    }
+    
     /**
      * @brief Set frame ready callback
      */
@@ -144,6 +207,12 @@ public:
     void play() {
         if (m_state == PlaybackState::Playing) return;
         
+        refreshTimeline();
+        
+        // A seek frame delivered now would land after newer playback
+        // frames, and would compose alongside the playback thread
+        cancelSeek();
+        
         m_state = PlaybackState::Playing;
         m_clock->resume();
         
@@ -195,26 +264,40 @@ public:
     
     /**
      * @brief Seek to specific time
+     * 
+     * Moves the position at once; the frame follows asynchronously
+     * (while playing, the next playback frame shows it instead).
+     *  
+     * @param time Target position
+     * @param quality Draft for scrubbing: a nearby or keyframe
+     *        approximation, to be followed by a Full seek or
+     *        refreshFrame() once the position rests
      */
-    void seek(Timestamp time) {
-        auto prevState = m_state.load();
-        m_state = PlaybackState::Seeking;
+    void seek(Timestamp time, RenderQuality quality = RenderQuality::Full) {
+        refreshTimeline();
         
-        m_currentTime = std::clamp(time, Timestamp(0), m_duration);
+        m_currentTime = std::clamp(time, Timestamp(0), m_duration.load());
         m_clock->seek(m_currentTime);
         
-        // Generate frame at new position
-        if (m_compositor && m_frameCallback) {
-            auto result = m_compositor->compose(m_currentTime);
-            if (result.frame) {
-                m_frameCallback(result.frame, m_currentTime);
-            }
+        if (m_state == PlaybackState::Playing) {
+            ++m_seekGeneration;  // Drop frames of earlier seeks
+        } else {
+            requestFrame(m_currentTime, quality);
         }
         
-        m_state = prevState;
         positionChanged.fire(m_currentTime);
     }
     
+    /**
+     * @brief Re-render the current position (e.g. after an edit)
+     * 
+     * Delivered asynchronously like a seek; does nothing while playing.
+     */
+    void refreshFrame() {
+        if (m_state == PlaybackState::Playing) return;
+        requestFrame(m_currentTime);
+    }
+    
     /**
      * @brief Step forward by one frame
      */
@@ -242,7 +325,7 @@ public:
      * @brief Go to sequence end
      */
     void goToEnd() {
-        seek(m_duration);
+        seek(m_duration.load());
     }
     
     // ========== In/Out Points ==========
@@ -251,14 +334,14 @@ public:
      * @brief Set in point for loop/export
      */
     void setInPoint(Timestamp time) {
-        m_inPoint = std::clamp(time, Timestamp(0), m_outPoint);
+        m_inPoint = std::clamp(time, Timestamp(0), m_outPoint.load());
     }
     
     /**
      * @brief Set out point for loop/export
      */
     void setOutPoint(Timestamp time) {
-        m_outPoint = std::clamp(time, m_inPoint, m_duration);
+        m_outPoint = std::clamp(time, m_inPoint.load(), m_duration.load());
     }
     
     /**
@@ -266,7 +349,7 @@ public:
      */
     void clearInOutPoints() {
         m_inPoint = 0;
-        m_outPoint = m_duration;
+        m_outPoint = m_duration.load();
     }
     
     // ========== State Queries ==========
@@ -290,6 +373,27 @@ public:
     [[nodiscard]] std::shared_ptr<FrameCache> frameCache() const { return m_frameCache; }
     [[nodiscard]] std::shared_ptr<MasterClock> clock() const { return m_clock; }
     
+    [[nodiscard]] SeekStats seekStats() const {
+        std::lock_guard lock(m_seekMutex);
+        return m_seekStats;
+    }
+    
+    [[nodiscard]] PlaybackStats playbackStats() const {
+        PlaybackStats stats;
+        stats.framesDelivered = m_framesDelivered.load(std::memory_order_relaxed);
+        stats.framesDropped = m_framesDropped.load(std::memory_order_relaxed);
+        return stats;
+    }
+    
+    /// Compositor time per delivered frame (playing and seeking)
+    [[nodiscard]] const LatencyHistogram& composeLatency() const { return m_composeLatency; }
+    
+    /// A seek frame is queued or being composed
+    [[nodiscard]] bool seekPending() const {
+        std::lock_guard lock(m_seekMutex);
+        return m_seekTarget.has_value() || m_seekBusy;
+    }
+    
     // ========== Signals ==========
     
     Signal<PlaybackState> stateChanged;
@@ -297,6 +401,143 @@ public:
     VoidSignal playbackEnded;
     
 private:
+    /**
+     * @brief Pick up duration changes from edits
+     * 
+     * Cheap revision compare; only re-walks the sequence after
+     * an edit has been committed.
+     */
+    void refreshTimeline() {
+        if (!m_sequence) return;
+        
+        // Read the published snapshot so this is safe on the playback thread
+        auto snapshot = m_sequence->snapshot();
+        if (!snapshot || snapshot->revision() == m_seenRevision) return;
+        m_seenRevision = snapshot->revision();
+        
+        Duration duration = snapshot->duration();
+        Timestamp outPoint = m_outPoint.load();
+        bool outAtEnd = outPoint == m_duration.load();
+        m_duration = duration;
+        if (outAtEnd || outPoint > duration) {
+            outPoint = duration;
+            m_outPoint = outPoint;
+        }
+        m_inPoint = std::min(m_inPoint.load(), outPoint);
+    }
+    
+    // ========== Seeking ==========
+    
+    struct SeekRequest {
+        Timestamp time = 0;
+        RenderQuality quality = RenderQuality::Full;
+        uint64_t generation = 0;
+        std::chrono::steady_clock::time_point requestedAt;
+    };
+    
+    /**
+     * @brief Post a frame to the seek thread, replacing any not yet started
+     */
+    void requestFrame(Timestamp time, RenderQuality quality = RenderQuality::Full) {
+        uint64_t generation = ++m_seekGeneration;
+        {
+            std::lock_guard lock(m_seekMutex);
+            ++m_seekStats.requested;
+            if (m_seekTarget) ++m_seekStats.coalesced;
+            m_seekTarget = SeekRequest{time, quality, generation,
+                                       std::chrono::steady_clock::now()};
+            
+            if (!m_seekThread.joinable()) {
+                m_seekThread = std::thread([this]() { seekLoop(); });
+            }
+        }
+        m_seekCv.notify_one();
+    }
+    
+    /**
+     * @brief Drop any queued seek and wait out the one being composed
+     */
+    void cancelSeek() {
+        ++m_seekGeneration;
+        
+        std::unique_lock lock(m_seekMutex);
+        if (m_seekTarget) {
+            m_seekTarget.reset();
+            ++m_seekStats.cancelled;
+        }
+        m_seekIdleCv.wait(lock, [this]() { return !m_seekBusy; });
+    }
+    
+    enum class SeekOutcome { Delivered, Cancelled, Empty };
+    
+    void seekLoop() {
+        std::unique_lock lock(m_seekMutex);
+        for (;;) {
+            m_seekCv.wait(lock, [this]() { return m_seekExit || m_seekTarget.has_value(); });
+            if (m_seekExit) return;
+            
+            SeekRequest request = *m_seekTarget;
+            m_seekTarget.reset();
+            m_seekBusy = true;
+            lock.unlock();
+            
+            SeekOutcome outcome = renderSeek(request);
+            
+            lock.lock();
+            m_seekBusy = false;
+            m_seekIdleCv.notify_all();
+            if (outcome == SeekOutcome::Delivered) {
+                auto latency = static_cast<Duration>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - request.requestedAt).count());
+                if (request.quality == RenderQuality::Draft) {
+                    ++m_seekStats.draftsDelivered;
+                    m_seekStats.lastDraftLatency = latency;
+                    m_seekStats.maxDraftLatency = std::max(m_seekStats.maxDraftLatency, latency);
+                    m_seekStats.totalDraftLatency += latency;
+                } else {
+                    ++m_seekStats.delivered;
+                    m_seekStats.lastLatency = latency;
+                    m_seekStats.maxLatency = std::max(m_seekStats.maxLatency, latency);
+                    m_seekStats.totalLatency += latency;
+                }
+            } else if (outcome == SeekOutcome::Empty) {
+                ++m_seekStats.empty;
+            } else {
+                ++m_seekStats.cancelled;
+            }
+        }
+    }
+    
+    /**
+     * @brief Compose and deliver a seek frame unless superseded
+     */
+    SeekOutcome renderSeek(const SeekRequest& request) {
+        if (!m_compositor || !m_frameCallback) return SeekOutcome::Empty;
+        
+        ComposeToken token{&m_seekGeneration, request.generation};
+        if (token.cancelled()) return SeekOutcome::Cancelled;
+        
+        auto started = std::chrono::steady_clock::now();
+        auto result = m_compositor->compose(request.time, token, request.quality);
+        if (result.cancelled || token.cancelled()) return SeekOutcome::Cancelled;
+        if (!result.frame) return SeekOutcome::Empty;
+        
+        deliver(result.frame, request.time, started);
+        return SeekOutcome::Delivered;
+    }
+    
+    /**
+     * @brief Record the compose time and hand the frame to the callback
+     */
+    void deliver(std::shared_ptr<media::VideoFrame> frame, Timestamp time,
+                 std::chrono::steady_clock::time_point composeStarted) {
+        m_composeLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - composeStarted).count());
+        m_framesDelivered.fetch_add(1, std::memory_order_relaxed);
+        m_frameCallback(std::move(frame), time);
+    }
+    
     void startPlaybackThread() {
         if (m_playbackThread.joinable()) {
             m_cv.notify_all();
@@ -323,6 +564,16 @@ private:
             );
             
             if (elapsed >= targetDuration) {
+                // Whole slots passed since the last frame were never shown
+                if (elapsed >= 2 * targetDuration && targetDuration > 0) {
+                    m_framesDropped.fetch_add(
+                        static_cast<uint64_t>(elapsed / targetDuration - 1),
+                        std::memory_order_relaxed);
+                }
+                
+                // Pick up edits made while playing
+                refreshTimeline();
+                
                 // Time for next frame
                 m_currentTime += m_frameDuration;
                 lastFrameTime = now;
@@ -330,7 +581,7 @@ private:
                 // Check for end of sequence
                 if (m_currentTime >= m_outPoint) {
                     if (m_looping) {
-                        m_currentTime = m_inPoint;
+                        m_currentTime = m_inPoint.load();
                     } else {
                         m_state = PlaybackState::Stopped;
                         playbackEnded.fire();
@@ -343,9 +594,10 @@ private:
                 
                 // Compose and deliver frame
                 if (m_compositor && m_frameCallback) {
+                    auto started = steady_clock::now();
                     auto result = m_compositor->compose(m_currentTime);
                     if (result.frame) {
-                        m_frameCallback(result.frame, m_currentTime);
+                        deliver(result.frame, m_currentTime, started);
                     }
                 }
                 
@@ -376,9 +628,10 @@ private:
     std::atomic<double> m_playbackSpeed{1.0};
     
     // Timeline
-    Duration m_duration = 0;
-    Timestamp m_inPoint = 0;
-    Timestamp m_outPoint = 0;
+    std::atomic<Duration> m_duration{0};
+    std::atomic<Timestamp> m_inPoint{0};
+    std::atomic<Timestamp> m_outPoint{0};
+    std::atomic<uint64_t> m_seenRevision{0};
     
     // Timing
     Rational m_frameRate{30, 1};
@@ -395,6 +648,22 @@ private:
     std::thread m_playbackThread;
     std::mutex m_mutex;
     std::condition_variable m_cv;
+    
+    // Seeking (latest request wins)
+    std::thread m_seekThread;
+    mutable std::mutex m_seekMutex;
+    std::condition_variable m_seekCv;
+    std::condition_variable m_seekIdleCv;   // m_seekBusy cleared
+    std::optional<SeekRequest> m_seekTarget;
+    std::atomic<uint64_t> m_seekGeneration{0};
+    bool m_seekBusy = false;
+    bool m_seekExit = false;
+    SeekStats m_seekStats;
+    
+    // Statistics (any thread)
+    std::atomic<uint64_t> m_framesDelivered{0};
+    std::atomic<uint64_t> m_framesDropped{0};
+    LatencyHistogram m_composeLatency;
 };
 
 } // namespace phoenix::engine
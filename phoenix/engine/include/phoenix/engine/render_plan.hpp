@@ -0,0 +1,312 @@
+/**
+ * @file render_plan.hpp
+ * @brief Precompiled per-time-range layer schedule of a sequence
+ *
+ * A timeline's layout only changes on edits, yet composing a frame
+ * used to walk every track, look up the clip at the current time and
+ * cull hidden, muted and disabled content. A RenderPlan does that once
+ * per revision: the timeline is cut into segments at every clip edge,
+ * and each segment lists the clips to composite there, bottom to top.
+ * Per frame, composition is a binary search plus O(layers).
+ */
+
+#pragma once
+
+#include <phoenix/core/types.hpp>
+#include <phoenix/core/uuid.hpp>
+#include <phoenix/model/clip.hpp>
+#include <phoenix/model/sequence_snapshot.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace phoenix::engine {
+
+/**
+ * @brief Immutable layer schedule for one sequence revision
+ *
+ * Plans are built from a SequenceSnapshot, which they keep alive;
+ * layers point at the snapshot's frozen clips. Safe to share between
+ * threads.
+ *
+ * Usage:
+ * @code
+ *   auto plan = RenderPlan::build(sequence.snapshot());
+ *   if (const auto* segment = plan->segmentAt(time)) {
+ *       for (const auto& layer : plan->layers(*segment)) {
+ *           decode(layer.clip->mapToSource(time));
+ *       }
+ *   }
+ * @endcode
+ */
+class RenderPlan {
+public:
+    using SnapshotPtr = std::shared_ptr<const model::SequenceSnapshot>;
+
+    /**
+     * @brief A clip to composite within a segment
+     */
+    struct Layer {
+        const model::Clip* clip = nullptr;  ///< Frozen clip (owned by the snapshot)
+        int trackIndex = 0;                 ///< Index among the video tracks
+    };
+
+    /**
+     * @brief A time range with a constant layer list
+     *
+     * Ranges with nothing to composite have no segment.
+     */
+    struct Segment {
+        Timestamp start = 0;        ///< Inclusive
+        Timestamp end = 0;          ///< Exclusive
+        uint32_t firstLayer = 0;    ///< Offset into the plan's layers
+        uint32_t layerCount = 0;
+        bool hasNests = false;      ///< Some layer is a nested sequence
+    };
+
+    /**
+     * @brief Compile the plan for a snapshot
+     *
+     * With @p prev (a plan of an earlier revision of the same
+     * sequence), only the time ranges touched by changed clips are
+     * recompiled; segments outside them are copied. Track additions,
+     * removals, reordering and visibility changes recompile
+     * everything.
+     */
+    static std::shared_ptr<const RenderPlan> build(SnapshotPtr snapshot,
+                                                   const RenderPlan* prev = nullptr) {
+        auto plan = std::make_shared<RenderPlan>();
+        plan->m_snapshot = std::move(snapshot);
+        if (!plan->m_snapshot) return plan;
+
+        plan->m_revision = plan->m_snapshot->revision();
+
+        const auto* prevSnapshot = prev ? prev->m_snapshot.get() : nullptr;
+        if (!prevSnapshot || prevSnapshot->id() != plan->m_snapshot->id() ||
+            !sameTrackLayout(*prevSnapshot, *plan->m_snapshot)) {
+            plan->compileRange(std::numeric_limits<Timestamp>::min(),
+                               std::numeric_limits<Timestamp>::max());
+            plan->m_compiledSegments = plan->m_segments.size();
+            return plan;
+        }
+
+        auto ranges = changedRanges(*prevSnapshot, *plan->m_snapshot);
+        if (ranges.empty()) {
+            plan->m_segments = prev->m_segments;
+            plan->m_layers = prev->m_layers;
+            return plan;
+        }
+
+        const auto& prevSegments = prev->m_segments;
+        plan->m_segments.reserve(prevSegments.size() + 8);
+        plan->m_layers.reserve(prev->m_layers.size() + 8);
+
+        size_t next = 0;
+        for (size_t r = 0; r < ranges.size(); ++r) {
+            auto [lo, hi] = ranges[r];
+            while (next < prevSegments.size() && prevSegments[next].end <= lo) {
+                plan->copySegment(*prev, prevSegments[next++]);
+            }
+
+            // Recompile whole segments so none is split by the range;
+            // growing the range may swallow the following ones
+            if (next < prevSegments.size() && prevSegments[next].start < hi) {
+                lo = std::min(lo, prevSegments[next].start);
+            }
+            for (;;) {
+                while (next < prevSegments.size() && prevSegments[next].start < hi) {
+                    hi = std::max(hi, prevSegments[next++].end);
+                }
+                if (r + 1 < ranges.size() && ranges[r + 1].first < hi) {
+                    hi = std::max(hi, ranges[++r].second);
+                } else {
+                    break;
+                }
+            }
+
+            size_t before = plan->m_segments.size();
+            plan->compileRange(lo, hi);
+            plan->m_compiledSegments += plan->m_segments.size() - before;
+        }
+        while (next < prevSegments.size()) {
+            plan->copySegment(*prev, prevSegments[next++]);
+        }
+        return plan;
+    }
+
+    // ========== Queries ==========
+
+    /**
+     * @brief Segment covering a time
+     *
+     * @return nullptr if nothing is visible at @p time
+     */
+    [[nodiscard]] const Segment* segmentAt(Timestamp time) const {
+        auto it = std::upper_bound(m_segments.begin(), m_segments.end(), time,
+            [](Timestamp t, const Segment& s) { return t < s.start; });
+        if (it == m_segments.begin()) return nullptr;
+        --it;
+        return time < it->end ? &*it : nullptr;
+    }
+
+    /// Layers of a segment, bottom to top
+    [[nodiscard]] std::span<const Layer> layers(const Segment& segment) const {
+        return {m_layers.data() + segment.firstLayer, segment.layerCount};
+    }
+
+    [[nodiscard]] const std::vector<Segment>& segments() const { return m_segments; }
+
+    /// Snapshot the plan was compiled from
+    [[nodiscard]] const SnapshotPtr& snapshot() const { return m_snapshot; }
+    [[nodiscard]] uint64_t revision() const { return m_revision; }
+
+    /// Total layers across all segments
+    [[nodiscard]] size_t layerCount() const { return m_layers.size(); }
+
+    /// Segments compiled (rather than copied) by build()
+    [[nodiscard]] size_t compiledSegments() const { return m_compiledSegments; }
+
+private:
+    /**
+     * @brief Check if two snapshots stack the same visible tracks
+     */
+    static bool sameTrackLayout(const model::SequenceSnapshot& a,
+                                const model::SequenceSnapshot& b) {
+        const auto& ta = a.videoTracks();
+        const auto& tb = b.videoTracks();
+        if (ta.size() != tb.size()) return false;
+        for (size_t i = 0; i < ta.size(); ++i) {
+            if (ta[i]->id() != tb[i]->id() ||
+                ta[i]->hidden() != tb[i]->hidden() ||
+                ta[i]->muted() != tb[i]->muted()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Time ranges covered by clips that differ between snapshots
+     *
+     * Unchanged tracks and clips are shared between snapshots, so
+     * pointer identity finds the edits. Both the old and the new
+     * extents of a changed clip count, as separate ranges, so a clip
+     * moved far away does not dirty everything in between.
+     *
+     * @return Sorted, merged, non-empty ranges
+     */
+    static std::vector<std::pair<Timestamp, Timestamp>> changedRanges(
+        const model::SequenceSnapshot& prev,
+        const model::SequenceSnapshot& next)
+    {
+        std::vector<std::pair<Timestamp, Timestamp>> ranges;
+        auto extend = [&](const model::Clip& clip) {
+            if (clip.timelineIn() < clip.timelineOut()) {
+                ranges.emplace_back(clip.timelineIn(), clip.timelineOut());
+            }
+        };
+
+        const auto& prevTracks = prev.videoTracks();
+        const auto& nextTracks = next.videoTracks();
+        for (size_t i = 0; i < nextTracks.size(); ++i) {
+            if (prevTracks[i] == nextTracks[i]) continue;
+
+            const auto& oldClips = prevTracks[i]->clips();
+            const auto& newClips = nextTracks[i]->clips();
+
+            std::unordered_set<const model::Clip*> oldSet;
+            oldSet.reserve(oldClips.size());
+            for (const auto& clip : oldClips) oldSet.insert(clip.get());
+
+            for (const auto& clip : newClips) {
+                if (oldSet.erase(clip.get()) == 0) extend(*clip);
+            }
+            for (const auto* clip : oldSet) extend(*clip);
+        }
+
+        std::sort(ranges.begin(), ranges.end());
+        size_t merged = 0;
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (merged > 0 && ranges[i].first <= ranges[merged - 1].second) {
+                ranges[merged - 1].second = std::max(ranges[merged - 1].second, ranges[i].second);
+            } else {
+                ranges[merged++] = ranges[i];
+            }
+        }
+        ranges.resize(merged);
+        return ranges;
+    }
+
+    /**
+     * @brief Compile the segments of [lo, hi), appending them
+     */
+    void compileRange(Timestamp lo, Timestamp hi) {
+        const auto& tracks = m_snapshot->videoTracks();
+
+        // Every clip edge inside the range starts a segment
+        std::vector<Timestamp> cuts{lo, hi};
+        for (const auto& track : tracks) {
+            if (track->hidden() || track->muted()) continue;
+
+            const auto& clips = track->clips();
+            auto it = std::upper_bound(clips.begin(), clips.end(), lo,
+                [](Timestamp t, const auto& c) { return t < c->timelineIn(); });
+            if (it != clips.begin()) --it;
+            for (; it != clips.end() && (*it)->timelineIn() < hi; ++it) {
+                if ((*it)->disabled()) continue;
+                if ((*it)->timelineIn() > lo) cuts.push_back((*it)->timelineIn());
+                if ((*it)->timelineOut() > lo && (*it)->timelineOut() < hi) {
+                    cuts.push_back((*it)->timelineOut());
+                }
+            }
+        }
+        std::sort(cuts.begin(), cuts.end());
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+        for (size_t c = 0; c + 1 < cuts.size(); ++c) {
+            Segment segment;
+            segment.start = cuts[c];
+            segment.end = cuts[c + 1];
+            segment.firstLayer = static_cast<uint32_t>(m_layers.size());
+
+            // Same culling as a per-frame walk at segment.start
+            for (size_t i = 0; i < tracks.size(); ++i) {
+                const auto& track = tracks[i];
+                if (track->hidden() || track->muted()) continue;
+
+                auto clip = track->getClipAt(segment.start);
+                if (!clip || clip->disabled()) continue;
+
+                m_layers.push_back({clip.get(), static_cast<int>(i)});
+                segment.hasNests = segment.hasNests || clip->isNested();
+            }
+
+            segment.layerCount = static_cast<uint32_t>(m_layers.size()) - segment.firstLayer;
+            if (segment.layerCount > 0) m_segments.push_back(segment);
+        }
+    }
+
+    /**
+     * @brief Append a segment of an earlier plan (its clips are unchanged)
+     */
+    void copySegment(const RenderPlan& prev, const Segment& segment) {
+        Segment copy = segment;
+        copy.firstLayer = static_cast<uint32_t>(m_layers.size());
+        auto source = prev.layers(segment);
+        m_layers.insert(m_layers.end(), source.begin(), source.end());
+        m_segments.push_back(copy);
+    }
+
+    SnapshotPtr m_snapshot;
+    uint64_t m_revision = 0;
+    std::vector<Segment> m_segments;    // Sorted, non-overlapping
+    std::vector<Layer> m_layers;
+    size_t m_compiledSegments = 0;
+};
+
+} // namespace phoenix::engine
@@ -111,6 +111,20 @@ public:
      */
     Result<VideoFrame, Error> decodeVideoFrame(Timestamp time);
     
+    /**
+     * @brief Decode the keyframe at or before a time
+     *  
+     * Like decodeVideoFrame() without decoding on from the keyframe
+     * to the target: a cheap approximation for scrubbing. The frame's
+     * pts() tells which frame it is. When the decoder is already a
+     * few frames before the target, it decodes on to the exact frame,
+     * which is as cheap.
+     *  
+     * @param time Target time in microseconds
+     * @return Decoded frame or error
+     */
+    Result<VideoFrame, Error> decodeKeyFrame(Timestamp time);
+    
     /**
      * @brief Decode next sequential video frame
      * 
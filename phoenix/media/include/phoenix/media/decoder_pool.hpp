@@ -62,11 +62,12 @@ private:
     friend class DecoderPool;
     
     PooledDecoder(std::unique_ptr<Decoder> decoder, class DecoderPool* pool,
-                  const std::filesystem::path& path);
+                  const std::filesystem::path& path, uint64_t generation);
     
     std::unique_ptr<Decoder> m_decoder;
     DecoderPool* m_pool = nullptr;
     std::filesystem::path m_path;
+    uint64_t m_generation = 0;  // Pool generation when acquired
 };
 
 /**
@@ -111,11 +112,31 @@ public:
     Result<VideoFrame, Error> decodeFrame(
         const std::filesystem::path& path, Timestamp time);
     
+    /**
+     * @brief Decode the keyframe at or before a time (convenience method)
+     *  
+     * See Decoder::decodeKeyFrame().
+     *  
+     * @param path Path to media file
+     * @param time Target time
+     * @return Decoded frame or error
+     */
+    Result<VideoFrame, Error> decodeKeyFrame(
+        const std::filesystem::path& path, Timestamp time);
+    
     /**
      * @brief Clear all pooled decoders
      */
     void clear();
     
+    /**
+     * @brief Drop decoders for a file that changed on disk
+     * 
+     * Pooled decoders are destroyed now; decoders in use are
+     * destroyed instead of pooled when they are returned.
+     */
+    void invalidate(const std::filesystem::path& path);
+    
     /**
      * @brief Clear idle decoders
      * 
@@ -146,7 +167,7 @@ private:
     
     /// Return a decoder to the pool
     void release(std::unique_ptr<Decoder> decoder, 
-                 const std::filesystem::path& path);
+                 const std::filesystem::path& path, uint64_t generation);
     
     struct PoolEntry {
         std::unique_ptr<Decoder> decoder;
@@ -158,6 +179,10 @@ private:
     // Pool storage: path -> list of available decoders
     std::unordered_map<std::string, std::list<PoolEntry>> m_pool;
     
+    // Invalidation: path -> generation it was last invalidated at
+    std::unordered_map<std::string, uint64_t> m_invalidated;
+    uint64_t m_generation = 0;
+    
     mutable std::mutex m_mutex;
     
     // Statistics
@@ -240,13 +240,15 @@ struct Decoder::Impl {
         activeHWType = HWAccelType::None;
     }
     
-    Result<VideoFrame, Error> decodeVideo(Timestamp targetTime, bool sequential) {
+    Result<VideoFrame, Error> decodeVideo(Timestamp targetTime, bool sequential,
+                                          bool keyFrameOnly = false) {
         if (!videoCodecCtx || videoStreamIdx < 0) {
             return Error(ErrorCode::NotSupported, "No video stream");
         }
         
         AVStream* stream = formatCtx->streams[videoStreamIdx];
         auto startTime = std::chrono::steady_clock::now();
+        bool seeked = false;
         
         // Seek if needed (for random access)
         if (!sequential && targetTime != kNoTimestamp) {
@@ -266,9 +268,14 @@ struct Decoder::Impl {
                 avcodec_flush_buffers(videoCodecCtx);
                 videoEOF = false;
                 ++stats.seekCount;
+                seeked = true;
             }
         }
         
+        // After a seek, a keyframe-only decode takes the first frame
+        bool decodeToTarget = !sequential && targetTime != kNoTimestamp &&
+            !(keyFrameOnly && seeked);
+        
         // Decode loop
         while (!videoEOF) {
             // Try to receive frame
@@ -281,8 +288,7 @@ struct Decoder::Impl {
                     decodedFrame->pts, stream->time_base);
                 
                 // For random access, skip frames before target
-                if (!sequential && targetTime != kNoTimestamp && 
-                    pts < targetTime) {
+                if (decodeToTarget && pts < targetTime) {
                     // Check if this is close enough (within one frame)
                     Duration frameDur = av_rescale_q(1, 
                         av_inv_q(stream->avg_frame_rate), {1, 1000000});
@@ -477,6 +483,10 @@ Result<VideoFrame, Error> Decoder::decodeVideoFrame(Timestamp time) {
     return m_impl->decodeVideo(time, false);
 }
 
+Result<VideoFrame, Error> Decoder::decodeKeyFrame(Timestamp time) {
+    return m_impl->decodeVideo(time, false, true);
+}
+
 Result<VideoFrame, Error> Decoder::decodeNextVideoFrame() {
     return m_impl->decodeVideo(kNoTimestamp, true);
 }
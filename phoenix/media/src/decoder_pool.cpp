@@ -13,15 +13,17 @@ namespace phoenix::media {
 
 PooledDecoder::PooledDecoder(std::unique_ptr<Decoder> decoder, 
                              DecoderPool* pool,
-                             const std::filesystem::path& path)
+                             const std::filesystem::path& path,
+                             uint64_t generation)
     : m_decoder(std::move(decoder))
     , m_pool(pool)
     , m_path(path)
+    , m_generation(generation)
 {}
 
 PooledDecoder::~PooledDecoder() {
     if (m_decoder && m_pool) {
-        m_pool->release(std::move(m_decoder), m_path);
+        m_pool->release(std::move(m_decoder), m_path, m_generation);
     }
 }
 
@@ -29,6 +31,7 @@ PooledDecoder::PooledDecoder(PooledDecoder&& other) noexcept
     : m_decoder(std::move(other.m_decoder))
     , m_pool(other.m_pool)
     , m_path(std::move(other.m_path))
+    , m_generation(other.m_generation)
 {
     other.m_pool = nullptr;
 }
@@ -37,12 +40,13 @@ PooledDecoder& PooledDecoder::operator=(PooledDecoder&& other) noexcept {
     if (this != &other) {
         // Release current decoder first
         if (m_decoder && m_pool) {
-            m_pool->release(std::move(m_decoder), m_path);
+            m_pool->release(std::move(m_decoder), m_path, m_generation);
         }
         
         m_decoder = std::move(other.m_decoder);
         m_pool = other.m_pool;
         m_path = std::move(other.m_path);
+        m_generation = other.m_generation;
         other.m_pool = nullptr;
     }
     return *this;
@@ -85,7 +89,7 @@ Result<PooledDecoder, Error> DecoderPool::acquire(
         // Seek to start for clean state
         decoder->seekToStart();
         
-        return PooledDecoder(std::move(decoder), this, path);
+        return PooledDecoder(std::move(decoder), this, path, m_generation);
     }
     
     // Create new decoder
@@ -105,11 +109,12 @@ Result<PooledDecoder, Error> DecoderPool::acquire(
         return result.error();
     }
     
-    return PooledDecoder(std::move(decoder), this, path);
+    return PooledDecoder(std::move(decoder), this, path, m_generation);
 }
 
 void DecoderPool::release(std::unique_ptr<Decoder> decoder,
-                          const std::filesystem::path& path)
+                          const std::filesystem::path& path,
+                          uint64_t generation)
 {
     if (!decoder) return;
     
@@ -119,6 +124,12 @@ void DecoderPool::release(std::unique_ptr<Decoder> decoder,
     
     --m_activeCount;
     
+    // The file changed while this decoder was out
+    auto invalidIt = m_invalidated.find(pathKey);
+    if (invalidIt != m_invalidated.end() && invalidIt->second > generation) {
+        return;
+    }
+    
     // Check if we should pool this decoder
     auto& list = m_pool[pathKey];
     
@@ -176,11 +187,31 @@ Result<VideoFrame, Error> DecoderPool::decodeFrame(
     return decoder->decodeVideoFrame(time);
 }
 
+Result<VideoFrame, Error> DecoderPool::decodeKeyFrame(
+    const std::filesystem::path& path, Timestamp time)
+{
+    auto decoderResult = acquire(path);
+    if (!decoderResult.ok()) {
+        return decoderResult.error();
+    }
+    
+    auto& decoder = decoderResult.value();
+    return decoder->decodeKeyFrame(time);
+}
+
 void DecoderPool::clear() {
     std::lock_guard lock(m_mutex);
     m_pool.clear();
 }
 
+void DecoderPool::invalidate(const std::filesystem::path& path) {
+    std::string pathKey = path.string();
+    
+    std::lock_guard lock(m_mutex);
+    m_pool.erase(pathKey);
+    m_invalidated[pathKey] = ++m_generation;
+}
+
 void DecoderPool::clearIdle() {
     auto now = std::chrono::steady_clock::now();
     auto timeout = std::chrono::milliseconds(m_config.idleTimeoutMs);
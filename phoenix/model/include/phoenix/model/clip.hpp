@@ -26,6 +26,7 @@ enum class ClipType {
     Audio,      // Audio-only clip
     Title,      // Text/graphics generator
     Adjustment, // Adjustment layer
+    Sequence,   // Nested sequence (compound clip)
 };
 
 /**
@@ -42,6 +43,9 @@ enum class ClipType {
  * Source coordinates:
  * - sourceIn: Start position in source media
  * - sourceOut: End position in source media
+ * 
+ * A nested clip (ClipType::Sequence) uses another sequence as its
+ * source; source coordinates are then times in that sequence.
  */
 class Clip {
 public:
@@ -66,6 +70,27 @@ public:
     [[nodiscard]] const UUID& mediaItemId() const { return m_mediaItemId; }
     void setMediaItemId(const UUID& id) { m_mediaItemId = id; }
     
+    /**
+     * @brief Check if this clip nests another sequence
+     */
+    [[nodiscard]] bool isNested() const { return m_type == ClipType::Sequence; }
+    
+    /**
+     * @brief Nested sequence ID (nested clips only)
+     * 
+     * Stored in the source reference slot, so nested clips are
+     * saved exactly like media clips.
+     */
+    [[nodiscard]] UUID sequenceId() const {
+        return isNested() ? m_mediaItemId : UUID();
+    }
+    
+    /// Make this clip nest a sequence
+    void setSequenceId(const UUID& id) {
+        m_type = ClipType::Sequence;
+        m_mediaItemId = id;
+    }
+    
     /// Display name (optional, uses media name if empty)
     [[nodiscard]] const std::string& name() const { return m_name; }
     void setName(const std::string& name) { m_name = name; }
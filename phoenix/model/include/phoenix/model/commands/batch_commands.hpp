@@ -0,0 +1,415 @@
+/**
+ * @file batch_commands.hpp
+ * @brief Commands that edit many clips at once
+ * 
+ * Multi-move, ripple and slip over large selections. Each command
+ * applies its edits with one Track::applyPlacements() pass per
+ * track, commits a single SequenceChange and undoes as one unit.
+ * Undo state is a compact list of old/new placements per clip
+ * rather than one command per clip.
+ */
+
+#pragma once
+
+#include <phoenix/model/commands/clip_commands.hpp>
+#include <phoenix/model/sequence.hpp>
+#include <phoenix/model/track.hpp>
+#include <phoenix/core/types.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+namespace phoenix::model {
+
+// ============================================================================
+// ClipBatchCommand
+// ============================================================================
+
+/**
+ * @brief Base for commands that reposition many clips
+ * 
+ * Subclasses plan the edit from the current sequence state on first
+ * execution; redo and undo replay the stored placements. If any
+ * track rejects its edit (overlap), tracks already edited are
+ * rolled back and the command does nothing.
+ */
+class ClipBatchCommand : public Command {
+public:
+    void execute() override {
+        bool first = !m_planned;
+        if (first) {
+            plan();
+            m_planned = true;
+        }
+        m_applied = apply(true);
+        if (first) {
+            m_obsolete = !m_applied;
+        }
+    }
+    
+    void undo() override {
+        if (m_applied) {
+            apply(false);
+            m_applied = false;
+        }
+    }
+    
+    void redo() override {
+        m_applied = apply(true);
+    }
+    
+    [[nodiscard]] size_t memoryUsage() const override {
+        size_t bytes = sizeof(*this) + m_edits.capacity() * sizeof(TrackEdit);
+        for (const auto& edit : m_edits) {
+            bytes += (edit.before.capacity() + edit.after.capacity()) * sizeof(ClipPlacement);
+        }
+        return bytes;
+    }
+    
+    /// A first execution that changed nothing leaves no undo step
+    [[nodiscard]] bool isObsolete() const override { return m_obsolete; }
+    
+    /// Whether the last execute/redo changed anything
+    [[nodiscard]] bool applied() const { return m_applied; }
+    
+    /// Number of clips the command edits
+    [[nodiscard]] size_t clipCount() const {
+        size_t count = 0;
+        for (const auto& edit : m_edits) count += edit.after.size();
+        return count;
+    }
+    
+protected:
+    /// Old and new placements of the clips on one track
+    struct TrackEdit {
+        UUID trackId;
+        std::vector<ClipPlacement> before;
+        std::vector<ClipPlacement> after;
+    };
+    
+    explicit ClipBatchCommand(Sequence& sequence)
+        : m_sequence(sequence) {}
+    
+    /// Fill m_edits from the current sequence state
+    virtual void plan() = 0;
+    
+    /// Edit for a track, created on first use
+    TrackEdit& editFor(const UUID& trackId) {
+        for (auto& edit : m_edits) {
+            if (edit.trackId == trackId) return edit;
+        }
+        m_edits.push_back({trackId, {}, {}});
+        return m_edits.back();
+    }
+    
+    /// Add a clip edit: current placement plus its replacement
+    void addEdit(const UUID& trackId, const Clip& clip, const ClipPlacement& after) {
+        auto& edit = editFor(trackId);
+        edit.before.push_back(ClipPlacement::of(clip));
+        edit.after.push_back(after);
+    }
+    
+    /**
+     * @brief Find each clip's owning track
+     * 
+     * Unknown IDs and clips on locked tracks are skipped.
+     */
+    [[nodiscard]] std::vector<std::pair<Sequence::TrackPtr, Sequence::ClipPtr>>
+    resolveClips(const std::vector<UUID>& clipIds) const {
+        std::vector<std::pair<Sequence::TrackPtr, Sequence::ClipPtr>> result;
+        result.reserve(clipIds.size());
+        
+        auto resolve = [&](const std::vector<Sequence::TrackPtr>& tracks, const UUID& id) {
+            for (const auto& track : tracks) {
+                if (auto clip = track->getClip(id)) {
+                    if (!track->locked()) result.emplace_back(track, clip);
+                    return true;
+                }
+            }
+            return false;
+        };
+        
+        std::unordered_set<UUID> seen;
+        seen.reserve(clipIds.size());
+        for (const auto& id : clipIds) {
+            if (!seen.insert(id).second) continue;
+            resolve(m_sequence.videoTracks(), id) || resolve(m_sequence.audioTracks(), id);
+        }
+        return result;
+    }
+    
+    Sequence& m_sequence;
+    std::vector<TrackEdit> m_edits;
+    
+private:
+    /**
+     * @brief Apply all tracks' new (or old) placements
+     * 
+     * @return true if every track accepted its edit
+     */
+    bool apply(bool forward) {
+        if (m_edits.empty()) return false;
+        
+        size_t done = 0;
+        for (; done < m_edits.size(); ++done) {
+            const auto& edit = m_edits[done];
+            auto track = m_sequence.getTrack(edit.trackId);
+            if (!track || !track->applyPlacements(forward ? edit.after : edit.before)) {
+                break;
+            }
+        }
+        
+        if (done < m_edits.size()) {
+            // Roll back tracks edited so far
+            while (done-- > 0) {
+                const auto& edit = m_edits[done];
+                if (auto track = m_sequence.getTrack(edit.trackId)) {
+                    track->applyPlacements(forward ? edit.before : edit.after);
+                }
+            }
+            return false;
+        }
+        
+        m_sequence.commitChange(batchChange());
+        return true;
+    }
+    
+    /// One change covering every clip's old and new span
+    [[nodiscard]] SequenceChange batchChange() const {
+        SequenceChange change;
+        size_t clipCount = 0;
+        for (const auto& edit : m_edits) clipCount += edit.after.size();
+        change.trackIds.reserve(m_edits.size());
+        change.clipIds.reserve(clipCount);
+        
+        for (const auto& edit : m_edits) {
+            change.addTrack(edit.trackId);
+            for (size_t i = 0; i < edit.after.size(); ++i) {
+                const auto& before = edit.before[i];
+                const auto& after = edit.after[i];
+                change.addRange(before.timelineIn, before.timelineOut);
+                change.addRange(after.timelineIn, after.timelineOut);
+                // Clip IDs are unique across the batch; skip addClip's scan
+                change.clipIds.push_back(after.clipId);
+            }
+        }
+        return change;
+    }
+    
+    bool m_planned = false;
+    bool m_applied = false;
+    bool m_obsolete = false;
+};
+
+// ============================================================================
+// MoveClipsCommand
+// ============================================================================
+
+/**
+ * @brief Move a selection of clips by the same offset
+ * 
+ * Clips stay on their tracks. The offset is clamped so no clip
+ * starts before zero; a move clamped to nothing is not pushed to the
+ * undo stack. Successive drags of the same selection merge into one
+ * undo step.
+ */
+class MoveClipsCommand : public ClipBatchCommand {
+public:
+    MoveClipsCommand(Sequence& sequence, std::vector<UUID> clipIds, Duration offset)
+        : ClipBatchCommand(sequence)
+        , m_clipIds(std::move(clipIds))
+        , m_offset(offset) {}
+    
+    [[nodiscard]] std::string description() const override {
+        return "Move Clips";
+    }
+    
+    [[nodiscard]] int id() const override {
+        return static_cast<int>(CommandId::MoveClips);
+    }
+    
+    bool mergeWith(const Command* other) override {
+        auto* moveCmd = dynamic_cast<const MoveClipsCommand*>(other);
+        if (!moveCmd || !moveCmd->applied() || !applied()) return false;
+        if (moveCmd->m_clipIds != m_clipIds) return false;
+        if (moveCmd->m_edits.size() != m_edits.size()) return false;
+        
+        // Keep our "before", take the other drag's "after"
+        for (size_t i = 0; i < m_edits.size(); ++i) {
+            if (moveCmd->m_edits[i].trackId != m_edits[i].trackId ||
+                moveCmd->m_edits[i].after.size() != m_edits[i].after.size()) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < m_edits.size(); ++i) {
+            m_edits[i].after = moveCmd->m_edits[i].after;
+        }
+        m_offset += moveCmd->m_offset;
+        return true;
+    }
+    
+protected:
+    void plan() override {
+        auto clips = resolveClips(m_clipIds);
+        
+        Duration offset = m_offset;
+        for (const auto& [track, clip] : clips) {
+            offset = std::max(offset, -clip->timelineIn());
+        }
+        m_offset = offset;
+        if (offset == 0) return;
+        
+        for (const auto& [track, clip] : clips) {
+            auto after = ClipPlacement::of(*clip);
+            after.timelineIn += offset;
+            after.timelineOut += offset;
+            addEdit(track->id(), *clip, after);
+        }
+    }
+    
+private:
+    std::vector<UUID> m_clipIds;
+    Duration m_offset;
+};
+
+// ============================================================================
+// RippleCommand
+// ============================================================================
+
+/**
+ * @brief Shift everything at or after a point by an offset
+ * 
+ * Opens (positive offset) or closes (negative offset) a gap in the
+ * timeline. Applies to the given tracks, or to every unlocked track
+ * when none are given. A negative offset is clamped so the earliest
+ * shifted clip stops at zero. Closing a gap fails as a whole if clips
+ * would collide with clips before @p from.
+ */
+class RippleCommand : public ClipBatchCommand {
+public:
+    RippleCommand(Sequence& sequence, Timestamp from, Duration offset,
+                  std::vector<UUID> trackIds = {})
+        : ClipBatchCommand(sequence)
+        , m_from(from)
+        , m_offset(offset)
+        , m_trackIds(std::move(trackIds)) {}
+    
+    [[nodiscard]] std::string description() const override {
+        return "Ripple";
+    }
+    
+protected:
+    void plan() override {
+        if (m_offset == 0) return;
+        
+        // Clips are sorted; the shifted ones are a suffix of each track
+        std::vector<std::pair<Sequence::TrackPtr, size_t>> suffixes;
+        auto findSuffix = [&](const Sequence::TrackPtr& track) {
+            if (track->locked()) return;
+            if (!m_trackIds.empty() &&
+                std::find(m_trackIds.begin(), m_trackIds.end(), track->id()) == m_trackIds.end()) {
+                return;
+            }
+            
+            const auto& clips = track->clips();
+            auto first = std::lower_bound(clips.begin(), clips.end(), m_from,
+                [](const Track::ClipPtr& c, Timestamp t) { return c->timelineIn() < t; });
+            if (first != clips.end()) {
+                suffixes.emplace_back(track, static_cast<size_t>(first - clips.begin()));
+            }
+        };
+        
+        for (const auto& track : m_sequence.videoTracks()) findSuffix(track);
+        for (const auto& track : m_sequence.audioTracks()) findSuffix(track);
+        
+        Duration offset = m_offset;
+        for (const auto& [track, first] : suffixes) {
+            offset = std::max(offset, -track->clips()[first]->timelineIn());
+        }
+        m_offset = offset;
+        if (offset == 0) return;
+        
+        for (const auto& [track, first] : suffixes) {
+            const auto& clips = track->clips();
+            for (size_t i = first; i < clips.size(); ++i) {
+                auto after = ClipPlacement::of(*clips[i]);
+                after.timelineIn += offset;
+                after.timelineOut += offset;
+                addEdit(track->id(), *clips[i], after);
+            }
+        }
+    }
+    
+private:
+    Timestamp m_from;
+    Duration m_offset;
+    std::vector<UUID> m_trackIds;
+};
+
+// ============================================================================
+// SlipClipsCommand
+// ============================================================================
+
+/**
+ * @brief Slip the source range of a selection of clips
+ * 
+ * Timeline positions stay put; each clip shows a different part of
+ * its media. Clips whose source would start before zero are clamped
+ * to zero. Successive slips of the same selection merge.
+ */
+class SlipClipsCommand : public ClipBatchCommand {
+public:
+    SlipClipsCommand(Sequence& sequence, std::vector<UUID> clipIds, Duration offset)
+        : ClipBatchCommand(sequence)
+        , m_clipIds(std::move(clipIds))
+        , m_offset(offset) {}
+    
+    [[nodiscard]] std::string description() const override {
+        return "Slip Clips";
+    }
+    
+    [[nodiscard]] int id() const override {
+        return static_cast<int>(CommandId::SlipClips);
+    }
+    
+    bool mergeWith(const Command* other) override {
+        auto* slipCmd = dynamic_cast<const SlipClipsCommand*>(other);
+        if (!slipCmd || !slipCmd->applied() || !applied()) return false;
+        if (slipCmd->m_clipIds != m_clipIds) return false;
+        if (slipCmd->m_edits.size() != m_edits.size()) return false;
+        
+        for (size_t i = 0; i < m_edits.size(); ++i) {
+            if (slipCmd->m_edits[i].trackId != m_edits[i].trackId ||
+                slipCmd->m_edits[i].after.size() != m_edits[i].after.size()) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < m_edits.size(); ++i) {
+            m_edits[i].after = slipCmd->m_edits[i].after;
+        }
+        return true;
+    }
+    
+protected:
+    void plan() override {
+        if (m_offset == 0) return;
+        
+        for (const auto& [track, clip] : resolveClips(m_clipIds)) {
+            Duration offset = std::max(m_offset, -clip->sourceIn());
+            if (offset == 0) continue;
+            
+            auto after = ClipPlacement::of(*clip);
+            after.sourceIn += offset;
+            after.sourceOut += offset;
+            addEdit(track->id(), *clip, after);
+        }
+    }
+    
+private:
+    std::vector<UUID> m_clipIds;
+    Duration m_offset;
+};
+
+} // namespace phoenix::model
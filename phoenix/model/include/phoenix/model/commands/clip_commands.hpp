@@ -11,6 +11,7 @@
 #include <phoenix/model/clip.hpp>
 #include <phoenix/model/track.hpp>
 #include <phoenix/model/sequence.hpp>
+#include <phoenix/model/sequence_change.hpp>
 #include <phoenix/core/types.hpp>
 
 #include <memory>
@@ -18,6 +19,26 @@
 
 namespace phoenix::model {
 
+/**
+ * @brief Build the change record for a single clip edit
+ */
+inline SequenceChange clipChange(const UUID& trackId, const UUID& clipId,
+                                 Timestamp start, Timestamp end) {
+    SequenceChange change;
+    change.addRange(start, end);
+    change.addTrack(trackId);
+    change.addClip(clipId);
+    return change;
+}
+
+/**
+ * @brief Memory kept alive by a clip held for undo
+ */
+inline size_t clipMemoryUsage(const std::shared_ptr<Clip>& clip) {
+    if (!clip) return 0;
+    return sizeof(Clip) + clip->name().capacity();
+}
+
 /**
  * @brief Command IDs for merging
  */
@@ -26,6 +47,8 @@ enum class CommandId : int {
     MoveClip = 1,
     TrimClipStart = 2,
     TrimClipEnd = 3,
+    MoveClips = 4,
+    SlipClips = 5,
 };
 
 // ============================================================================
@@ -45,13 +68,19 @@ public:
     
     void execute() override {
         if (auto track = m_sequence.getTrack(m_trackId)) {
-            track->addClip(m_clip);
+            if (track->addClip(m_clip)) {
+                m_sequence.commitChange(clipChange(m_trackId, m_clipId,
+                    m_clip->timelineIn(), m_clip->timelineOut()));
+            }
         }
     }
     
     void undo() override {
         if (auto track = m_sequence.getTrack(m_trackId)) {
-            track->removeClip(m_clipId);
+            if (track->removeClip(m_clipId)) {
+                m_sequence.commitChange(clipChange(m_trackId, m_clipId,
+                    m_clip->timelineIn(), m_clip->timelineOut()));
+            }
         }
     }
     
@@ -59,6 +88,10 @@ public:
         return "Add Clip";
     }
     
+    [[nodiscard]] size_t memoryUsage() const override {
+        return sizeof(*this) + clipMemoryUsage(m_clip);
+    }
+    
 private:
     Sequence& m_sequence;
     UUID m_trackId;
@@ -84,14 +117,20 @@ public:
         if (auto track = m_sequence.getTrack(m_trackId)) {
             // Save clip for undo
             m_savedClip = track->getClip(m_clipId);
-            track->removeClip(m_clipId);
+            if (track->removeClip(m_clipId)) {
+                m_sequence.commitChange(clipChange(m_trackId, m_clipId,
+                    m_savedClip->timelineIn(), m_savedClip->timelineOut()));
+            }
         }
     }
     
     void undo() override {
         if (m_savedClip) {
             if (auto track = m_sequence.getTrack(m_trackId)) {
-                track->addClip(m_savedClip);
+                if (track->addClip(m_savedClip)) {
+                    m_sequence.commitChange(clipChange(m_trackId, m_clipId,
+                        m_savedClip->timelineIn(), m_savedClip->timelineOut()));
+                }
             }
         }
     }
@@ -100,6 +139,10 @@ public:
         return "Delete Clip";
     }
     
+    [[nodiscard]] size_t memoryUsage() const override {
+        return sizeof(*this) + clipMemoryUsage(m_savedClip);
+    }
+    
 private:
     Sequence& m_sequence;
     UUID m_trackId;
@@ -139,7 +182,7 @@ public:
         
         if (m_sourceTrackId == m_destTrackId) {
             // Same track - use moveClip which handles overlap check
-            sourceTrack->moveClip(m_clipId, m_newPosition);
+            if (!sourceTrack->moveClip(m_clipId, m_newPosition)) return;
         } else {
             // Different track - remove from source, add to dest
             auto destTrack = m_sequence.getTrack(m_destTrackId);
@@ -152,6 +195,8 @@ public:
             sourceTrack->removeClip(m_clipId);
             destTrack->addClip(clip);
         }
+        
+        m_sequence.commitChange(moveChange(clip->duration()));
     }
     
     void undo() override {
@@ -176,12 +221,18 @@ public:
             currentTrack->removeClip(m_clipId);
             sourceTrack->addClip(clip);
         }
+        
+        m_sequence.commitChange(moveChange(clip->duration()));
     }
     
     [[nodiscard]] std::string description() const override {
         return "Move Clip";
     }
     
+    [[nodiscard]] size_t memoryUsage() const override {
+        return sizeof(*this);
+    }
+    
     [[nodiscard]] int id() const override {
         return static_cast<int>(CommandId::MoveClip);
     }
@@ -198,6 +249,15 @@ public:
     }
     
 private:
+    /// Old and new spans of the clip on both tracks
+    [[nodiscard]] SequenceChange moveChange(Duration dur) const {
+        auto change = clipChange(m_sourceTrackId, m_clipId,
+                                 m_oldPosition, m_oldPosition + dur);
+        change.addRange(m_newPosition, m_newPosition + dur);
+        change.addTrack(m_destTrackId);
+        return change;
+    }
+    
     Sequence& m_sequence;
     UUID m_sourceTrackId;
     UUID m_destTrackId;
@@ -229,29 +289,45 @@ public:
         , m_newBoundary(newBoundary) {}
     
     void execute() override {
+        bool first = !m_executed;
+        m_executed = true;
+        m_applied = false;
+        
         auto track = m_sequence.getTrack(m_trackId);
         if (!track) return;
         
         auto clip = track->getClip(m_clipId);
         if (!clip) return;
         
+        Timestamp oldBoundary = m_edge == Edge::Start ? clip->timelineIn() : clip->timelineOut();
+        Timestamp oldSourceIn = clip->sourceIn();
+        
+        // The track stops the edge at the neighbouring clip
+        auto boundary = m_edge == Edge::Start
+            ? track->trimClipStart(m_clipId, m_newBoundary)
+            : track->trimClipEnd(m_clipId, m_newBoundary);
+        if (!boundary || *boundary == oldBoundary) {
+            if (first) m_obsolete = true;
+            return;
+        }
+        
+        m_oldBoundary = oldBoundary;
+        m_oldSourceIn = oldSourceIn;
+        m_newBoundary = *boundary;
+        m_applied = true;
+        
         if (m_edge == Edge::Start) {
-            m_oldBoundary = clip->timelineIn();
-            m_oldSourceIn = clip->sourceIn();
-            
-            // Calculate source offset change
-            Duration delta = m_newBoundary - clip->timelineIn();
-            
-            clip->setTimelineIn(m_newBoundary);
-            clip->setSourceIn(clip->sourceIn() + delta);
-            // timelineOut stays the same, so duration shrinks
-        } else {
-            m_oldBoundary = clip->timelineOut();
-            clip->setTimelineOut(m_newBoundary);
+            // timelineOut stays the same, so the source shifts with the start
+            clip->setSourceIn(oldSourceIn + (m_newBoundary - oldBoundary));
         }
+        
+        m_sequence.commitChange(trimChange(*clip));
     }
     
     void undo() override {
+        if (!m_applied) return;
+        m_applied = false;
+        
         auto track = m_sequence.getTrack(m_trackId);
         if (!track) return;
         
@@ -259,17 +335,26 @@ public:
         if (!clip) return;
         
         if (m_edge == Edge::Start) {
-            clip->setTimelineIn(m_oldBoundary);
+            track->trimClipStart(m_clipId, m_oldBoundary);
             clip->setSourceIn(m_oldSourceIn);
         } else {
-            clip->setTimelineOut(m_oldBoundary);
+            track->trimClipEnd(m_clipId, m_oldBoundary);
         }
+        
+        m_sequence.commitChange(trimChange(*clip));
     }
     
     [[nodiscard]] std::string description() const override {
         return m_edge == Edge::Start ? "Trim Clip Start" : "Trim Clip End";
     }
     
+    [[nodiscard]] size_t memoryUsage() const override {
+        return sizeof(*this);
+    }
+    
+    /// A first trim that moved nothing (blocked by a neighbour) leaves no undo step
+    [[nodiscard]] bool isObsolete() const override { return m_obsolete; }
+    
     [[nodiscard]] int id() const override {
         return m_edge == Edge::Start 
             ? static_cast<int>(CommandId::TrimClipStart)
@@ -287,6 +372,21 @@ public:
     }
     
 private:
+    /**
+     * @brief Region between old and new boundary
+     * 
+     * A start trim also shifts the source mapping, so the rest of
+     * the clip is included for that edge.
+     */
+    [[nodiscard]] SequenceChange trimChange(const Clip& clip) const {
+        Timestamp lo = std::min(m_oldBoundary, m_newBoundary);
+        Timestamp hi = std::max(m_oldBoundary, m_newBoundary);
+        if (m_edge == Edge::Start) {
+            hi = std::max(hi, clip.timelineOut());
+        }
+        return clipChange(m_trackId, m_clipId, lo, hi);
+    }
+    
     Sequence& m_sequence;
     UUID m_trackId;
     UUID m_clipId;
@@ -294,6 +394,9 @@ private:
     Timestamp m_newBoundary;
     Timestamp m_oldBoundary{0};
     Timestamp m_oldSourceIn{0};
+    bool m_executed = false;
+    bool m_applied = false;
+    bool m_obsolete = false;
 };
 
 // ============================================================================
@@ -337,6 +440,7 @@ public:
         
         // Create second clip
         auto secondClip = std::make_shared<Clip>(clip->mediaItemId());
+        secondClip->setType(clip->type());
         secondClip->setTimelineIn(m_splitPoint);
         secondClip->setTimelineOut(m_originalTimelineOut);
         secondClip->setSourceIn(clip->sourceIn() + firstDuration);
@@ -353,6 +457,8 @@ public:
         // Add second clip
         track->addClip(secondClip);
         m_executed = true;
+        
+        m_sequence.commitChange(splitChange());
     }
     
     void undo() override {
@@ -371,17 +477,30 @@ public:
         }
         
         m_executed = false;
+        
+        m_sequence.commitChange(splitChange());
     }
     
     [[nodiscard]] std::string description() const override {
         return "Split Clip";
     }
     
+    [[nodiscard]] size_t memoryUsage() const override {
+        return sizeof(*this);
+    }
+    
     [[nodiscard]] const UUID& newClipId() const {
         return m_newClipId;
     }
     
 private:
+    [[nodiscard]] SequenceChange splitChange() const {
+        auto change = clipChange(m_trackId, m_clipId,
+                                 m_splitPoint, m_originalTimelineOut);
+        change.addClip(m_newClipId);
+        return change;
+    }
+    
     Sequence& m_sequence;
     UUID m_trackId;
     UUID m_clipId;
@@ -9,8 +9,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace phoenix::model {
 
@@ -87,6 +89,15 @@ public:
      * Useful when a command's target no longer exists.
      */
     [[nodiscard]] virtual bool isObsolete() const { return false; }
+    
+    /**
+     * @brief Approximate memory held by this command, in bytes
+     * 
+     * Used by UndoStack to keep history within its byte budget.
+     * Include heap state the command keeps alive for undo (saved
+     * clips, strings). Queried after execute(), undo() and merges.
+     */
+    [[nodiscard]] virtual size_t memoryUsage() const { return sizeof(Command); }
 };
 
 /**
@@ -128,6 +139,15 @@ public:
         return m_commands.empty();
     }
     
+    [[nodiscard]] size_t memoryUsage() const override {
+        size_t bytes = sizeof(*this) + m_description.capacity() +
+                       m_commands.capacity() * sizeof(std::unique_ptr<Command>);
+        for (const auto& cmd : m_commands) {
+            bytes += cmd->memoryUsage();
+        }
+        return bytes;
+    }
+    
 private:
     std::string m_description;
     std::vector<std::unique_ptr<Command>> m_commands;
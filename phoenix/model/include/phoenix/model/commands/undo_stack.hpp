@@ -3,14 +3,15 @@
  * @brief Undo/Redo stack for managing commands
  * 
  * Provides a stack-based undo/redo system that manages
- * command history.
+ * command history. History is bounded both by command count and
+ * by the bytes the commands hold.
  */
 
 #pragma once
 
 #include <phoenix/core/signals.hpp>
 #include <phoenix/model/commands/command.hpp>
-#include <vector>
+#include <deque>
 #include <memory>
 #include <string>
 
@@ -23,6 +24,14 @@ namespace phoenix::model {
  * and redone. Commands are executed through the stack to
  * ensure proper history tracking.
  * 
+ * Every entry records the size its command reports through
+ * Command::memoryUsage(). Undo and redo entries share one memory
+ * budget. When the total exceeds it, the oldest undo entries are
+ * dropped first, then the redo entries farthest from the current
+ * state, each in O(1). The count limit applies to undo entries. The
+ * command next to the current state is always kept, even if it alone
+ * is over budget.
+ * 
  * Usage:
  * @code
  *   UndoStack stack;
@@ -33,6 +42,9 @@ namespace phoenix::model {
  */
 class UndoStack {
 public:
+    /// Default history budget
+    static constexpr size_t kDefaultMemoryLimit = 64 * 1024 * 1024;
+    
     UndoStack() = default;
     
     // Non-copyable
@@ -44,37 +56,44 @@ public:
     /**
      * @brief Execute a command and push to undo stack
      * 
+     * A command that reports itself obsolete after executing changed
+     * nothing; it is dropped and the redo history is kept.
+     * 
      * @param command Command to execute
      */
     void push(std::unique_ptr<Command> command) {
         if (!command) return;
         
-        // Clear redo stack
-        m_redoStack.clear();
-        
         // Execute the command
         command->execute();
+        if (command->isObsolete()) return;
+        
+        // Clear redo stack
+        for (const auto& entry : m_redoStack) {
+            m_memoryUsage -= entry.bytes;
+        }
+        m_redoStack.clear();
         
         // Try to merge with previous command
         if (!m_undoStack.empty() && 
-            m_undoStack.back()->id() != -1 &&
-            m_undoStack.back()->id() == command->id()) {
-            if (m_undoStack.back()->mergeWith(command.get())) {
+            m_undoStack.back().command->id() != -1 &&
+            m_undoStack.back().command->id() == command->id()) {
+            if (m_undoStack.back().command->mergeWith(command.get())) {
                 // Merged - don't add new command
+                remeasure(m_undoStack.back());
+                enforceLimits();
                 indexChanged.fire();
                 return;
             }
         }
         
         // Add to undo stack
-        m_undoStack.push_back(std::move(command));
-        
-        // Limit stack size
-        while (m_undoStack.size() > m_undoLimit) {
-            m_undoStack.erase(m_undoStack.begin());
-        }
+        Entry entry{std::move(command), 0};
+        remeasure(entry);
+        m_undoStack.push_back(std::move(entry));
         
         m_cleanIndex = -1;  // Mark as modified
+        enforceLimits();
         indexChanged.fire();
     }
     
@@ -86,12 +105,14 @@ public:
     void undo() {
         if (!canUndo()) return;
         
-        auto& cmd = m_undoStack.back();
-        cmd->undo();
+        auto& entry = m_undoStack.back();
+        entry.command->undo();
+        remeasure(entry);
         
-        m_redoStack.push_back(std::move(cmd));
+        m_redoStack.push_back(std::move(entry));
         m_undoStack.pop_back();
         
+        enforceLimits();
         indexChanged.fire();
     }
     
@@ -101,12 +122,14 @@ public:
     void redo() {
         if (!canRedo()) return;
         
-        auto& cmd = m_redoStack.back();
-        cmd->redo();
+        auto& entry = m_redoStack.back();
+        entry.command->redo();
+        remeasure(entry);
         
-        m_undoStack.push_back(std::move(cmd));
+        m_undoStack.push_back(std::move(entry));
         m_redoStack.pop_back();
         
+        enforceLimits();
         indexChanged.fire();
     }
     
@@ -129,7 +152,7 @@ public:
      */
     [[nodiscard]] std::string undoText() const {
         if (!canUndo()) return "";
-        return m_undoStack.back()->description();
+        return m_undoStack.back().command->description();
     }
     
     /**
@@ -137,7 +160,7 @@ public:
      */
     [[nodiscard]] std::string redoText() const {
         if (!canRedo()) return "";
-        return m_redoStack.back()->description();
+        return m_redoStack.back().command->description();
     }
     
     // ========== Stack Management ==========
@@ -148,6 +171,7 @@ public:
     void clear() {
         m_undoStack.clear();
         m_redoStack.clear();
+        m_memoryUsage = 0;
         m_cleanIndex = 0;
         indexChanged.fire();
     }
@@ -200,19 +224,45 @@ public:
     // ========== Configuration ==========
     
     /**
-     * @brief Set maximum undo history size
+     * @brief Set maximum undo history size (command count)
      */
     void setUndoLimit(size_t limit) {
         m_undoLimit = limit;
-        while (m_undoStack.size() > m_undoLimit) {
-            m_undoStack.erase(m_undoStack.begin());
-        }
+        enforceLimits();
     }
     
     [[nodiscard]] size_t undoLimit() const {
         return m_undoLimit;
     }
     
+    /**
+     * @brief Set the history budget in bytes (undo + redo)
+     */
+    void setMemoryLimit(size_t bytes) {
+        m_memoryLimit = bytes;
+        enforceLimits();
+    }
+    
+    [[nodiscard]] size_t memoryLimit() const {
+        return m_memoryLimit;
+    }
+    
+    // ========== Memory ==========
+    
+    /**
+     * @brief Bytes currently held by undo and redo history
+     */
+    [[nodiscard]] size_t memoryUsage() const {
+        return m_memoryUsage;
+    }
+    
+    /**
+     * @brief Commands dropped so far (undo or redo) to stay within the limits
+     */
+    [[nodiscard]] size_t evictedCount() const {
+        return m_evictedCount;
+    }
+    
     // ========== Signals ==========
     
     /// Emitted when index changes (after push, undo, redo)
@@ -222,11 +272,59 @@ public:
     Signal<bool> cleanChanged;
     
 private:
-    std::vector<std::unique_ptr<Command>> m_undoStack;
-    std::vector<std::unique_ptr<Command>> m_redoStack;
+    struct Entry {
+        std::unique_ptr<Command> command;
+        size_t bytes = 0;       // Last measured memoryUsage()
+    };
+    
+    /// Refresh an entry's size (commands capture state in execute/undo)
+    void remeasure(Entry& entry) {
+        size_t bytes = entry.command->memoryUsage();
+        m_memoryUsage = m_memoryUsage - entry.bytes + bytes;
+        entry.bytes = bytes;
+    }
+    
+    /// Drop the oldest undo, then the farthest redo entries until within both limits
+    void enforceLimits() {
+        while (!m_undoStack.empty() &&
+               (m_undoStack.size() > m_undoLimit ||
+                (m_memoryUsage > m_memoryLimit && m_undoStack.size() > 1))) {
+            m_memoryUsage -= m_undoStack.front().bytes;
+            m_undoStack.pop_front();
+            ++m_evictedCount;
+            
+            // Indices shift down; a clean state at the front is gone
+            if (m_cleanIndex > 0) {
+                --m_cleanIndex;
+            } else if (m_cleanIndex == 0) {
+                m_cleanIndex = -1;
+            }
+        }
+        
+        // Keep the next redo if nothing is left to undo
+        size_t keepRedo = m_undoStack.empty() ? 1 : 0;
+        while (m_memoryUsage > m_memoryLimit && m_redoStack.size() > keepRedo) {
+            m_memoryUsage -= m_redoStack.front().bytes;
+            m_redoStack.pop_front();
+            ++m_evictedCount;
+            
+            // A clean state in the dropped future is unreachable
+            if (m_cleanIndex > static_cast<int>(count())) {
+                m_cleanIndex = -1;
+            }
+        }
+    }
+    
+    // Both histories are evicted from the front (oldest undo,
+    // farthest redo), so both are deques.
+    std::deque<Entry> m_undoStack;
+    std::deque<Entry> m_redoStack;
     
     int m_cleanIndex = 0;
-    size_t m_undoLimit = 100;
+    size_t m_undoLimit = 1000;
+    size_t m_memoryLimit = kDefaultMemoryLimit;
+    size_t m_memoryUsage = 0;
+    size_t m_evictedCount = 0;
 };
 
 } // namespace phoenix::model
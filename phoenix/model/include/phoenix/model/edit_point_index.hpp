@@ -0,0 +1,286 @@
+/**
+ * @file edit_point_index.hpp
+ * @brief Sorted index of a sequence's edit points
+ *
+ * Snapping, "go to next/previous edit" and similar navigation need
+ * every clip edge across all tracks. The index keeps those edges (and
+ * the sequence's in/out points and playhead) sorted, so each query is
+ * a binary search instead of a walk over every clip.
+ */
+
+#pragma once
+
+#include <phoenix/core/types.hpp>
+#include <phoenix/core/uuid.hpp>
+#include <phoenix/model/clip.hpp>
+#include <phoenix/model/track.hpp>
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace phoenix::model {
+
+/**
+ * @brief What an edit point marks
+ */
+enum class EditPointKind : uint8_t {
+    ClipIn,     // Start of a clip
+    ClipOut,    // End of a clip
+    InPoint,    // Sequence in point
+    OutPoint,   // Sequence out point
+    Playhead,   // Current playhead position
+};
+
+/**
+ * @brief A position on the timeline that edits snap to
+ */
+struct EditPoint {
+    Timestamp time = 0;
+    EditPointKind kind = EditPointKind::ClipIn;
+    UUID clipId;    // Clip edges only
+    UUID trackId;   // Clip edges only
+
+    [[nodiscard]] bool isClipEdge() const {
+        return kind == EditPointKind::ClipIn || kind == EditPointKind::ClipOut;
+    }
+};
+
+/**
+ * @brief Sorted, incrementally maintained set of edit points
+ *
+ * Updates and queries are O(log n). Moving a clip or the playhead
+ * re-keys existing nodes, so steady-state edits do not allocate.
+ *
+ * Query filters are callables taking const EditPoint& and returning
+ * true to accept a point, e.g. to skip the edges of the clip being
+ * dragged.
+ *
+ * Not thread-safe; owned and updated by Sequence on the UI thread.
+ */
+class EditPointIndex {
+public:
+    /// Filter that accepts every point
+    struct AcceptAll {
+        constexpr bool operator()(const EditPoint&) const { return true; }
+    };
+
+    EditPointIndex() = default;
+
+    // Nodes are referenced by iterator
+    EditPointIndex(const EditPointIndex&) = delete;
+    EditPointIndex& operator=(const EditPointIndex&) = delete;
+
+    // ========== Updates ==========
+
+    /**
+     * @brief Insert or update the edges of a clip
+     */
+    void setClip(const Clip& clip, const UUID& trackId) {
+        auto it = m_clips.find(clip.id());
+        if (it == m_clips.end()) {
+            ClipEntry entry;
+            entry.in = m_points.emplace(clip.timelineIn(),
+                EditPoint{clip.timelineIn(), EditPointKind::ClipIn, clip.id(), trackId});
+            entry.out = m_points.emplace(clip.timelineOut(),
+                EditPoint{clip.timelineOut(), EditPointKind::ClipOut, clip.id(), trackId});
+            m_clips.emplace(clip.id(), entry);
+            return;
+        }
+
+        ClipEntry& entry = it->second;
+        entry.in = rekey(entry.in, clip.timelineIn());
+        entry.out = rekey(entry.out, clip.timelineOut());
+        entry.in->second.trackId = trackId;
+        entry.out->second.trackId = trackId;
+    }
+
+    /**
+     * @brief Remove the edges of a clip
+     *
+     * @return true if the clip was indexed
+     */
+    bool removeClip(const UUID& clipId) {
+        auto it = m_clips.find(clipId);
+        if (it == m_clips.end()) return false;
+
+        m_points.erase(it->second.in);
+        m_points.erase(it->second.out);
+        m_clips.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Set or clear a sequence-level point
+     *
+     * @param kind InPoint, OutPoint or Playhead
+     * @param time New position, or nullopt to remove the point
+     */
+    void setSequencePoint(EditPointKind kind, std::optional<Timestamp> time) {
+        auto& slot = m_sequencePoints[sequenceSlot(kind)];
+        if (!time) {
+            if (slot) m_points.erase(*slot);
+            slot.reset();
+        } else if (slot) {
+            slot = rekey(*slot, *time);
+        } else {
+            slot = m_points.emplace(*time, EditPoint{*time, kind, {}, {}});
+        }
+    }
+
+    /**
+     * @brief Re-index all clips of the given tracks
+     *
+     * Sequence-level points are kept.
+     */
+    void rebuild(const std::vector<std::shared_ptr<Track>>& videoTracks,
+                 const std::vector<std::shared_ptr<Track>>& audioTracks) {
+        for (auto& [id, entry] : m_clips) {
+            m_points.erase(entry.in);
+            m_points.erase(entry.out);
+        }
+        m_clips.clear();
+
+        size_t clipCount = 0;
+        for (const auto* tracks : {&videoTracks, &audioTracks}) {
+            for (const auto& track : *tracks) clipCount += track->clipCount();
+        }
+        m_clips.reserve(clipCount);
+
+        for (const auto* tracks : {&videoTracks, &audioTracks}) {
+            for (const auto& track : *tracks) {
+                for (const auto& clip : track->clips()) {
+                    setClip(*clip, track->id());
+                }
+            }
+        }
+    }
+
+    /// Remove all points
+    void clear() {
+        m_points.clear();
+        m_clips.clear();
+        m_sequencePoints = {};
+    }
+
+    // ========== Queries ==========
+
+    /**
+     * @brief Find the accepted point closest to a time
+     *
+     * Walks outward from @p time in both directions, so the cost
+     * is O(log n) plus the points within @p tolerance.
+     *
+     * @param time Position to snap
+     * @param tolerance Maximum distance to a point
+     * @param accept Filter for candidate points
+     * @return Closest point, or nullopt if none is within tolerance
+     */
+    template<typename Filter = AcceptAll>
+    [[nodiscard]] std::optional<EditPoint> nearest(
+        Timestamp time, Duration tolerance, Filter&& accept = {}) const
+    {
+        auto after = m_points.lower_bound(time);
+        auto before = after;
+
+        bool canGoBack = before != m_points.begin();
+        bool canGoForward = after != m_points.end();
+        if (canGoBack) --before;
+
+        while (canGoBack || canGoForward) {
+            Duration backDistance = canGoBack ? time - before->first : tolerance + 1;
+            Duration forwardDistance = canGoForward ? after->first - time : tolerance + 1;
+            if (std::min(backDistance, forwardDistance) > tolerance) break;
+
+            if (forwardDistance <= backDistance) {
+                if (accept(after->second)) return after->second;
+                canGoForward = ++after != m_points.end();
+            } else {
+                if (accept(before->second)) return before->second;
+                if (before == m_points.begin()) {
+                    canGoBack = false;
+                } else {
+                    --before;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief First accepted point strictly after a time
+     */
+    template<typename Filter = AcceptAll>
+    [[nodiscard]] std::optional<EditPoint> next(Timestamp time, Filter&& accept = {}) const {
+        for (auto it = m_points.upper_bound(time); it != m_points.end(); ++it) {
+            if (accept(it->second)) return it->second;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Last accepted point strictly before a time
+     */
+    template<typename Filter = AcceptAll>
+    [[nodiscard]] std::optional<EditPoint> previous(Timestamp time, Filter&& accept = {}) const {
+        for (auto it = m_points.lower_bound(time); it != m_points.begin(); ) {
+            --it;
+            if (accept(it->second)) return it->second;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Visit the points in [start, end) in time order
+     */
+    template<typename Visitor>
+    void forEachInRange(Timestamp start, Timestamp end, Visitor&& visitor) const {
+        for (auto it = m_points.lower_bound(start);
+             it != m_points.end() && it->first < end; ++it) {
+            visitor(it->second);
+        }
+    }
+
+    /// Total number of points
+    [[nodiscard]] size_t size() const { return m_points.size(); }
+    [[nodiscard]] bool empty() const { return m_points.empty(); }
+
+    /// Number of indexed clips
+    [[nodiscard]] size_t clipCount() const { return m_clips.size(); }
+
+private:
+    using PointMap = std::multimap<Timestamp, EditPoint>;
+
+    struct ClipEntry {
+        PointMap::iterator in;
+        PointMap::iterator out;
+    };
+
+    /// Re-key a node in place (no allocation)
+    PointMap::iterator rekey(PointMap::iterator it, Timestamp time) {
+        if (it->first == time) return it;
+
+        auto node = m_points.extract(it);
+        node.key() = time;
+        node.mapped().time = time;
+        return m_points.insert(std::move(node));
+    }
+
+    static size_t sequenceSlot(EditPointKind kind) {
+        switch (kind) {
+            case EditPointKind::InPoint:  return 0;
+            case EditPointKind::OutPoint: return 1;
+            default:                      return 2;
+        }
+    }
+
+    PointMap m_points;
+    std::unordered_map<UUID, ClipEntry> m_clips;
+    std::array<std::optional<PointMap::iterator>, 3> m_sequencePoints;  // In, out, playhead
+};
+
+} // namespace phoenix::model
@@ -0,0 +1,52 @@
+/**
+ * @file binary_codec.hpp
+ * @brief Binary encoders/decoders for model objects
+ *
+ * Shared by the binary project format and the autosave journal so
+ * both agree on how clips, tracks and sequences are laid out.
+ * Decoders preserve object IDs and throw std::runtime_error on
+ * truncated data.
+ */
+
+#pragma once
+
+#include <phoenix/model/io/binary_stream.hpp>
+#include <phoenix/model/media_item.hpp>
+#include <phoenix/model/sequence.hpp>
+#include <memory>
+
+namespace phoenix::model::codec {
+
+// ========== Encoding ==========
+
+void writeSequenceSettings(BinaryWriter& w, const SequenceSettings& s);
+void writeMediaItem(BinaryWriter& w, const MediaItem& item);
+void writeClip(BinaryWriter& w, const Clip& clip);
+
+/// Track header followed by all of its clips
+void writeTrack(BinaryWriter& w, const Track& track);
+void writeTrack(BinaryWriter& w, const TrackSnapshot& track);
+
+/// Sequence ID, name, header and all tracks
+void writeSequence(BinaryWriter& w, const Sequence& seq);
+
+/// The tracks of a published snapshot, as readSequenceTracks() expects
+void writeSequenceTracks(BinaryWriter& w, const SequenceSnapshot& snapshot);
+
+// ========== Decoding ==========
+
+SequenceSettings readSequenceSettings(BinaryReader& r);
+std::shared_ptr<MediaItem> readMediaItem(BinaryReader& r);
+std::shared_ptr<Clip> readClip(BinaryReader& r);
+std::shared_ptr<Track> readTrack(BinaryReader& r, TrackType type);
+
+/// Settings, playhead and in/out points (ID and name excluded)
+void readSequenceHeader(BinaryReader& r, Sequence& seq);
+
+/// Append the encoded tracks to @p seq
+void readSequenceTracks(BinaryReader& r, Sequence& seq);
+
+/// Decode a writeSequence() record into @p seq (its ID is skipped)
+void readSequence(BinaryReader& r, Sequence& seq);
+
+} // namespace phoenix::model::codec
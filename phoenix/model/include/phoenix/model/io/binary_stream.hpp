@@ -0,0 +1,212 @@
+/**
+ * @file binary_stream.hpp
+ * @brief Little-endian binary writer/reader for model serialization
+ *
+ * Used by the binary project format and the edit journal. Values are
+ * written in a fixed little-endian layout so files are portable
+ * between hosts. Data is grouped into tagged, length-prefixed chunks
+ * so readers can skip (or defer) chunks they do not need.
+ */
+
+#pragma once
+
+#include <phoenix/core/uuid.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace phoenix::model {
+
+/// Build a four-character chunk tag
+constexpr uint32_t makeChunkTag(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+}
+
+/// Size of a chunk header (tag + 64-bit payload length)
+constexpr size_t kChunkHeaderSize = 12;
+
+/**
+ * @brief Streaming binary writer
+ *
+ * Writes straight to an output stream; nothing is buffered beyond the
+ * stream's own buffer. Chunk lengths are patched in place, so the
+ * stream must be seekable while a chunk is open.
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& out) : m_out(out) {}
+
+    // ========== Primitives ==========
+
+    void writeU8(uint8_t v) { m_out.put(static_cast<char>(v)); }
+    void writeBool(bool v) { writeU8(v ? 1 : 0); }
+
+    void writeU32(uint32_t v) {
+        char buf[4];
+        for (int i = 0; i < 4; ++i) buf[i] = static_cast<char>(v >> (i * 8));
+        m_out.write(buf, 4);
+    }
+
+    void writeU64(uint64_t v) {
+        char buf[8];
+        for (int i = 0; i < 8; ++i) buf[i] = static_cast<char>(v >> (i * 8));
+        m_out.write(buf, 8);
+    }
+
+    void writeI32(int32_t v) { writeU32(static_cast<uint32_t>(v)); }
+    void writeI64(int64_t v) { writeU64(static_cast<uint64_t>(v)); }
+
+    void writeF32(float v) {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        writeU32(bits);
+    }
+
+    void writeString(std::string_view s) {
+        writeU32(static_cast<uint32_t>(s.size()));
+        m_out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+    void writeUUID(const UUID& id) {
+        m_out.write(reinterpret_cast<const char*>(id.data().data()), 16);
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        m_out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    // ========== Chunks ==========
+
+    /**
+     * @brief Start a chunk
+     *
+     * @return Token to pass to endChunk()
+     */
+    std::streamoff beginChunk(uint32_t tag) {
+        writeU32(tag);
+        auto pos = static_cast<std::streamoff>(m_out.tellp());
+        writeU64(0);  // Patched by endChunk()
+        return pos;
+    }
+
+    /// Finish a chunk, patching its payload length
+    void endChunk(std::streamoff token) {
+        auto end = static_cast<std::streamoff>(m_out.tellp());
+        m_out.seekp(token);
+        writeU64(static_cast<uint64_t>(end - token - 8));
+        m_out.seekp(end);
+    }
+
+    [[nodiscard]] bool good() const { return m_out.good(); }
+
+private:
+    std::ostream& m_out;
+};
+
+/**
+ * @brief Bounds-checked binary reader over a memory span
+ *
+ * Throws std::runtime_error on truncated input; callers translate
+ * that into an Error at their API boundary.
+ */
+class BinaryReader {
+public:
+    BinaryReader(const void* data, size_t size)
+        : m_data(static_cast<const uint8_t*>(data))
+        , m_size(size)
+    {}
+
+    explicit BinaryReader(std::string_view bytes)
+        : BinaryReader(bytes.data(), bytes.size())
+    {}
+
+    // ========== Primitives ==========
+
+    uint8_t readU8() {
+        require(1);
+        return m_data[m_pos++];
+    }
+
+    bool readBool() { return readU8() != 0; }
+
+    uint32_t readU32() {
+        require(4);
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(m_data[m_pos + i]) << (i * 8);
+        m_pos += 4;
+        return v;
+    }
+
+    uint64_t readU64() {
+        require(8);
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(m_data[m_pos + i]) << (i * 8);
+        m_pos += 8;
+        return v;
+    }
+
+    int32_t readI32() { return static_cast<int32_t>(readU32()); }
+    int64_t readI64() { return static_cast<int64_t>(readU64()); }
+
+    float readF32() {
+        uint32_t bits = readU32();
+        float v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    std::string readString() {
+        uint32_t len = readU32();
+        require(len);
+        std::string s(reinterpret_cast<const char*>(m_data + m_pos), len);
+        m_pos += len;
+        return s;
+    }
+
+    UUID readUUID() {
+        require(16);
+        std::array<uint8_t, 16> bytes;
+        std::memcpy(bytes.data(), m_data + m_pos, 16);
+        m_pos += 16;
+        UUID id;
+        id.setData(bytes);
+        return id;
+    }
+
+    /// Skip bytes without decoding them
+    void skip(size_t n) {
+        require(n);
+        m_pos += n;
+    }
+
+    // ========== Position ==========
+
+    [[nodiscard]] size_t position() const { return m_pos; }
+    [[nodiscard]] size_t remaining() const { return m_size - m_pos; }
+    [[nodiscard]] bool atEnd() const { return m_pos >= m_size; }
+
+    void seek(size_t pos) {
+        if (pos > m_size) throw std::runtime_error("Binary seek past end of data");
+        m_pos = pos;
+    }
+
+private:
+    void require(size_t n) const {
+        if (n > m_size - m_pos) {
+            throw std::runtime_error("Unexpected end of binary data");
+        }
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+};
+
+} // namespace phoenix::model
@@ -1,9 +1,11 @@
 /**
  * @file project_io.hpp
- * @brief Project serialization to/from JSON
+ * @brief Project serialization (binary and JSON)
  * 
  * Provides save/load functionality for Phoenix projects.
- * Project files use the .phoenix extension (JSON format).
+ * Project files use the .phoenix extension. They are written in a
+ * compact chunked binary format by default; JSON remains available
+ * for interchange and debugging. load() detects the format.
  */
 
 #pragma once
@@ -11,10 +13,47 @@
 #include <phoenix/core/result.hpp>
 #include <phoenix/model/project.hpp>
 #include <filesystem>
+#include <iosfwd>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace phoenix::model {
 
+/**
+ * @brief On-disk project format
+ */
+enum class ProjectFormat {
+    Binary,     // Chunked binary (default, fast to open)
+    Json,       // Human-readable JSON
+};
+
+/**
+ * @brief Immutable copy of a project's saved state
+ * 
+ * Taken on the UI thread by ProjectIO::capture() and encoded later on
+ * any thread. Settings, media items and sequence headers are copied;
+ * loaded sequences contribute their published snapshot, so clips are
+ * shared rather than copied. Deferred sequences keep their loader.
+ */
+struct ProjectImage {
+    struct SequenceImage {
+        UUID id;
+        std::string name;
+        SequenceSettings settings;
+        Timestamp playhead = 0;
+        Timestamp inPoint = 0;
+        Timestamp outPoint = 0;
+        std::shared_ptr<const SequenceSnapshot> timeline;   // Loaded sequences
+        Project::SequenceLoader loader;                     // Deferred sequences
+    };
+    
+    ProjectSettings settings;
+    int activeSequenceIndex = -1;
+    std::vector<std::shared_ptr<const MediaItem>> media;
+    std::vector<SequenceImage> sequences;
+};
+
 /**
  * @brief Project file I/O operations
  */
@@ -26,28 +65,90 @@ public:
     /// Current file format version
     static constexpr int kFormatVersion = 1;
     
+    /// Current binary format version
+    static constexpr int kBinaryFormatVersion = 1;
+    
     /**
      * @brief Save project to file
      * 
+     * Writes to a temporary file next to @p path and renames it into
+     * place, so a failed save never leaves a truncated project.
+     * 
      * @param project Project to save
      * @param path Output file path
+     * @param format On-disk format
      * @return Result indicating success or error
      */
     static Result<void, Error> save(
         const Project& project,
-        const std::filesystem::path& path
+        const std::filesystem::path& path,
+        ProjectFormat format = ProjectFormat::Binary
     );
     
     /**
      * @brief Load project from file
      * 
-     * @param path Path to project file
+     * Binary files load lazily: only the active sequence is decoded,
+     * the others are materialized on first activation (see
+     * Project::loadSequence()).
+     * 
+     * @param path Path to project file (binary or JSON)
      * @return Loaded project or error
      */
     static Result<std::unique_ptr<Project>, Error> load(
         const std::filesystem::path& path
     );
     
+    /**
+     * @brief Detect the format of a project file from its header
+     */
+    static Result<ProjectFormat, Error> detectFormat(
+        const std::filesystem::path& path
+    );
+    
+    /**
+     * @brief Stream project in binary format
+     * 
+     * @param project Project to write
+     * @param out Seekable output stream (opened in binary mode)
+     */
+    static Result<void, Error> writeBinary(
+        const Project& project,
+        std::ostream& out
+    );
+    
+    /**
+     * @brief Capture a project for writeBinary() on another thread
+     * 
+     * Costs the number of media items, sequences and tracks; no clip
+     * is copied.
+     */
+    static std::shared_ptr<const ProjectImage> capture(const Project& project);
+    
+    /**
+     * @brief Stream a captured project in binary format
+     * 
+     * Produces the same file as writeBinary(const Project&) for the
+     * state that was captured. Safe to call off the UI thread.
+     */
+    static Result<void, Error> writeBinary(
+        const ProjectImage& image,
+        std::ostream& out
+    );
+    
+    /**
+     * @brief Read a binary project from a stream
+     * 
+     * Chunks are read one at a time; deferred sequences keep only
+     * their own encoded bytes, the stream can be closed afterwards.
+     * 
+     * @param in Input stream (opened in binary mode)
+     * @return Loaded project or error
+     */
+    static Result<std::unique_ptr<Project>, Error> readBinary(
+        std::istream& in
+    );
+    
     /**
      * @brief Export project to JSON string
      * 
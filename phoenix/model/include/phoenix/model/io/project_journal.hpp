@@ -0,0 +1,257 @@
+/**
+ * @file project_journal.hpp
+ * @brief Append-only autosave journal
+ *
+ * Instead of periodically rewriting the whole project, every committed
+ * edit is appended to a journal file as a small binary record and
+ * synced to disk on a background thread. From time to time the journal
+ * is compacted: a full snapshot is written off-thread and the journal
+ * restarts empty. After a crash, recover() loads the newest snapshot
+ * and replays the journal on top of it.
+ *
+ * Files live next to the project:
+ *   <project>.autosave   Latest compacted snapshot (binary format)
+ *   <project>.journal    Records appended since that snapshot
+ */
+
+#pragma once
+
+#include <phoenix/core/result.hpp>
+#include <phoenix/core/signals.hpp>
+#include <phoenix/model/project.hpp>
+#include <phoenix/model/io/project_io.hpp>
+#include <phoenix/model/sequence_change.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace phoenix::model {
+
+/**
+ * @brief Journal statistics
+ */
+struct JournalStats {
+    uint64_t recordsWritten = 0;    // Records appended to disk
+    uint64_t bytesWritten = 0;      // Record bytes appended to disk
+    uint64_t syncCount = 0;         // fsync calls (one per batch)
+    uint64_t compactions = 0;       // Snapshots written
+    uint64_t journalSize = 0;       // Current journal file size
+    uint64_t writeErrors = 0;       // Failed writes/syncs
+};
+
+/**
+ * @brief Append-only autosave journal for a project
+ *
+ * Records are state-based, not command-based. Each SequenceChange
+ * stores the post-edit state of the clips and tracks it names, so
+ * executed, undone and redone commands all journal the same way and
+ * no command needs to be serializable. Replaying a record is
+ * idempotent. That makes recovery safe even if a crash lands between
+ * writing a snapshot and truncating the journal.
+ *
+ * Records are encoded on the calling (UI) thread. That costs only the
+ * size of the edit. File writes, fsync and snapshot encoding and
+ * writes run on the journal thread.
+ *
+ * If the journal file cannot be reopened, records are dropped (and
+ * counted as write errors) until the next compaction, which is
+ * requested right away and starts a fresh snapshot and journal.
+ *
+ * Usage:
+ * @code
+ *   ProjectJournal journal(projectPath);
+ *   if (journal.open()) journal.attach(project);
+ *   ...
+ *   // After a crash:
+ *   if (ProjectJournal::hasRecoveryData(projectPath)) {
+ *       auto project = ProjectJournal::recover(projectPath);
+ *   }
+ * @endcode
+ */
+class ProjectJournal {
+public:
+    /// Journal grows up to this size before auto-compaction
+    static constexpr uint64_t kDefaultCompactThreshold = 16 * 1024 * 1024;
+
+    /// Current journal format version
+    static constexpr int kFormatVersion = 1;
+
+    /**
+     * @param projectPath Path of the project file the journal belongs to
+     */
+    explicit ProjectJournal(std::filesystem::path projectPath);
+    ~ProjectJournal();
+
+    // Non-copyable
+    ProjectJournal(const ProjectJournal&) = delete;
+    ProjectJournal& operator=(const ProjectJournal&) = delete;
+
+    // ========== Lifecycle ==========
+
+    /**
+     * @brief Open the journal file and start the writer thread
+     *
+     * Existing recovery data is left alone until attach() writes a
+     * new base snapshot; check hasRecoveryData() first.
+     */
+    Result<void, Error> open();
+
+    /**
+     * @brief Flush pending records and stop the writer thread
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return m_thread.joinable(); }
+
+    /**
+     * @brief Start journaling edits of a project
+     *
+     * Writes an initial snapshot as the replay base, then subscribes
+     * to the project's sequences, media bin and sequence list. The
+     * project must outlive the journal or be detached first.
+     */
+    void attach(Project& project);
+
+    /// Stop journaling (pending records are still written)
+    void detach();
+
+    /**
+     * @brief Discard all recovery data
+     *
+     * Call after a successful explicit save: the project file is now
+     * authoritative, so the snapshot and journal are dropped.
+     */
+    void reset();
+
+    // ========== Recording ==========
+
+    /**
+     * @brief Journal a committed sequence edit
+     *
+     * Normally called through attach(); public for callers that
+     * commit changes outside of an attached project.
+     */
+    void record(const Sequence& seq, const SequenceChange& change);
+
+    /**
+     * @brief Write a full snapshot and restart the journal
+     *
+     * Only ProjectIO::capture() runs on the calling thread. Encoding,
+     * writing and syncing the snapshot happen on the journal thread.
+     */
+    void compact(const Project& project);
+
+    /**
+     * @brief Block until all queued records are on disk
+     */
+    void flush();
+
+    // ========== Configuration ==========
+
+    void setCompactThreshold(uint64_t bytes) { m_compactThreshold = bytes; }
+    [[nodiscard]] uint64_t compactThreshold() const { return m_compactThreshold; }
+
+    // ========== Statistics ==========
+
+    [[nodiscard]] JournalStats stats() const;
+
+    // ========== Recovery ==========
+
+    [[nodiscard]] static std::filesystem::path journalPath(const std::filesystem::path& projectPath);
+    [[nodiscard]] static std::filesystem::path snapshotPath(const std::filesystem::path& projectPath);
+
+    /// Check if a journal or snapshot exists for a project
+    [[nodiscard]] static bool hasRecoveryData(const std::filesystem::path& projectPath);
+
+    /// Delete a project's snapshot and journal (no journal may be open on it)
+    static void discardRecoveryData(const std::filesystem::path& projectPath);
+
+    /**
+     * @brief Rebuild a project after a crash
+     *
+     * Loads the autosave snapshot (or the project file if there is
+     * none) and replays the journal. A torn record at the tail, left
+     * by the crash, ends the replay.
+     *
+     * @return Recovered project, marked as modified
+     */
+    static Result<std::unique_ptr<Project>, Error> recover(
+        const std::filesystem::path& projectPath
+    );
+
+    /**
+     * @brief Replay a journal file onto a project
+     *
+     * Loaded sequences publish a new snapshot once all records are
+     * applied.
+     *
+     * @return Number of records applied
+     */
+    static Result<size_t, Error> replay(
+        Project& project,
+        const std::filesystem::path& journalFile
+    );
+
+private:
+    struct Job {
+        enum class Kind { Record, Snapshot, Reset };
+        Kind kind = Kind::Record;
+        std::string bytes;                          // Framed record
+        std::shared_ptr<const ProjectImage> image;  // Snapshot to encode
+    };
+
+    void enqueue(Job job);
+    void writerLoop();
+    void appendRecord(const std::string& payload);
+    void recordSequence(const Sequence& seq);
+    void watchSequence(const std::shared_ptr<Sequence>& seq);
+
+    // Writer thread only
+    void writeBatch(std::deque<Job>& jobs);
+    bool writeSnapshot(const ProjectImage& image);
+    bool restartJournal();
+
+    std::filesystem::path m_projectPath;
+    std::filesystem::path m_journalPath;
+    std::filesystem::path m_snapshotPath;
+
+    Project* m_project = nullptr;
+    std::vector<ScopedConnection> m_projectConnections;
+    std::unordered_map<UUID, ScopedConnection> m_sequenceConnections;
+
+    uint64_t m_compactThreshold = kDefaultCompactThreshold;
+    uint64_t m_bytesSinceCompact = 0;
+
+    // Writer thread state
+    std::FILE* m_file = nullptr;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_idleCv;
+    std::deque<Job> m_queue;
+    bool m_busy = false;
+    bool m_stop = false;
+
+    // Set by the writer when the journal file is lost; the next
+    // record triggers a compaction, which reopens it on a new base
+    std::atomic<bool> m_needsSnapshot{false};
+
+    // Statistics
+    std::atomic<uint64_t> m_recordsWritten{0};
+    std::atomic<uint64_t> m_bytesWritten{0};
+    std::atomic<uint64_t> m_syncCount{0};
+    std::atomic<uint64_t> m_compactions{0};
+    std::atomic<uint64_t> m_journalSize{0};
+    std::atomic<uint64_t> m_writeErrors{0};
+};
+
+} // namespace phoenix::model
@@ -15,13 +15,20 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <string>
 
 namespace phoenix::model {
 
 /**
  * @brief Container for project media assets
  * 
- * Provides O(1) lookup by UUID and maintains import order.
+ * Provides O(1) lookup by UUID, file path and content hash, and
+ * maintains import order. Removal is O(1): the slot in the import
+ * order is cleared and the order is compacted once more than half
+ * of it is empty.
+ * 
+ * Paths and content hashes are indexed, so change them through
+ * relinkItem() / setContentHash() rather than on the item directly.
  */
 class MediaBin {
 public:
@@ -38,13 +45,10 @@ public:
      * @return true if added, false if item with same ID exists
      */
     bool addItem(ItemPtr item) {
-        if (!item || m_items.find(item->id()) != m_items.end()) {
+        if (!insert(item)) {
             return false;
         }
         
-        m_items[item->id()] = item;
-        m_order.push_back(item->id());
-        
         itemAdded.fire(item);
         return true;
     }
@@ -63,6 +67,34 @@ public:
         return nullptr;
     }
     
+    /**
+     * @brief Add many items at once
+     * 
+     * Reserves index space up front and fires a single itemsAdded
+     * signal instead of one itemAdded per item. Null items and
+     * duplicate IDs are skipped.
+     * 
+     * @return Number of items added
+     */
+    size_t addItems(const std::vector<ItemPtr>& items) {
+        m_items.reserve(m_items.size() + items.size());
+        m_byPath.reserve(m_byPath.size() + items.size());
+        m_order.reserve(m_order.size() + items.size());
+        
+        std::vector<ItemPtr> added;
+        added.reserve(items.size());
+        for (const auto& item : items) {
+            if (insert(item)) {
+                added.push_back(item);
+            }
+        }
+        
+        if (!added.empty()) {
+            itemsAdded.fire(added);
+        }
+        return added.size();
+    }
+    
     /**
      * @brief Remove a media item by ID
      * 
@@ -75,16 +107,17 @@ public:
             return false;
         }
         
-        auto item = it->second;
-        m_items.erase(it);
+        // Keep the ID alive; it may refer into the removed item
+        UUID removedId = id;
+        auto item = it->second.item;
         
-        // Remove from order
-        m_order.erase(
-            std::remove(m_order.begin(), m_order.end(), id),
-            m_order.end()
-        );
+        unindex(item);
+        m_order[it->second.order] = nullptr;
+        ++m_removedSlots;
+        m_items.erase(it);
+        compactOrder();
         
-        itemRemoved.fire(id);
+        itemRemoved.fire(removedId);
         return true;
     }
     
@@ -94,9 +127,44 @@ public:
     void clear() {
         m_items.clear();
         m_order.clear();
+        m_byPath.clear();
+        m_byHash.clear();
+        m_removedSlots = 0;
         cleared.fire();
     }
     
+    /**
+     * @brief Point an item at a new file path
+     * 
+     * @return true if the item exists
+     */
+    bool relinkItem(const UUID& id, const std::filesystem::path& path) {
+        auto item = getItem(id);
+        if (!item) return false;
+        
+        unindex(item);
+        item->setPath(path);
+        index(item);
+        
+        itemRelinked.fire(item);
+        return true;
+    }
+    
+    /**
+     * @brief Set an item's content hash
+     * 
+     * @return true if the item exists
+     */
+    bool setContentHash(const UUID& id, uint64_t hash) {
+        auto item = getItem(id);
+        if (!item) return false;
+        
+        unindex(item);
+        item->setContentHash(hash);
+        index(item);
+        return true;
+    }
+    
     // ========== Lookup ==========
     
     /**
@@ -107,22 +175,32 @@ public:
      */
     [[nodiscard]] ItemPtr getItem(const UUID& id) const {
         auto it = m_items.find(id);
-        return (it != m_items.end()) ? it->second : nullptr;
+        return (it != m_items.end()) ? it->second.item : nullptr;
     }
     
     /**
      * @brief Find item by file path
      * 
+     * Paths are compared after lexical normalization.
+     * 
      * @param path Path to search for
      * @return Item pointer or nullptr if not found
      */
     [[nodiscard]] ItemPtr findByPath(const std::filesystem::path& path) const {
-        for (const auto& [id, item] : m_items) {
-            if (item->path() == path) {
-                return item;
-            }
-        }
-        return nullptr;
+        auto it = m_byPath.find(pathKey(path));
+        return (it != m_byPath.end()) ? it->second : nullptr;
+    }
+    
+    /**
+     * @brief Find item by content hash
+     * 
+     * @param hash Value from MediaItem::computeContentHash()
+     * @return Item pointer or nullptr if not found (or hash is 0)
+     */
+    [[nodiscard]] ItemPtr findByContentHash(uint64_t hash) const {
+        if (hash == 0) return nullptr;
+        auto it = m_byHash.find(hash);
+        return (it != m_byHash.end()) ? it->second : nullptr;
     }
     
     /**
@@ -134,17 +212,30 @@ public:
     
     // ========== Iteration ==========
     
+    /**
+     * @brief Visit all items in import order
+     * 
+     * Does not allocate. The bin must not be modified from
+     * inside the visitor.
+     * 
+     * @param visitor Callable taking const ItemPtr&
+     */
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const auto& item : m_order) {
+            if (item) visitor(item);
+        }
+    }
+    
     /**
      * @brief Get all items in import order
+     * 
+     * Builds a new vector; prefer forEach() on hot paths.
      */
     [[nodiscard]] std::vector<ItemPtr> items() const {
         std::vector<ItemPtr> result;
-        result.reserve(m_order.size());
-        for (const auto& id : m_order) {
-            if (auto it = m_items.find(id); it != m_items.end()) {
-                result.push_back(it->second);
-            }
-        }
+        result.reserve(m_items.size());
+        forEach([&result](const ItemPtr& item) { result.push_back(item); });
         return result;
     }
     
@@ -167,15 +258,84 @@ public:
     /// Emitted when an item is added
     Signal<ItemPtr> itemAdded;
     
+    /// Emitted once per addItems() call with the items added
+    Signal<const std::vector<ItemPtr>&> itemsAdded;
+    
     /// Emitted when an item is removed
     Signal<UUID> itemRemoved;
     
+    /// Emitted when relinkItem() points an item at a new path
+    Signal<ItemPtr> itemRelinked;
+    
     /// Emitted when all items are cleared
     VoidSignal cleared;
     
 private:
-    std::unordered_map<UUID, ItemPtr> m_items;
-    std::vector<UUID> m_order;  // Maintains import order
+    struct Entry {
+        ItemPtr item;
+        size_t order = 0;   // Slot in m_order
+    };
+    
+    /// Insert without signalling
+    bool insert(const ItemPtr& item) {
+        if (!item) return false;
+        
+        auto [it, inserted] = m_items.try_emplace(item->id(), Entry{item, m_order.size()});
+        if (!inserted) return false;
+        
+        m_order.push_back(item);
+        index(item);
+        return true;
+    }
+    
+    void index(const ItemPtr& item) {
+        m_byPath.emplace(pathKey(item->path()), item);
+        if (item->contentHash() != 0) {
+            m_byHash.emplace(item->contentHash(), item);
+        }
+    }
+    
+    void unindex(const ItemPtr& item) {
+        auto eraseFrom = [&item](auto& index, const auto& key) {
+            auto [first, last] = index.equal_range(key);
+            for (auto it = first; it != last; ++it) {
+                if (it->second == item) {
+                    index.erase(it);
+                    return;
+                }
+            }
+        };
+        eraseFrom(m_byPath, pathKey(item->path()));
+        if (item->contentHash() != 0) {
+            eraseFrom(m_byHash, item->contentHash());
+        }
+    }
+    
+    /// Drop removed slots once they make up most of the order
+    void compactOrder() {
+        if (m_removedSlots < 32 || m_removedSlots * 2 < m_order.size()) return;
+        
+        size_t next = 0;
+        for (auto& item : m_order) {
+            if (!item) continue;
+            m_items[item->id()].order = next;
+            m_order[next++] = std::move(item);
+        }
+        m_order.resize(next);
+        m_removedSlots = 0;
+    }
+    
+    [[nodiscard]] static std::string pathKey(const std::filesystem::path& path) {
+        return path.lexically_normal().generic_string();
+    }
+    
+    std::unordered_map<UUID, Entry> m_items;
+    std::vector<ItemPtr> m_order;       // Import order; null = removed
+    size_t m_removedSlots = 0;
+    
+    // Secondary indexes (several items may share a path or hash)
+    std::unordered_multimap<std::string, ItemPtr> m_byPath;
+    std::unordered_multimap<uint64_t, ItemPtr> m_byHash;
 };
 
 } // namespace phoenix::model
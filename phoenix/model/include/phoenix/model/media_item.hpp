@@ -10,8 +10,10 @@
 
 #include <phoenix/core/types.hpp>
 #include <phoenix/core/uuid.hpp>
+#include <algorithm>
 #include <string>
 #include <filesystem>
+#include <fstream>
 #include <chrono>
 
 namespace phoenix::model {
@@ -27,6 +29,16 @@ enum class MediaItemType {
     Sequence,   // Image sequence
 };
 
+/**
+ * @brief Availability of a media item's file
+ */
+enum class MediaStatus {
+    Unknown = 0,    // Not checked yet
+    Online,         // File present and unchanged since probing
+    Offline,        // File missing or inaccessible
+    Modified,       // File changed on disk; needs re-probing
+};
+
 /**
  * @brief Video stream properties
  */
@@ -61,8 +73,15 @@ public:
     
     explicit MediaItem(const std::filesystem::path& path)
         : m_id(UUID::generate())
+        , m_name(path.stem().string())
         , m_path(path)
+    {}
+    
+    /// Construct with a known ID (used when loading projects)
+    MediaItem(const UUID& id, const std::filesystem::path& path)
+        : m_id(id)
         , m_name(path.stem().string())
+        , m_path(path)
     {}
     
     // ========== Identification ==========
@@ -130,9 +149,75 @@ public:
     
     // ========== Status ==========
     
-    /// Check if the file exists and is accessible
+    /**
+     * @brief Check if the file exists and is accessible
+     * 
+     * Answers from the cached status kept by MediaStatusService.
+     * Only an item that has never been checked touches the file
+     * system.
+     */
     [[nodiscard]] bool isOnline() const {
-        return std::filesystem::exists(m_path);
+        if (m_status == MediaStatus::Unknown) {
+            std::error_code ec;
+            return std::filesystem::exists(m_path, ec);
+        }
+        return m_status != MediaStatus::Offline;
+    }
+    
+    /// Cached file status (set by MediaStatusService)
+    [[nodiscard]] MediaStatus status() const { return m_status; }
+    void setStatus(MediaStatus status) { m_status = status; }
+    
+    /**
+     * @brief Content fingerprint (0 = not computed)
+     * 
+     * Identifies the same file imported under different paths.
+     * Change it through MediaBin::setContentHash() once the item
+     * is in a bin, so the bin's index stays current.
+     */
+    [[nodiscard]] uint64_t contentHash() const { return m_contentHash; }
+    void setContentHash(uint64_t hash) { m_contentHash = hash; }
+    
+    /**
+     * @brief Compute a content fingerprint for a file
+     * 
+     * FNV-1a over the file size and the first and last 64 KiB, so
+     * it costs two small reads regardless of file size. Good enough
+     * to detect re-imports; it is not a cryptographic hash.
+     * 
+     * @return Fingerprint, or 0 if the file cannot be read
+     */
+    [[nodiscard]] static uint64_t computeContentHash(const std::filesystem::path& path) {
+        constexpr size_t kSampleSize = 64 * 1024;
+        
+        std::error_code ec;
+        uint64_t size = std::filesystem::file_size(path, ec);
+        if (ec) return 0;
+        
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return 0;
+        
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const char* data, size_t len) {
+            for (size_t i = 0; i < len; ++i) {
+                hash ^= static_cast<uint8_t>(data[i]);
+                hash *= 1099511628211ull;
+            }
+        };
+        mix(reinterpret_cast<const char*>(&size), sizeof(size));
+        
+        std::string buffer(kSampleSize, '\0');
+        in.read(buffer.data(), static_cast<std::streamsize>(kSampleSize));
+        mix(buffer.data(), static_cast<size_t>(in.gcount()));
+        
+        if (size > kSampleSize) {
+            in.clear();
+            in.seekg(static_cast<std::streamoff>(size - std::min<uint64_t>(size - kSampleSize, kSampleSize)));
+            in.read(buffer.data(), static_cast<std::streamsize>(kSampleSize));
+            mix(buffer.data(), static_cast<size_t>(in.gcount()));
+        }
+        
+        return hash != 0 ? hash : 1;
     }
     
     /// Check if media info has been probed
@@ -171,6 +256,7 @@ private:
     // File info
     std::filesystem::path m_path;
     uint64_t m_fileSize = 0;
+    uint64_t m_contentHash = 0;
     std::chrono::system_clock::time_point m_lastModified;
     
     // Media properties
@@ -184,6 +270,7 @@ private:
     // Cached data
     std::filesystem::path m_thumbnailPath;
     bool m_probed = false;
+    MediaStatus m_status = MediaStatus::Unknown;
 };
 
 } // namespace phoenix::model
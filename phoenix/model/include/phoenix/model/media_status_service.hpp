@@ -0,0 +1,255 @@
+/**
+ * @file media_status_service.hpp
+ * @brief Event-driven online/modified tracking for media files
+ *
+ * Keeps MediaItem::status() current without polling. The directories
+ * that hold a bin's media are watched with inotify. A file system
+ * event re-checks only the files it names, on a background thread.
+ * Status changes are delivered to the owner thread through a
+ * Dispatcher.
+ *
+ * Where notifications are unavailable (other platforms, exhausted
+ * watch limits) or unreliable (network mounts do not report remote
+ * changes), a slow background rescan covers the gap.
+ */
+
+#pragma once
+
+#include <phoenix/core/signals.hpp>
+#include <phoenix/core/uuid.hpp>
+#include <phoenix/model/media_bin.hpp>
+#include <phoenix/model/media_item.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace phoenix::model {
+
+/**
+ * @brief Media status statistics
+ */
+struct MediaStatusStats {
+    size_t watchedItems = 0;        // Items being tracked
+    size_t watchedDirectories = 0;  // Directories with an inotify watch
+    uint64_t events = 0;            // File system events received
+    uint64_t checks = 0;            // Files stat'ed
+    uint64_t rescans = 0;           // Full rescans
+    uint64_t changes = 0;           // Status changes delivered
+};
+
+/**
+ * @brief Watches media files and reports availability changes
+ *
+ * All file system access happens on the service's thread, so the UI
+ * never blocks on a slow volume. A change is reported as:
+ * - Offline: the file was deleted, moved away or became unreadable
+ * - Online: a missing file is back, unchanged
+ * - Modified: the file's size or modification time changed (or it
+ *   came back different); re-probe it and drop cached frames
+ *
+ * The owner thread (the one the dispatcher runs tasks on) sees
+ * MediaItem::setStatus() applied before statusChanged fires.
+ *
+ * Usage:
+ * @code
+ *   MediaStatusService service(dispatcher);
+ *   service.start();
+ *   service.attach(project.mediaBin());
+ *   (void)service.statusChanged.connect([](auto item, MediaStatus status) {
+ *       if (status == MediaStatus::Modified) reprobe(item);
+ *   });
+ * @endcode
+ */
+class MediaStatusService {
+public:
+    using ItemPtr = std::shared_ptr<MediaItem>;
+
+    /// Default period of the safety-net rescan
+    static constexpr std::chrono::seconds kDefaultRescanInterval{60};
+
+    /**
+     * @param dispatcher Runs status updates on the owner thread
+     */
+    explicit MediaStatusService(std::shared_ptr<Dispatcher> dispatcher);
+    ~MediaStatusService();
+
+    // Non-copyable
+    MediaStatusService(const MediaStatusService&) = delete;
+    MediaStatusService& operator=(const MediaStatusService&) = delete;
+
+    // ========== Lifecycle ==========
+
+    /**
+     * @brief Start the watcher thread
+     *
+     * Falls back to periodic rescans if file notifications cannot be
+     * set up; see usesNotifications().
+     */
+    void start();
+
+    /**
+     * @brief Stop the watcher thread
+     *
+     * Tracked items are forgotten and undelivered updates dropped;
+     * attach() or watch() again after restarting.
+     */
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return m_thread.joinable(); }
+
+    /// Check if changes are reported by the kernel rather than by rescans
+    [[nodiscard]] bool usesNotifications() const { return m_notifyFd >= 0; }
+
+    // ========== Watching ==========
+
+    /**
+     * @brief Track every item of a bin, and items added later
+     *
+     * The bin must outlive the service or be detached first.
+     */
+    void attach(MediaBin& bin);
+
+    /// Stop tracking the attached bin's items
+    void detach();
+
+    /**
+     * @brief Start tracking one item
+     *
+     * The item's path is captured now; call again after changing it
+     * outside MediaBin::relinkItem(). Watching an item again also
+     * makes the file's current state the reference, which clears a
+     * Modified status once the item has been re-probed.
+     */
+    void watch(const ItemPtr& item);
+
+    /// Stop tracking an item
+    void unwatch(const UUID& id);
+
+    /// Stop tracking all items
+    void unwatchAll();
+
+    /**
+     * @brief Re-check every tracked file
+     *
+     * Useful after the system resumes or a volume is remounted.
+     */
+    void rescan();
+
+    /// Safety-net rescan period (zero disables it)
+    void setRescanInterval(std::chrono::milliseconds interval);
+    [[nodiscard]] std::chrono::milliseconds rescanInterval() const {
+        return m_rescanInterval.load();
+    }
+
+    // ========== Statistics ==========
+
+    [[nodiscard]] MediaStatusStats stats() const;
+
+    // ========== Signals ==========
+
+    /// Emitted on the owner thread after an item's status changed
+    Signal<ItemPtr, MediaStatus> statusChanged;
+
+private:
+    /// Work handed from the owner thread to the watcher thread
+    struct Request {
+        enum class Kind { Watch, Unwatch, UnwatchAll, Rescan };
+        Kind kind = Kind::Watch;
+        UUID id;
+        std::weak_ptr<MediaItem> item;
+        std::filesystem::path path;     // Captured on the owner thread
+        uint64_t expectedSize = 0;      // Size recorded when probed (0 = unknown)
+    };
+
+    /// Result of a stat() call
+    struct FileState {
+        bool exists = false;
+        uint64_t size = 0;
+        int64_t modified = 0;           // Nanoseconds since epoch
+
+        [[nodiscard]] bool sameContent(const FileState& other) const {
+            return size == other.size && modified == other.modified;
+        }
+    };
+
+    /// A status change travelling back to the owner thread
+    struct StatusUpdate {
+        std::weak_ptr<MediaItem> item;
+        std::filesystem::path path;     // Path the status applies to
+        MediaStatus status = MediaStatus::Unknown;
+    };
+
+    // Watcher thread only
+    struct Watched {
+        std::weak_ptr<MediaItem> item;
+        std::filesystem::path path;
+        std::string directory;
+        std::string fileName;
+        uint64_t expectedSize = 0;
+        FileState baseline;             // Last state seen while present
+        MediaStatus status = MediaStatus::Unknown;
+    };
+
+    struct Directory {
+        int wd = -1;                    // inotify watch, -1 if none
+        std::unordered_map<std::string, std::vector<UUID>> files;
+        size_t itemCount = 0;
+    };
+
+    static Request watchRequest(const ItemPtr& item);
+    void post(std::vector<Request> requests);
+    void wake();
+    void watcherLoop();
+    bool waitForEvents(std::chrono::milliseconds timeout);
+    void readEvents(std::unordered_set<UUID>& dirty, bool& overflow);
+    bool handleRequests(const std::vector<Request>& requests, std::unordered_set<UUID>& dirty);
+    void addWatched(const Request& request);
+    void removeWatched(const UUID& id);
+    void addDirectoryWatch(const std::string& path, Directory& dir);
+    void check(const UUID& id, std::vector<StatusUpdate>& updates);
+    static FileState statFile(const std::filesystem::path& path);
+
+    /// Owner thread: apply updates to items and notify
+    void applyUpdates(const std::vector<StatusUpdate>& updates);
+
+    std::shared_ptr<Dispatcher> m_dispatcher;
+    Signal<const std::vector<StatusUpdate>&> m_updates;    // Fired on the watcher thread
+    ScopedConnection m_updatesConnection;
+
+    MediaBin* m_bin = nullptr;
+    std::vector<ScopedConnection> m_binConnections;
+
+    // Owner -> watcher hand-off
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;       // Wakes the thread when there is no eventfd
+    std::vector<Request> m_requests;
+    bool m_stop = false;
+    std::atomic<std::chrono::milliseconds> m_rescanInterval{kDefaultRescanInterval};
+    int m_notifyFd = -1;                // inotify instance
+    int m_wakeFd = -1;                  // eventfd that interrupts the wait
+
+    // Watcher thread state
+    std::unordered_map<UUID, Watched> m_watched;
+    std::unordered_map<std::string, Directory> m_directories;
+    std::unordered_map<int, std::string> m_directoryByWd;
+
+    // Statistics
+    std::atomic<size_t> m_watchedCount{0};
+    std::atomic<size_t> m_directoryWatchCount{0};
+    std::atomic<uint64_t> m_events{0};
+    std::atomic<uint64_t> m_checks{0};
+    std::atomic<uint64_t> m_rescans{0};
+    std::atomic<uint64_t> m_changes{0};
+};
+
+} // namespace phoenix::model
@@ -19,6 +19,9 @@
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace phoenix::model {
 
@@ -120,13 +123,27 @@ public:
         return seq;
     }
     
+    /**
+     * @brief Add an existing sequence
+     * 
+     * @param seq Sequence to add (e.g. one built by a project loader)
+     */
+    void addSequence(SequencePtr seq) {
+        if (!seq) return;
+        m_sequences.push_back(seq);
+        sequenceAdded.fire(seq);
+    }
+    
     /**
      * @brief Remove a sequence
      * 
-     * @param seqId UUID of sequence to remove
+     * @param id UUID of sequence to remove
      * @return true if removed
      */
-    bool removeSequence(const UUID& seqId) {
+    bool removeSequence(const UUID& id) {
+        // Copy: id may refer into the sequence being erased
+        const UUID seqId = id;
+        
         auto it = std::find_if(m_sequences.begin(), m_sequences.end(),
             [&seqId](const SequencePtr& s) { return s->id() == seqId; });
         
@@ -135,8 +152,12 @@ public:
         // Don't remove if it's the only sequence
         if (m_sequences.size() == 1) return false;
         
+        // Don't orphan nested clips that use it
+        if (isNested(seqId)) return false;
+        
         auto removedIndex = static_cast<int>(std::distance(m_sequences.begin(), it));
         m_sequences.erase(it);
+        m_sequenceLoaders.erase(seqId);
         
         // Adjust active sequence index if needed
         if (m_activeSequenceIndex == removedIndex) {
@@ -176,12 +197,63 @@ public:
     
     [[nodiscard]] size_t sequenceCount() const { return m_sequences.size(); }
     
+    // ========== Nesting ==========
+    
+    /**
+     * @brief Check if any other sequence nests a sequence
+     * 
+     * Deferred sequences are loaded first, since they stay empty
+     * until then. One that fails to load counts as nesting it.
+     */
+    [[nodiscard]] bool isNested(const UUID& seqId) {
+        return std::any_of(m_sequences.begin(), m_sequences.end(),
+            [&](const SequencePtr& s) {
+                if (s->id() == seqId) return false;
+                if (!loadSequence(s->id())) return true;
+                auto ids = s->nestedSequenceIds();
+                return std::find(ids.begin(), ids.end(), seqId) != ids.end();
+            });
+    }
+    
+    /**
+     * @brief Check if a sequence may be nested inside another
+     * 
+     * Rejects nests that would make a sequence contain itself,
+     * directly or through other nests. Deferred sequences on the
+     * path are loaded.
+     * 
+     * @param parentId Sequence that would receive the nested clip
+     * @param childId Sequence to nest
+     */
+    bool canNest(const UUID& parentId, const UUID& childId) {
+        if (parentId == childId) return false;
+        if (!getSequence(parentId) || !getSequence(childId)) return false;
+        
+        // Walk everything the child nests, looking for the parent
+        std::vector<UUID> pending{childId};
+        std::unordered_set<UUID> visited;
+        while (!pending.empty()) {
+            UUID id = pending.back();
+            pending.pop_back();
+            if (!visited.insert(id).second) continue;
+            
+            auto seq = getSequence(id);
+            if (!seq || !loadSequence(id)) continue;
+            for (const auto& nestedId : seq->nestedSequenceIds()) {
+                if (nestedId == parentId) return false;
+                pending.push_back(nestedId);
+            }
+        }
+        return true;
+    }
+    
     // ========== Active Sequence ==========
     
     [[nodiscard]] int activeSequenceIndex() const { return m_activeSequenceIndex; }
     
     void setActiveSequenceIndex(int index) {
         if (index >= 0 && index < static_cast<int>(m_sequences.size())) {
+            loadSequence(m_sequences[index]->id());
             m_activeSequenceIndex = index;
             activeSequenceChanged.fire(m_sequences[index]);
         }
@@ -195,6 +267,80 @@ public:
         return nullptr;
     }
     
+    // ========== Lazy Loading ==========
+    
+    /**
+     * @brief Loader that fills a sequence's tracks from stored data
+     * 
+     * Must be callable repeatedly and on any Sequence instance, so
+     * savers can decode a copy without materializing the original.
+     */
+    using SequenceLoader = std::function<bool(Sequence&)>;
+    
+    /**
+     * @brief Defer loading of a sequence's contents
+     * 
+     * The sequence stays an empty stub (ID, name, settings) until
+     * loadSequence() is called. Activating a sequence loads it.
+     */
+    void setSequenceLoader(const UUID& seqId, SequenceLoader loader) {
+        m_sequenceLoaders[seqId] = std::move(loader);
+    }
+    
+    /// Check if a sequence's contents are in memory
+    [[nodiscard]] bool isSequenceLoaded(const UUID& seqId) const {
+        return m_sequenceLoaders.find(seqId) == m_sequenceLoaders.end();
+    }
+    
+    /// Loader of a deferred sequence (empty once it is loaded)
+    [[nodiscard]] SequenceLoader sequenceLoader(const UUID& seqId) const {
+        auto it = m_sequenceLoaders.find(seqId);
+        return it != m_sequenceLoaders.end() ? it->second : SequenceLoader{};
+    }
+    
+    /**
+     * @brief Materialize a deferred sequence in place
+     * 
+     * Sequences it nests are loaded too, since rendering the
+     * sequence reads them.
+     * 
+     * @return true if the sequence is loaded (or already was)
+     */
+    bool loadSequence(const UUID& seqId) {
+        auto it = m_sequenceLoaders.find(seqId);
+        if (it == m_sequenceLoaders.end()) return true;
+        
+        auto seq = getSequence(seqId);
+        auto loader = std::move(it->second);
+        m_sequenceLoaders.erase(it);
+        if (!seq || !loader(*seq)) return false;
+        
+        sequenceLoaded.fire(seq);
+        
+        // Already erased from the loaders, so cycles terminate
+        for (const auto& nestedId : seq->nestedSequenceIds()) {
+            loadSequence(nestedId);
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Decode a deferred sequence into another instance
+     * 
+     * Leaves the project untouched; used when saving.
+     */
+    bool loadSequenceInto(const UUID& seqId, Sequence& target) const {
+        auto it = m_sequenceLoaders.find(seqId);
+        return it != m_sequenceLoaders.end() && it->second(target);
+    }
+    
+    /// Materialize all deferred sequences
+    void loadAllSequences() {
+        while (!m_sequenceLoaders.empty()) {
+            loadSequence(m_sequenceLoaders.begin()->first);
+        }
+    }
+    
     // ========== Modified State ==========
     
     [[nodiscard]] bool isModified() const { return m_modified; }
@@ -230,6 +376,9 @@ public:
     Signal<SequencePtr> sequenceAdded;
     Signal<UUID> sequenceRemoved;
     Signal<SequencePtr> activeSequenceChanged;
+    
+    /// Emitted when a deferred sequence has been materialized
+    Signal<SequencePtr> sequenceLoaded;
     Signal<bool> modifiedChanged;
     
 private:
@@ -240,6 +389,7 @@ private:
     MediaBin m_mediaBin;
     std::vector<SequencePtr> m_sequences;
     int m_activeSequenceIndex = -1;
+    std::unordered_map<UUID, SequenceLoader> m_sequenceLoaders;  // Not yet loaded
     
     bool m_modified = false;
     std::chrono::system_clock::time_point m_createdTime = 
@@ -12,35 +12,17 @@
 #include <phoenix/core/uuid.hpp>
 #include <phoenix/core/signals.hpp>
 #include <phoenix/model/track.hpp>
+#include <phoenix/model/edit_point_index.hpp>
+#include <phoenix/model/sequence_change.hpp>
+#include <phoenix/model/sequence_settings.hpp>
+#include <phoenix/model/sequence_snapshot.hpp>
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <atomic>
 
 namespace phoenix::model {
 
-/**
- * @brief Sequence settings
- */
-struct SequenceSettings {
-    Size resolution{1920, 1080};        // Output resolution
-    Rational frameRate{30000, 1001};    // ~29.97 fps
-    int sampleRate = 48000;             // Audio sample rate
-    int audioChannels = 2;              // Stereo
-    
-    /// Frame duration in microseconds
-    [[nodiscard]] Duration frameDuration() const {
-        if (frameRate.num == 0) return 0;
-        return static_cast<Duration>(
-            static_cast<double>(kTimeBaseUs) * frameRate.den / frameRate.num
-        );
-    }
-    
-    /// Frames per second as double
-    [[nodiscard]] double fps() const {
-        return frameRate.toDouble();
-    }
-};
-
 /**
  * @brief A sequence (timeline composition)
  * 
@@ -66,6 +48,18 @@ public:
         addAudioTrack();
     }
     
+    /**
+     * @brief Construct with a known ID (used when loading projects)
+     * 
+     * No default tracks are created; the loader adds them.
+     */
+    Sequence(const UUID& id, const std::string& name)
+        : m_id(id)
+        , m_name(name)
+    {
+        commitChange(SequenceChange::wholeTimeline());
+    }
+    
     // ========== Identification ==========
     
     [[nodiscard]] const UUID& id() const { return m_id; }
@@ -77,7 +71,10 @@ public:
     
     [[nodiscard]] const SequenceSettings& settings() const { return m_settings; }
     SequenceSettings& settings() { return m_settings; }
-    void setSettings(const SequenceSettings& settings) { m_settings = settings; }
+    void setSettings(const SequenceSettings& settings) {
+        m_settings = settings;
+        commitChange(SequenceChange::wholeTimeline());
+    }
     
     // ========== Track Management ==========
     
@@ -100,6 +97,7 @@ public:
         }
         
         trackAdded.fire(track);
+        commitChange(SequenceChange::wholeTimeline());
         return track;
     }
     
@@ -122,16 +120,40 @@ public:
         }
         
         trackAdded.fire(track);
+        commitChange(SequenceChange::wholeTimeline());
+        return track;
+    }
+    
+    /**
+     * @brief Append an existing track
+     * 
+     * The track goes to the video or audio stack depending on its type.
+     * 
+     * @param track Track to append
+     * @return The appended track
+     */
+    TrackPtr addTrack(TrackPtr track) {
+        if (!track) return nullptr;
+        
+        auto& tracks = (track->type() == TrackType::Video) ? m_videoTracks : m_audioTracks;
+        track->setIndex(static_cast<int>(tracks.size()));
+        tracks.push_back(track);
+        
+        trackAdded.fire(track);
+        commitChange(SequenceChange::wholeTimeline());
         return track;
     }
     
     /**
      * @brief Remove a track
      * 
-     * @param trackId UUID of track to remove
+     * @param id UUID of track to remove
      * @return true if removed
      */
-    bool removeTrack(const UUID& trackId) {
+    bool removeTrack(const UUID& id) {
+        // Copy: id may refer into the track being erased
+        const UUID trackId = id;
+        
         // Try video tracks
         auto vit = std::find_if(m_videoTracks.begin(), m_videoTracks.end(),
             [&trackId](const TrackPtr& t) { return t->id() == trackId; });
@@ -140,6 +162,7 @@ public:
             m_videoTracks.erase(vit);
             updateTrackIndices();
             trackRemoved.fire(trackId);
+            commitChange(SequenceChange::wholeTimeline());
             return true;
         }
         
@@ -151,6 +174,7 @@ public:
             m_audioTracks.erase(ait);
             updateAudioTrackIndices();
             trackRemoved.fire(trackId);
+            commitChange(SequenceChange::wholeTimeline());
             return true;
         }
         
@@ -252,7 +276,27 @@ public:
         
         return result;
     }
-    
+
+    /**
+     * @brief IDs of the sequences nested directly in this one
+     *
+     * Each ID is listed once, in track order.
+     */
+    [[nodiscard]] std::vector<UUID> nestedSequenceIds() const {
+        std::vector<UUID> result;
+        for (const auto* tracks : {&m_videoTracks, &m_audioTracks}) {
+            for (const auto& track : *tracks) {
+                for (const auto& clip : track->clips()) {
+                    if (clip->isNested() &&
+                        std::find(result.begin(), result.end(), clip->sequenceId()) == result.end()) {
+                        result.push_back(clip->sequenceId());
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
     // ========== Duration ==========
     
     /**
@@ -286,16 +330,23 @@ public:
     [[nodiscard]] Timestamp playheadPosition() const { return m_playhead; }
     void setPlayheadPosition(Timestamp pos) { 
         m_playhead = pos;
+        m_editPoints.setSequencePoint(EditPointKind::Playhead, pos);
         playheadMoved.fire(pos);
     }
     
     // ========== In/Out Points ==========
     
     [[nodiscard]] Timestamp inPoint() const { return m_inPoint; }
-    void setInPoint(Timestamp pos) { m_inPoint = pos; }
+    void setInPoint(Timestamp pos) {
+        m_inPoint = pos;
+        updateInOutEditPoints();
+    }
     
     [[nodiscard]] Timestamp outPoint() const { return m_outPoint; }
-    void setOutPoint(Timestamp pos) { m_outPoint = pos; }
+    void setOutPoint(Timestamp pos) {
+        m_outPoint = pos;
+        updateInOutEditPoints();
+    }
     
     [[nodiscard]] bool hasInOutRange() const {
         return m_outPoint > m_inPoint;
@@ -305,13 +356,125 @@ public:
         return hasInOutRange() ? m_outPoint - m_inPoint : duration();
     }
     
+    // ========== Edit Points ==========
+    
+    /**
+     * @brief Sorted clip edges, in/out points and playhead
+     * 
+     * Kept current by commitChange() and the playhead and in/out
+     * setters. Use it for snapping and edit navigation instead of
+     * walking every track.
+     */
+    [[nodiscard]] const EditPointIndex& editPoints() const { return m_editPoints; }
+    
+    // ========== Revision Tracking ==========
+    
+    /**
+     * @brief Current content revision
+     * 
+     * Monotonically increasing; bumped by every committed change.
+     * Safe to read from any thread.
+     */
+    [[nodiscard]] uint64_t revision() const {
+        return m_revision.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Publish an edit to this sequence
+     * 
+     * Bumps the revision, publishes a new snapshot, updates the
+     * edit point index and fires changed. Called by commands after
+     * they modify tracks/clips.
+     */
+    void commitChange(SequenceChange change) {
+        change.revision = m_revision.fetch_add(1, std::memory_order_acq_rel) + 1;
+        
+        invalidateGaps(change);
+        updateEditPoints(change);
+        
+        auto prev = m_snapshot.load(std::memory_order_acquire);
+        m_snapshot.store(SequenceSnapshot::build(m_id, change.revision,
+            m_videoTracks, m_audioTracks, prev.get(), change),
+            std::memory_order_release);
+        
+        changed.fire(change);
+    }
+    
+    /**
+     * @brief Immutable view of the latest committed state
+     * 
+     * The only sequence accessor render threads may use. The
+     * returned snapshot stays valid (and unchanged) while held;
+     * edits publish a new one with a single atomic store.
+     */
+    [[nodiscard]] std::shared_ptr<const SequenceSnapshot> snapshot() const {
+        return m_snapshot.load(std::memory_order_acquire);
+    }
+    
     // ========== Signals ==========
     
     Signal<TrackPtr> trackAdded;
     Signal<UUID> trackRemoved;
     Signal<Timestamp> playheadMoved;
     
+    /// Emitted after each committed edit with its dirty region
+    Signal<const SequenceChange&> changed;
+    
 private:
+    /// Commands may have moved clips through Clip setters
+    void invalidateGaps(const SequenceChange& change) {
+        if (change.trackIds.empty()) {
+            for (const auto& track : m_videoTracks) track->invalidateGaps();
+            for (const auto& track : m_audioTracks) track->invalidateGaps();
+            return;
+        }
+        for (const auto& trackId : change.trackIds) {
+            if (auto track = getTrack(trackId)) track->invalidateGaps();
+        }
+    }
+    
+    /// Re-index the clips a change names (every clip if it names no tracks)
+    void updateEditPoints(const SequenceChange& change) {
+        if (change.trackIds.empty()) {
+            m_editPoints.rebuild(m_videoTracks, m_audioTracks);
+            m_editPoints.setSequencePoint(EditPointKind::Playhead, m_playhead);
+            updateInOutEditPoints();
+            return;
+        }
+        
+        // Commands name every clip they touch and the tracks involved;
+        // a named clip missing from all of those tracks was removed
+        std::vector<TrackPtr> tracks;
+        tracks.reserve(change.trackIds.size());
+        for (const auto& trackId : change.trackIds) {
+            if (auto track = getTrack(trackId)) tracks.push_back(std::move(track));
+        }
+        
+        for (const auto& clipId : change.clipIds) {
+            bool found = false;
+            for (const auto& track : tracks) {
+                if (auto clip = track->getClip(clipId)) {
+                    m_editPoints.setClip(*clip, track->id());
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                m_editPoints.removeClip(clipId);
+            }
+        }
+    }
+    
+    void updateInOutEditPoints() {
+        if (hasInOutRange()) {
+            m_editPoints.setSequencePoint(EditPointKind::InPoint, m_inPoint);
+            m_editPoints.setSequencePoint(EditPointKind::OutPoint, m_outPoint);
+        } else {
+            m_editPoints.setSequencePoint(EditPointKind::InPoint, std::nullopt);
+            m_editPoints.setSequencePoint(EditPointKind::OutPoint, std::nullopt);
+        }
+    }
+    
     void updateTrackIndices() {
         for (size_t i = 0; i < m_videoTracks.size(); ++i) {
             m_videoTracks[i]->setIndex(static_cast<int>(i));
@@ -334,6 +497,11 @@ private:
     Timestamp m_playhead = 0;
     Timestamp m_inPoint = 0;
     Timestamp m_outPoint = 0;
+    
+    EditPointIndex m_editPoints;
+    
+    std::atomic<uint64_t> m_revision{0};
+    std::atomic<std::shared_ptr<const SequenceSnapshot>> m_snapshot;
 };
 
 } // namespace phoenix::model
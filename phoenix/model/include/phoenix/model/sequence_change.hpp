@@ -0,0 +1,99 @@
+/**
+ * @file sequence_change.hpp
+ * @brief Description of an edit applied to a Sequence
+ *
+ * Every edit that changes what a sequence renders is published as
+ * a SequenceChange: the revision it produced, the timeline range
+ * whose output may differ, and the tracks/clips involved. Caches use
+ * it to invalidate only what an edit actually touched.
+ */
+
+#pragma once
+
+#include <phoenix/core/types.hpp>
+#include <phoenix/core/uuid.hpp>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace phoenix::model {
+
+/**
+ * @brief Dirty region produced by a single edit
+ *
+ * The time range is half-open [start, end). An empty change
+ * (start >= end) covers nothing.
+ */
+struct SequenceChange {
+    /// Sequence revision after this change was applied
+    uint64_t revision = 0;
+
+    /// Affected timeline range (microseconds, end exclusive)
+    Timestamp start = 0;
+    Timestamp end = 0;
+
+    /// Tracks whose content changed
+    std::vector<UUID> trackIds;
+
+    /// Clips that were added, removed or modified
+    std::vector<UUID> clipIds;
+
+    /// Change covering the whole timeline (e.g. track added/removed)
+    [[nodiscard]] static SequenceChange wholeTimeline() {
+        SequenceChange change;
+        change.start = std::numeric_limits<Timestamp>::min();
+        change.end = std::numeric_limits<Timestamp>::max();
+        return change;
+    }
+
+    /// Extend the dirty range to include [s, e)
+    void addRange(Timestamp s, Timestamp e) {
+        if (s >= e) return;
+        if (isEmpty()) {
+            start = s;
+            end = e;
+        } else {
+            start = std::min(start, s);
+            end = std::max(end, e);
+        }
+    }
+
+    void addTrack(const UUID& trackId) {
+        if (std::find(trackIds.begin(), trackIds.end(), trackId) == trackIds.end()) {
+            trackIds.push_back(trackId);
+        }
+    }
+
+    void addClip(const UUID& clipId) {
+        if (std::find(clipIds.begin(), clipIds.end(), clipId) == clipIds.end()) {
+            clipIds.push_back(clipId);
+        }
+    }
+
+    /// Merge another change into this one (revision is not touched)
+    void merge(const SequenceChange& other) {
+        addRange(other.start, other.end);
+        for (const auto& id : other.trackIds) addTrack(id);
+        for (const auto& id : other.clipIds) addClip(id);
+    }
+
+    [[nodiscard]] bool isEmpty() const { return start >= end; }
+
+    /// Check if the dirty range intersects [s, e)
+    [[nodiscard]] bool intersects(Timestamp s, Timestamp e) const {
+        return !isEmpty() && s < end && start < e;
+    }
+
+    /// Check if a single timeline position is dirty
+    [[nodiscard]] bool contains(Timestamp time) const {
+        return time >= start && time < end;
+    }
+
+    /// Check if a track was affected (empty track list = all tracks)
+    [[nodiscard]] bool affectsTrack(const UUID& trackId) const {
+        return trackIds.empty() ||
+            std::find(trackIds.begin(), trackIds.end(), trackId) != trackIds.end();
+    }
+};
+
+} // namespace phoenix::model
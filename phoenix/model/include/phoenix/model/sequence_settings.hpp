@@ -0,0 +1,35 @@
+/**
+ * @file sequence_settings.hpp
+ * @brief Output format settings of a Sequence
+ */
+
+#pragma once
+
+#include <phoenix/core/types.hpp>
+
+namespace phoenix::model {
+
+/**
+ * @brief Sequence settings
+ */
+struct SequenceSettings {
+    Size resolution{1920, 1080};        // Output resolution
+    Rational frameRate{30000, 1001};    // ~29.97 fps
+    int sampleRate = 48000;             // Audio sample rate
+    int audioChannels = 2;              // Stereo
+    
+    /// Frame duration in microseconds
+    [[nodiscard]] Duration frameDuration() const {
+        if (frameRate.num == 0) return 0;
+        return static_cast<Duration>(
+            static_cast<double>(kTimeBaseUs) * frameRate.den / frameRate.num
+        );
+    }
+    
+    /// Frames per second as double
+    [[nodiscard]] double fps() const {
+        return frameRate.toDouble();
+    }
+};
+
+} // namespace phoenix::model
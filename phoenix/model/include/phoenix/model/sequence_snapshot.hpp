@@ -0,0 +1,240 @@
+/**
+ * @file sequence_snapshot.hpp
+ * @brief Immutable, structurally shared views of a Sequence
+ *
+ * The UI thread edits Sequence/Track/Clip in place. Render threads
+ * must not walk those objects. Every committed change instead
+ * publishes a new SequenceSnapshot, which render threads read without
+ * synchronization.
+ *
+ * Snapshots are copy-on-write. Tracks untouched by a change are
+ * shared with the previous snapshot. A touched track is rebuilt by
+ * walking all of its clips, but only the clips the change names are
+ * copied; the others are shared. Publishing therefore costs the clip
+ * count of the touched tracks, not of the whole sequence.
+ */
+
+#pragma once
+
+#include <phoenix/core/types.hpp>
+#include <phoenix/core/uuid.hpp>
+#include <phoenix/model/clip.hpp>
+#include <phoenix/model/track.hpp>
+#include <phoenix/model/sequence_change.hpp>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <memory>
+#include <algorithm>
+
+namespace phoenix::model {
+
+/**
+ * @brief Immutable copy of a track and its clips
+ *
+ * Clips are frozen copies sorted by timeline position.
+ */
+class TrackSnapshot {
+public:
+    using ClipPtr = std::shared_ptr<const Clip>;
+
+    /**
+     * @brief Snapshot a track, reusing unchanged clips from @p prev
+     *
+     * A clip is copied only if @p change names it (or it is new);
+     * every other clip node is shared with @p prev.
+     */
+    static std::shared_ptr<const TrackSnapshot> build(
+        const Track& track,
+        const TrackSnapshot* prev,
+        const SequenceChange& change)
+    {
+        return build(track, prev,
+            std::unordered_set<UUID>(change.clipIds.begin(), change.clipIds.end()));
+    }
+    
+    /// @copydoc build(), with the changed clip IDs already hashed
+    static std::shared_ptr<const TrackSnapshot> build(
+        const Track& track,
+        const TrackSnapshot* prev,
+        const std::unordered_set<UUID>& changedClips)
+    {
+        auto snap = std::make_shared<TrackSnapshot>();
+        snap->m_id = track.id();
+        snap->m_name = track.name();
+        snap->m_type = track.type();
+        snap->m_index = track.index();
+        snap->m_muted = track.muted();
+        snap->m_locked = track.locked();
+        snap->m_hidden = track.hidden();
+        snap->m_solo = track.solo();
+
+        snap->m_clips.reserve(track.clipCount());
+        for (const auto& clip : track.clips()) {
+            ClipPtr reused;
+            if (prev && !changedClips.count(clip->id())) {
+                reused = prev->findClip(clip->id(), clip->timelineIn());
+            }
+            snap->m_clips.push_back(reused ? reused : std::make_shared<const Clip>(*clip));
+        }
+
+        snap->m_duration = snap->m_clips.empty() ? 0 : snap->m_clips.back()->timelineOut();
+        return snap;
+    }
+
+    // ========== Properties ==========
+
+    [[nodiscard]] const UUID& id() const { return m_id; }
+    [[nodiscard]] const std::string& name() const { return m_name; }
+    [[nodiscard]] TrackType type() const { return m_type; }
+    [[nodiscard]] int index() const { return m_index; }
+    [[nodiscard]] bool muted() const { return m_muted; }
+    [[nodiscard]] bool locked() const { return m_locked; }
+    [[nodiscard]] bool hidden() const { return m_hidden; }
+    [[nodiscard]] bool solo() const { return m_solo; }
+
+    /// Track end (end of last clip)
+    [[nodiscard]] Duration duration() const { return m_duration; }
+
+    // ========== Clips ==========
+
+    [[nodiscard]] const std::vector<ClipPtr>& clips() const { return m_clips; }
+
+    /**
+     * @brief Get clip at a timeline position (binary search)
+     */
+    [[nodiscard]] ClipPtr getClipAt(Timestamp time) const {
+        auto it = std::upper_bound(m_clips.begin(), m_clips.end(), time,
+            [](Timestamp t, const ClipPtr& c) { return t < c->timelineIn(); });
+        if (it == m_clips.begin()) return nullptr;
+        --it;
+        return (*it)->containsTime(time) ? *it : nullptr;
+    }
+
+    /**
+     * @brief Find a clip by ID, starting at its timeline position
+     */
+    [[nodiscard]] ClipPtr findClip(const UUID& clipId, Timestamp timelineIn) const {
+        auto it = std::lower_bound(m_clips.begin(), m_clips.end(), timelineIn,
+            [](const ClipPtr& c, Timestamp t) { return c->timelineIn() < t; });
+        for (; it != m_clips.end() && (*it)->timelineIn() == timelineIn; ++it) {
+            if ((*it)->id() == clipId) return *it;
+        }
+        return nullptr;
+    }
+
+private:
+    UUID m_id;
+    std::string m_name;
+    TrackType m_type = TrackType::Video;
+    int m_index = 0;
+    bool m_muted = false;
+    bool m_locked = false;
+    bool m_hidden = false;
+    bool m_solo = false;
+    Duration m_duration = 0;
+    std::vector<ClipPtr> m_clips;
+};
+
+/**
+ * @brief Immutable view of a whole sequence at one revision
+ *
+ * Holds the timeline content the compositor and playback engine
+ * read. Settings are not included; they change only while playback
+ * is reconfigured on the UI thread. Safe to use from any thread for
+ * as long as the pointer is held.
+ */
+class SequenceSnapshot {
+public:
+    using TrackPtr = std::shared_ptr<const TrackSnapshot>;
+    using ClipPtr = TrackSnapshot::ClipPtr;
+
+    /**
+     * @brief Build the snapshot for a new revision
+     *
+     * Tracks the change does not affect are shared with @p prev.
+     */
+    static std::shared_ptr<const SequenceSnapshot> build(
+        const UUID& id,
+        uint64_t revision,
+        const std::vector<std::shared_ptr<Track>>& videoTracks,
+        const std::vector<std::shared_ptr<Track>>& audioTracks,
+        const SequenceSnapshot* prev,
+        const SequenceChange& change)
+    {
+        auto snap = std::make_shared<SequenceSnapshot>();
+        snap->m_id = id;
+        snap->m_revision = revision;
+
+        // Batch edits can name thousands of clips
+        const std::unordered_set<UUID> changedClips(
+            change.clipIds.begin(), change.clipIds.end());
+
+        auto snapshotTracks = [&](const std::vector<std::shared_ptr<Track>>& tracks,
+                                  const std::vector<TrackPtr>* prevTracks,
+                                  std::vector<TrackPtr>& out) {
+            out.reserve(tracks.size());
+            for (const auto& track : tracks) {
+                const TrackPtr* prevTrack = nullptr;
+                if (prevTracks) {
+                    auto it = std::find_if(prevTracks->begin(), prevTracks->end(),
+                        [&](const TrackPtr& t) { return t->id() == track->id(); });
+                    if (it != prevTracks->end()) prevTrack = &*it;
+                }
+
+                if (prevTrack && !change.affectsTrack(track->id()) &&
+                    (*prevTrack)->index() == track->index()) {
+                    out.push_back(*prevTrack);
+                } else {
+                    out.push_back(TrackSnapshot::build(*track,
+                        prevTrack ? prevTrack->get() : nullptr, changedClips));
+                }
+                snap->m_duration = std::max(snap->m_duration, out.back()->duration());
+            }
+        };
+
+        snapshotTracks(videoTracks, prev ? &prev->m_videoTracks : nullptr, snap->m_videoTracks);
+        snapshotTracks(audioTracks, prev ? &prev->m_audioTracks : nullptr, snap->m_audioTracks);
+        return snap;
+    }
+
+    // ========== Properties ==========
+
+    [[nodiscard]] const UUID& id() const { return m_id; }
+
+    /// Sequence revision this snapshot reflects
+    [[nodiscard]] uint64_t revision() const { return m_revision; }
+
+    /// Total duration (end of last clip)
+    [[nodiscard]] Duration duration() const { return m_duration; }
+
+    // ========== Tracks ==========
+
+    [[nodiscard]] const std::vector<TrackPtr>& videoTracks() const { return m_videoTracks; }
+    [[nodiscard]] const std::vector<TrackPtr>& audioTracks() const { return m_audioTracks; }
+
+    /**
+     * @brief Get visible video clips at a time (bottom to top)
+     */
+    [[nodiscard]] std::vector<ClipPtr> getVisibleClipsAt(Timestamp time) const {
+        std::vector<ClipPtr> result;
+        for (const auto& track : m_videoTracks) {
+            if (track->hidden() || track->muted()) continue;
+            if (auto clip = track->getClipAt(time)) {
+                if (!clip->disabled()) {
+                    result.push_back(std::move(clip));
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    UUID m_id;
+    uint64_t m_revision = 0;
+    Duration m_duration = 0;
+    std::vector<TrackPtr> m_videoTracks;
+    std::vector<TrackPtr> m_audioTracks;
+};
+
+} // namespace phoenix::model
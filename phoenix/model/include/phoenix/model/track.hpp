@@ -13,8 +13,11 @@
 #include <phoenix/core/signals.hpp>
 #include <phoenix/model/clip.hpp>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <algorithm>
+#include <limits>
 #include <optional>
 
 namespace phoenix::model {
@@ -27,11 +30,39 @@ enum class TrackType {
     Audio,  // Audio track (clips are mixed)
 };
 
+/**
+ * @brief Timeline and source placement of one clip
+ * 
+ * Used by batch edits: a batch is a list of new placements, and
+ * its undo is the list of old ones.
+ */
+struct ClipPlacement {
+    UUID clipId;
+    Timestamp timelineIn = 0;
+    Timestamp timelineOut = 0;
+    Timestamp sourceIn = 0;
+    Timestamp sourceOut = 0;
+    
+    /// Current placement of a clip
+    [[nodiscard]] static ClipPlacement of(const Clip& clip) {
+        return {clip.id(), clip.timelineIn(), clip.timelineOut(),
+                clip.sourceIn(), clip.sourceOut()};
+    }
+    
+    void applyTo(Clip& clip) const {
+        clip.setTimelineIn(timelineIn);
+        clip.setTimelineOut(timelineOut);
+        clip.setSourceIn(sourceIn);
+        clip.setSourceOut(sourceOut);
+    }
+};
+
 /**
  * @brief A track containing clips
  * 
  * Clips on a track cannot overlap. The track maintains
- * clips sorted by timeline position.
+ * clips sorted by timeline position, so lookups and overlap
+ * checks are binary searches rather than scans.
  */
 class Track {
 public:
@@ -44,6 +75,12 @@ public:
         , m_type(type)
     {}
     
+    /// Construct with a known ID (used when loading projects)
+    Track(const UUID& id, TrackType type)
+        : m_id(id)
+        , m_type(type)
+    {}
+    
     // ========== Identification ==========
     
     [[nodiscard]] const UUID& id() const { return m_id; }
@@ -80,6 +117,10 @@ public:
     /**
      * @brief Add a clip to the track
      * 
+     * The clip is inserted at its sorted position; only the
+     * neighbouring clips are checked for overlap, so insertion
+     * is O(log n) plus the vector shift.
+     * 
      * @param clip Clip to add
      * @return true if added, false if overlaps with existing clip
      */
@@ -92,8 +133,9 @@ public:
         }
         
         clip->setTrackIndex(m_index);
-        m_clips.push_back(clip);
-        sortClips();
+        m_clips.insert(upperBound(clip->timelineIn()), clip);
+        m_clipIndex[clip->id()] = clip;
+        m_gapTreeValid = false;
         
         clipAdded.fire(clip);
         return true;
@@ -106,15 +148,15 @@ public:
      * @return The removed clip, or nullptr if not found
      */
     ClipPtr removeClip(const UUID& clipId) {
-        auto it = std::find_if(m_clips.begin(), m_clips.end(),
-            [&clipId](const ClipPtr& c) { return c->id() == clipId; });
-        
-        if (it == m_clips.end()) {
+        auto indexIt = m_clipIndex.find(clipId);
+        if (indexIt == m_clipIndex.end()) {
             return nullptr;
         }
         
-        ClipPtr clip = *it;
-        m_clips.erase(it);
+        ClipPtr clip = indexIt->second;
+        m_clipIndex.erase(indexIt);
+        m_clips.erase(findPosition(clip.get()));
+        m_gapTreeValid = false;
         clip->setTrackIndex(-1);
         
         clipRemoved.fire(clipId);
@@ -126,30 +168,42 @@ public:
      */
     void clearClips() {
         m_clips.clear();
+        m_clipIndex.clear();
+        m_gapTreeValid = false;
         clipsCleared.fire();
     }
     
+    /**
+     * @brief Reserve storage for an expected number of clips
+     * 
+     * Useful when building large tracks (project load, batch edits).
+     */
+    void reserveClips(size_t count) {
+        m_clips.reserve(count);
+        m_clipIndex.reserve(count);
+    }
+    
     // ========== Clip Lookup ==========
     
     /**
      * @brief Get clip by ID
      */
     [[nodiscard]] ClipPtr getClip(const UUID& clipId) const {
-        auto it = std::find_if(m_clips.begin(), m_clips.end(),
-            [&clipId](const ClipPtr& c) { return c->id() == clipId; });
-        return (it != m_clips.end()) ? *it : nullptr;
+        auto it = m_clipIndex.find(clipId);
+        return (it != m_clipIndex.end()) ? it->second : nullptr;
     }
     
     /**
      * @brief Get clip at timeline position
      */
     [[nodiscard]] ClipPtr getClipAt(Timestamp time) const {
-        for (const auto& clip : m_clips) {
-            if (clip->containsTime(time)) {
-                return clip;
-            }
+        // Last clip starting at or before time is the only candidate
+        auto it = upperBound(time);
+        if (it == m_clips.begin()) {
+            return nullptr;
         }
-        return nullptr;
+        --it;
+        return (*it)->containsTime(time) ? *it : nullptr;
     }
     
     /**
@@ -159,10 +213,12 @@ public:
         Timestamp start, Timestamp end) const 
     {
         std::vector<ClipPtr> result;
-        for (const auto& clip : m_clips) {
-            if (clip->timelineOut() > start && clip->timelineIn() < end) {
-                result.push_back(clip);
-            }
+        
+        // Clips don't overlap, so timelineOut is sorted as well
+        auto it = std::upper_bound(m_clips.begin(), m_clips.end(), start,
+            [](Timestamp t, const ClipPtr& c) { return t < c->timelineOut(); });
+        for (; it != m_clips.end() && (*it)->timelineIn() < end; ++it) {
+            result.push_back(*it);
         }
         return result;
     }
@@ -201,6 +257,9 @@ public:
     /**
      * @brief Check if a time range overlaps with existing clips
      * 
+     * Since clips never overlap each other, the only candidate is
+     * the last clip starting before @p end.
+     * 
      * @param start Start time
      * @param end End time
      * @param excludeClip Clip to exclude from check (for move operations)
@@ -209,13 +268,15 @@ public:
         Timestamp start, Timestamp end, 
         const Clip* excludeClip) const 
     {
-        for (const auto& clip : m_clips) {
-            if (excludeClip && clip.get() == excludeClip) continue;
+        auto it = std::lower_bound(m_clips.begin(), m_clips.end(), end,
+            [](const ClipPtr& c, Timestamp t) { return c->timelineIn() < t; });
+        
+        while (it != m_clips.begin()) {
+            --it;
+            if (excludeClip && it->get() == excludeClip) continue;
             
             // Check for overlap: !(end1 <= start2 || end2 <= start1)
-            if (!(end <= clip->timelineIn() || clip->timelineOut() <= start)) {
-                return true;
-            }
+            return !(end <= (*it)->timelineIn() || (*it)->timelineOut() <= start);
         }
         return false;
     }
@@ -223,6 +284,10 @@ public:
     /**
      * @brief Find next gap after a position
      * 
+     * Searches a max-gap tree over the gaps between neighbouring
+     * clips, so a long run of small gaps is skipped in O(log n). The
+     * tree is rebuilt (O(n)) on the first search after an edit.
+     * 
      * @param afterTime Position to search from
      * @param minDuration Minimum gap duration
      * @return Start time of gap, or nullopt if no gap found
@@ -239,20 +304,32 @@ public:
             return afterTime;
         }
         
-        // Check gaps between clips
-        for (size_t i = 0; i < m_clips.size() - 1; ++i) {
-            Timestamp gapStart = m_clips[i]->timelineOut();
-            Timestamp gapEnd = m_clips[i + 1]->timelineIn();
-            
-            if (gapStart >= afterTime && gapEnd - gapStart >= minDuration) {
-                return gapStart;
-            }
+        // Skip straight to the first clip ending at or after afterTime,
+        // then to the first gap after it that is wide enough
+        auto it = std::lower_bound(m_clips.begin(), m_clips.end(), afterTime,
+            [](const ClipPtr& c, Timestamp t) { return c->timelineOut() < t; });
+        auto first = static_cast<size_t>(it - m_clips.begin());
+        
+        size_t gap = firstGapFrom(first, minDuration);
+        if (gap != kNoGap) {
+            return m_clips[gap]->timelineOut();
         }
         
         // Return end of last clip
         return m_clips.back()->timelineOut();
     }
     
+    /**
+     * @brief Note that clip bounds changed behind the track's back
+     * 
+     * Commands that move or trim clips through Clip setters must call
+     * this (Sequence::commitChange does, for every track the change
+     * names) so findGap does not search stale gaps.
+     */
+    void invalidateGaps() {
+        m_gapTreeValid = false;
+    }
+    
     // ========== Clip Operations ==========
     
     /**
@@ -274,14 +351,144 @@ public:
             return false;
         }
         
+        // Rotate the clip from its old slot into its new one
+        auto from = findPosition(clip.get());
+        Timestamp oldTimelineIn = clip->timelineIn();
         clip->setTimelineIn(newTimelineIn);
         clip->setTimelineOut(newTimelineOut);
-        sortClips();
+        
+        auto byIn = [](Timestamp t, const ClipPtr& c) { return t < c->timelineIn(); };
+        if (newTimelineIn > oldTimelineIn) {
+            auto to = std::upper_bound(std::next(from), m_clips.end(), newTimelineIn, byIn);
+            std::rotate(from, std::next(from), to);
+        } else if (newTimelineIn < oldTimelineIn) {
+            auto to = std::upper_bound(m_clips.begin(), from, newTimelineIn, byIn);
+            std::rotate(to, from, std::next(from));
+        }
+        m_gapTreeValid = false;
         
         clipMoved.fire(clip);
         return true;
     }
     
+    /**
+     * @brief Move a clip's start, stopping at the previous clip
+     * 
+     * The clip's slot cannot change: its start stays between the
+     * previous clip's end and its own end.
+     * 
+     * @return Start applied, or nullopt if the clip is missing or the
+     *         trim would leave it empty
+     */
+    std::optional<Timestamp> trimClipStart(const UUID& clipId, Timestamp newTimelineIn) {
+        auto clip = getClip(clipId);
+        if (!clip) return std::nullopt;
+        
+        auto it = findPosition(clip.get());
+        if (it != m_clips.begin()) {
+            newTimelineIn = std::max(newTimelineIn, (*std::prev(it))->timelineOut());
+        }
+        if (newTimelineIn >= clip->timelineOut()) return std::nullopt;
+        
+        clip->setTimelineIn(newTimelineIn);
+        m_gapTreeValid = false;
+        return newTimelineIn;
+    }
+    
+    /**
+     * @brief Move a clip's end, stopping at the next clip
+     * 
+     * @return End applied, or nullopt if the clip is missing or the
+     *         trim would leave it empty
+     */
+    std::optional<Timestamp> trimClipEnd(const UUID& clipId, Timestamp newTimelineOut) {
+        auto clip = getClip(clipId);
+        if (!clip) return std::nullopt;
+        
+        auto next = std::next(findPosition(clip.get()));
+        if (next != m_clips.end()) {
+            newTimelineOut = std::min(newTimelineOut, (*next)->timelineIn());
+        }
+        if (newTimelineOut <= clip->timelineIn()) return std::nullopt;
+        
+        clip->setTimelineOut(newTimelineOut);
+        m_gapTreeValid = false;
+        return newTimelineOut;
+    }
+    
+    /**
+     * @brief Reposition many clips in one pass
+     * 
+     * All placements are applied, the sorted order is rebuilt with
+     * a single merge (untouched clips keep their relative order),
+     * and overlaps are checked in one linear scan. O(n + k log k)
+     * for k placements on a track of n clips, instead of k separate
+     * moves.
+     * 
+     * The edit is all-or-nothing: if a clip is missing, listed
+     * twice, left empty or would overlap another, nothing changes.
+     * Fires clipsChanged once on success.
+     * 
+     * @return true if applied
+     */
+    bool applyPlacements(const std::vector<ClipPlacement>& placements) {
+        if (placements.empty()) return true;
+        
+        // Resolve clips and remember their state for rollback
+        std::vector<ClipPtr> edited;
+        std::vector<ClipPlacement> previous;
+        std::unordered_set<const Clip*> editedSet;
+        edited.reserve(placements.size());
+        previous.reserve(placements.size());
+        editedSet.reserve(placements.size());
+        
+        for (const auto& placement : placements) {
+            auto clip = getClip(placement.clipId);
+            if (!clip || placement.timelineOut <= placement.timelineIn ||
+                !editedSet.insert(clip.get()).second) {
+                return false;
+            }
+            edited.push_back(clip);
+            previous.push_back(ClipPlacement::of(*clip));
+        }
+        
+        for (size_t i = 0; i < edited.size(); ++i) {
+            placements[i].applyTo(*edited[i]);
+        }
+        
+        // Untouched clips are still sorted; merge the edited ones in
+        auto byIn = [](const ClipPtr& a, const ClipPtr& b) {
+            return a->timelineIn() < b->timelineIn();
+        };
+        std::vector<ClipPtr> moved = edited;
+        std::sort(moved.begin(), moved.end(), byIn);
+        
+        std::vector<ClipPtr> kept;
+        kept.reserve(m_clips.size() - moved.size());
+        for (const auto& clip : m_clips) {
+            if (!editedSet.count(clip.get())) kept.push_back(clip);
+        }
+        
+        std::vector<ClipPtr> next;
+        next.reserve(m_clips.size());
+        std::merge(kept.begin(), kept.end(), moved.begin(), moved.end(),
+                   std::back_inserter(next), byIn);
+        
+        for (size_t i = 1; i < next.size(); ++i) {
+            if (next[i - 1]->timelineOut() > next[i]->timelineIn()) {
+                for (size_t j = 0; j < edited.size(); ++j) {
+                    previous[j].applyTo(*edited[j]);
+                }
+                return false;
+            }
+        }
+        
+        m_clips.swap(next);
+        m_gapTreeValid = false;
+        clipsChanged.fire();
+        return true;
+    }
+    
     // ========== Signals ==========
     
     Signal<ClipPtr> clipAdded;
@@ -289,12 +496,80 @@ public:
     Signal<ClipPtr> clipMoved;
     VoidSignal clipsCleared;
     
+    /// Emitted once per batch edit (applyPlacements)
+    VoidSignal clipsChanged;
+    
 private:
-    void sortClips() {
-        std::sort(m_clips.begin(), m_clips.end(),
-            [](const ClipPtr& a, const ClipPtr& b) {
-                return a->timelineIn() < b->timelineIn();
-            });
+    using ClipIterator = std::vector<ClipPtr>::iterator;
+    using ConstClipIterator = std::vector<ClipPtr>::const_iterator;
+    
+    static constexpr size_t kNoGap = static_cast<size_t>(-1);
+    
+    /**
+     * @brief First gap at index >= @p first at least @p minDuration wide
+     * 
+     * Gap i lies between clip i and clip i + 1. Returns kNoGap if none.
+     */
+    size_t firstGapFrom(size_t first, Duration minDuration) const {
+        if (m_clips.size() < 2 || first >= m_clips.size() - 1) return kNoGap;
+        
+        if (!m_gapTreeValid) rebuildGapTree();
+        return firstGapIn(1, 0, m_gapLeaves, first, minDuration);
+    }
+    
+    /// Descend into the subtree of @p node covering gaps [lo, hi)
+    size_t firstGapIn(size_t node, size_t lo, size_t hi,
+                      size_t first, Duration minDuration) const {
+        if (hi <= first || m_gapTree[node] < minDuration) return kNoGap;
+        if (hi - lo == 1) return lo;
+        
+        size_t mid = lo + (hi - lo) / 2;
+        size_t found = firstGapIn(2 * node, lo, mid, first, minDuration);
+        if (found != kNoGap) return found;
+        return firstGapIn(2 * node + 1, mid, hi, first, minDuration);
+    }
+    
+    /// Bottom-up max tree over the gaps; unused leaves never match
+    void rebuildGapTree() const {
+        size_t gaps = m_clips.size() - 1;
+        m_gapLeaves = 1;
+        while (m_gapLeaves < gaps) m_gapLeaves <<= 1;
+        
+        m_gapTree.assign(2 * m_gapLeaves, std::numeric_limits<Duration>::min());
+        for (size_t i = 0; i < gaps; ++i) {
+            m_gapTree[m_gapLeaves + i] = m_clips[i + 1]->timelineIn() - m_clips[i]->timelineOut();
+        }
+        for (size_t node = m_gapLeaves - 1; node > 0; --node) {
+            m_gapTree[node] = std::max(m_gapTree[2 * node], m_gapTree[2 * node + 1]);
+        }
+        m_gapTreeValid = true;
+    }
+    
+    /// First clip starting strictly after @p time
+    ClipIterator upperBound(Timestamp time) {
+        return std::upper_bound(m_clips.begin(), m_clips.end(), time,
+            [](Timestamp t, const ClipPtr& c) { return t < c->timelineIn(); });
+    }
+    
+    ConstClipIterator upperBound(Timestamp time) const {
+        return std::upper_bound(m_clips.begin(), m_clips.end(), time,
+            [](Timestamp t, const ClipPtr& c) { return t < c->timelineIn(); });
+    }
+    
+    /**
+     * @brief Locate a clip's slot in the sorted vector
+     * 
+     * Binary search on timelineIn; falls back to a linear scan if the
+     * clip's position was changed behind the track's back.
+     */
+    ClipIterator findPosition(const Clip* clip) {
+        auto it = std::lower_bound(m_clips.begin(), m_clips.end(), clip->timelineIn(),
+            [](const ClipPtr& c, Timestamp t) { return c->timelineIn() < t; });
+        for (; it != m_clips.end() && (*it)->timelineIn() == clip->timelineIn(); ++it) {
+            if (it->get() == clip) return it;
+        }
+        return std::find_if(m_clips.begin(), m_clips.end(),
+            [clip](const ClipPtr& c) { return c.get() == clip; });
     }
     
     UUID m_id;
@@ -307,7 +582,13 @@ private:
     bool m_hidden = false;
     bool m_solo = false;
     
-    std::vector<ClipPtr> m_clips;
+    std::vector<ClipPtr> m_clips;                      // Sorted by timelineIn
+    std::unordered_map<UUID, ClipPtr> m_clipIndex;     // Lookup by clip ID
+    
+    // Max-gap tree for findGap, built on demand
+    mutable std::vector<Duration> m_gapTree;
+    mutable size_t m_gapLeaves = 0;
+    mutable bool m_gapTreeValid = false;
 };
 
 } // namespace phoenix::model
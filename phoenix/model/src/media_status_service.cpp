@@ -0,0 +1,567 @@
+/**
+ * @file media_status_service.cpp
+ * @brief Media status service implementation
+ *
+ * On Linux the watcher thread sleeps in poll() on an inotify instance
+ * and an eventfd used to hand it requests. Elsewhere it sleeps on a
+ * condition variable and relies on rescans alone.
+ */
+
+#include <phoenix/model/media_status_service.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace phoenix::model {
+
+namespace {
+
+#ifdef __linux__
+/// Events that can change whether a file exists or what it contains.
+/// IN_MODIFY is left out: it fires per write, IN_CLOSE_WRITE once.
+constexpr uint32_t kWatchMask =
+    IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_ATTRIB |
+    IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF |
+    IN_ONLYDIR;
+#endif
+
+} // namespace
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+MediaStatusService::MediaStatusService(std::shared_ptr<Dispatcher> dispatcher)
+    : m_dispatcher(std::move(dispatcher))
+{
+    m_updatesConnection = ScopedConnection(m_updates.connectQueued(m_dispatcher,
+        [this](const std::vector<StatusUpdate>& updates) {
+            applyUpdates(updates);
+        },
+        QueuedDelivery::Every));
+}
+
+MediaStatusService::~MediaStatusService() {
+    detach();
+    stop();
+}
+
+void MediaStatusService::start() {
+    if (isRunning()) return;
+
+#ifdef __linux__
+    m_notifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = false;
+    }
+    m_thread = std::thread([this]() {
+        watcherLoop();
+    });
+    wake();     // Pick up items watched before starting
+}
+
+void MediaStatusService::stop() {
+    if (!isRunning()) return;
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+        m_requests.clear();
+    }
+    wake();
+    m_thread.join();
+
+    // Closing the inotify instance drops all of its watches
+#ifdef __linux__
+    if (m_notifyFd >= 0) ::close(m_notifyFd);
+    if (m_wakeFd >= 0) ::close(m_wakeFd);
+#endif
+    m_notifyFd = -1;
+    m_wakeFd = -1;
+
+    m_watched.clear();
+    m_directories.clear();
+    m_directoryByWd.clear();
+    m_watchedCount = 0;
+    m_directoryWatchCount = 0;
+}
+
+// ============================================================================
+// Watching
+// ============================================================================
+
+void MediaStatusService::attach(MediaBin& bin) {
+    detach();
+    m_bin = &bin;
+
+    std::vector<Request> requests;
+    requests.reserve(bin.size());
+    bin.forEach([&requests](const ItemPtr& item) {
+        requests.push_back(watchRequest(item));
+    });
+    post(std::move(requests));
+
+    m_binConnections.push_back(bin.itemAdded.connectScoped(
+        [this](const ItemPtr& item) { watch(item); }));
+
+    m_binConnections.push_back(bin.itemsAdded.connectScoped(
+        [this](const std::vector<ItemPtr>& items) {
+            std::vector<Request> requests;
+            requests.reserve(items.size());
+            for (const auto& item : items) {
+                requests.push_back(watchRequest(item));
+            }
+            post(std::move(requests));
+        }));
+
+    m_binConnections.push_back(bin.itemRemoved.connectScoped(
+        [this](const UUID& id) { unwatch(id); }));
+
+    m_binConnections.push_back(bin.itemRelinked.connectScoped(
+        [this](const ItemPtr& item) { watch(item); }));
+
+    m_binConnections.push_back(bin.cleared.connectScoped(
+        [this]() { unwatchAll(); }));
+}
+
+void MediaStatusService::detach() {
+    if (!m_bin) return;
+
+    m_binConnections.clear();
+    m_bin = nullptr;
+    unwatchAll();
+}
+
+void MediaStatusService::watch(const ItemPtr& item) {
+    if (!item) return;
+    post({watchRequest(item)});
+}
+
+void MediaStatusService::unwatch(const UUID& id) {
+    Request request;
+    request.kind = Request::Kind::Unwatch;
+    request.id = id;
+    post({std::move(request)});
+}
+
+void MediaStatusService::unwatchAll() {
+    Request request;
+    request.kind = Request::Kind::UnwatchAll;
+    post({std::move(request)});
+}
+
+void MediaStatusService::rescan() {
+    Request request;
+    request.kind = Request::Kind::Rescan;
+    post({std::move(request)});
+}
+
+void MediaStatusService::setRescanInterval(std::chrono::milliseconds interval) {
+    m_rescanInterval = std::max(interval, std::chrono::milliseconds(0));
+    wake();
+}
+
+MediaStatusStats MediaStatusService::stats() const {
+    MediaStatusStats s;
+    s.watchedItems = m_watchedCount;
+    s.watchedDirectories = m_directoryWatchCount;
+    s.events = m_events;
+    s.checks = m_checks;
+    s.rescans = m_rescans;
+    s.changes = m_changes;
+    return s;
+}
+
+// ============================================================================
+// Owner -> watcher hand-off
+// ============================================================================
+
+MediaStatusService::Request MediaStatusService::watchRequest(const ItemPtr& item) {
+    Request request;
+    request.kind = Request::Kind::Watch;
+    request.id = item->id();
+    request.item = item;
+    request.path = item->path().lexically_normal();
+    request.expectedSize = item->fileSize();
+    return request;
+}
+
+void MediaStatusService::post(std::vector<Request> requests) {
+    if (requests.empty()) return;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_requests.empty()) {
+            m_requests = std::move(requests);
+        } else {
+            m_requests.insert(m_requests.end(),
+                std::make_move_iterator(requests.begin()),
+                std::make_move_iterator(requests.end()));
+        }
+    }
+    wake();
+}
+
+void MediaStatusService::wake() {
+#ifdef __linux__
+    if (m_wakeFd >= 0) {
+        uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(m_wakeFd, &one, sizeof(one));
+        return;
+    }
+#endif
+    m_cv.notify_one();
+}
+
+// ============================================================================
+// Watcher thread
+// ============================================================================
+
+void MediaStatusService::watcherLoop() {
+    using Clock = std::chrono::steady_clock;
+
+    auto interval = m_rescanInterval.load();
+    auto nextRescan = Clock::now() + interval;
+
+    std::vector<Request> requests;
+    std::unordered_set<UUID> dirty;
+    std::vector<StatusUpdate> updates;
+
+    while (true) {
+        // Zero timeout waits for events or requests only
+        std::chrono::milliseconds timeout{0};
+        if (interval.count() > 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                nextRescan - Clock::now());
+            timeout = std::max(remaining, std::chrono::milliseconds(1));
+        }
+        bool readable = waitForEvents(timeout);
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_stop) break;
+            requests.swap(m_requests);
+        }
+
+        bool fullRescan = false;
+        if (readable) {
+            readEvents(dirty, fullRescan);
+        }
+        fullRescan |= handleRequests(requests, dirty);
+        requests.clear();
+
+        auto newInterval = m_rescanInterval.load();
+        if (newInterval != interval) {
+            interval = newInterval;
+            nextRescan = Clock::now() + interval;
+        }
+        if (interval.count() > 0 && Clock::now() >= nextRescan) {
+            fullRescan = true;
+        }
+
+        if (fullRescan) {
+            ++m_rescans;
+            nextRescan = Clock::now() + interval;
+            for (auto& [path, dir] : m_directories) {
+                addDirectoryWatch(path, dir);   // Retry directories that were missing
+            }
+            for (const auto& [id, watched] : m_watched) {
+                dirty.insert(id);
+            }
+        }
+
+        for (const auto& id : dirty) {
+            check(id, updates);
+        }
+        dirty.clear();
+
+        if (!updates.empty()) {
+            m_changes += updates.size();
+            m_updates.fire(updates);
+            updates.clear();
+        }
+    }
+}
+
+bool MediaStatusService::waitForEvents(std::chrono::milliseconds timeout) {
+#ifdef __linux__
+    if (m_wakeFd >= 0) {
+        pollfd fds[2] = {
+            {m_wakeFd, POLLIN, 0},
+            {m_notifyFd, POLLIN, 0},
+        };
+        nfds_t count = m_notifyFd >= 0 ? 2 : 1;
+        int ms = timeout.count() > 0
+            ? static_cast<int>(std::min<int64_t>(timeout.count(), INT_MAX))
+            : -1;
+
+        int ready = ::poll(fds, count, ms);
+        if (ready <= 0) return false;
+
+        if (fds[0].revents & POLLIN) {
+            uint64_t value = 0;
+            [[maybe_unused]] auto read = ::read(m_wakeFd, &value, sizeof(value));
+        }
+        return count == 2 && (fds[1].revents & POLLIN);
+    }
+#endif
+
+    std::unique_lock lock(m_mutex);
+    auto woken = [this]() { return m_stop || !m_requests.empty(); };
+    if (timeout.count() > 0) {
+        m_cv.wait_for(lock, timeout, woken);
+    } else {
+        m_cv.wait(lock, woken);
+    }
+    return false;
+}
+
+void MediaStatusService::readEvents(std::unordered_set<UUID>& dirty, bool& overflow) {
+#ifdef __linux__
+    auto markDirectory = [&dirty](const Directory& dir) {
+        for (const auto& [name, ids] : dir.files) {
+            dirty.insert(ids.begin(), ids.end());
+        }
+    };
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (true) {
+        ssize_t length = ::read(m_notifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;     // EAGAIN: queue drained
+
+        for (const char* p = buffer; p < buffer + length; ) {
+            const auto* event = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + event->len;
+            ++m_events;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                overflow = true;    // Events were lost; recheck everything
+                continue;
+            }
+
+            auto wdIt = m_directoryByWd.find(event->wd);
+            if (wdIt == m_directoryByWd.end()) continue;
+            auto dirIt = m_directories.find(wdIt->second);
+            if (dirIt == m_directories.end()) continue;
+            Directory& dir = dirIt->second;
+
+            if (event->mask & (IN_IGNORED | IN_MOVE_SELF)) {
+                // Directory deleted, moved or unmounted: its files are
+                // gone from their paths. Rescans re-add the watch if it
+                // comes back.
+                if (event->mask & IN_MOVE_SELF) {
+                    ::inotify_rm_watch(m_notifyFd, dir.wd);
+                }
+                m_directoryByWd.erase(wdIt);
+                dir.wd = -1;
+                --m_directoryWatchCount;
+                markDirectory(dir);
+                continue;
+            }
+
+            if (event->len == 0) continue;
+
+            auto fileIt = dir.files.find(event->name);
+            if (fileIt != dir.files.end()) {
+                dirty.insert(fileIt->second.begin(), fileIt->second.end());
+            }
+        }
+    }
+#else
+    (void)dirty;
+    (void)overflow;
+#endif
+}
+
+bool MediaStatusService::handleRequests(const std::vector<Request>& requests,
+                                        std::unordered_set<UUID>& dirty) {
+    bool rescan = false;
+    for (const auto& request : requests) {
+        switch (request.kind) {
+            case Request::Kind::Watch:
+                removeWatched(request.id);
+                addWatched(request);
+                dirty.insert(request.id);
+                break;
+            case Request::Kind::Unwatch:
+                removeWatched(request.id);
+                dirty.erase(request.id);
+                break;
+            case Request::Kind::UnwatchAll:
+#ifdef __linux__
+                for (const auto& [wd, path] : m_directoryByWd) {
+                    ::inotify_rm_watch(m_notifyFd, wd);
+                }
+#endif
+                m_watched.clear();
+                m_directories.clear();
+                m_directoryByWd.clear();
+                m_watchedCount = 0;
+                m_directoryWatchCount = 0;
+                dirty.clear();
+                break;
+            case Request::Kind::Rescan:
+                rescan = true;
+                break;
+        }
+    }
+    return rescan;
+}
+
+void MediaStatusService::addWatched(const Request& request) {
+    Watched watched;
+    watched.item = request.item;
+    watched.path = request.path;
+    watched.directory = request.path.parent_path().string();
+    watched.fileName = request.path.filename().string();
+    watched.expectedSize = request.expectedSize;
+
+    Directory& dir = m_directories[watched.directory];
+    if (dir.itemCount++ == 0) {
+        addDirectoryWatch(watched.directory, dir);
+    }
+    dir.files[watched.fileName].push_back(request.id);
+
+    m_watched.emplace(request.id, std::move(watched));
+    m_watchedCount = m_watched.size();
+}
+
+void MediaStatusService::removeWatched(const UUID& id) {
+    auto it = m_watched.find(id);
+    if (it == m_watched.end()) return;
+
+    auto dirIt = m_directories.find(it->second.directory);
+    if (dirIt != m_directories.end()) {
+        Directory& dir = dirIt->second;
+
+        auto fileIt = dir.files.find(it->second.fileName);
+        if (fileIt != dir.files.end()) {
+            auto& ids = fileIt->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            if (ids.empty()) dir.files.erase(fileIt);
+        }
+
+        if (--dir.itemCount == 0) {
+#ifdef __linux__
+            if (dir.wd >= 0) {
+                ::inotify_rm_watch(m_notifyFd, dir.wd);
+                m_directoryByWd.erase(dir.wd);
+                --m_directoryWatchCount;
+            }
+#endif
+            m_directories.erase(dirIt);
+        }
+    }
+
+    m_watched.erase(it);
+    m_watchedCount = m_watched.size();
+}
+
+void MediaStatusService::addDirectoryWatch(const std::string& path, Directory& dir) {
+#ifdef __linux__
+    if (m_notifyFd < 0 || dir.wd >= 0) return;
+
+    // Fails for missing directories or when the watch limit is
+    // reached; rescans cover those
+    int wd = ::inotify_add_watch(m_notifyFd, path.c_str(), kWatchMask);
+    if (wd < 0) return;
+
+    // Another spelling of an already watched directory (a symlink)
+    // shares its watch; leave it to rescans rather than steal it
+    if (auto [it, inserted] = m_directoryByWd.try_emplace(wd, path); !inserted) {
+        return;
+    }
+    dir.wd = wd;
+    ++m_directoryWatchCount;
+#else
+    (void)path;
+    (void)dir;
+#endif
+}
+
+void MediaStatusService::check(const UUID& id, std::vector<StatusUpdate>& updates) {
+    auto it = m_watched.find(id);
+    if (it == m_watched.end()) return;
+    Watched& watched = it->second;
+
+    ++m_checks;
+    FileState state = statFile(watched.path);
+
+    MediaStatus status = MediaStatus::Offline;
+    bool changed = false;
+    if (state.exists) {
+        if (watched.baseline.exists) {
+            changed = !state.sameContent(watched.baseline);
+        } else {
+            // First sighting: compare with what the probe recorded
+            changed = watched.expectedSize != 0 && state.size != watched.expectedSize;
+        }
+        watched.baseline = state;
+
+        // Modified sticks until the item is re-probed and watched again
+        status = (changed || watched.status == MediaStatus::Modified)
+            ? MediaStatus::Modified
+            : MediaStatus::Online;
+    }
+
+    if (status == watched.status && !changed) return;
+
+    watched.status = status;
+    updates.push_back({watched.item, watched.path, status});
+}
+
+MediaStatusService::FileState MediaStatusService::statFile(const std::filesystem::path& path) {
+    FileState state;
+
+#ifdef __linux__
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) return state;
+    state.exists = true;
+    state.size = static_cast<uint64_t>(st.st_size);
+    state.modified = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#else
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) return state;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return state;
+    auto modified = std::filesystem::last_write_time(path, ec);
+    if (ec) return state;
+    state.exists = true;
+    state.size = size;
+    state.modified = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        modified.time_since_epoch()).count();
+#endif
+
+    return state;
+}
+
+// ============================================================================
+// Owner thread
+// ============================================================================
+
+void MediaStatusService::applyUpdates(const std::vector<StatusUpdate>& updates) {
+    for (const auto& update : updates) {
+        auto item = update.item.lock();
+
+        // Skip items removed or relinked since the check
+        if (!item || item->path().lexically_normal() != update.path) continue;
+        if (item->status() == update.status) continue;
+
+        item->setStatus(update.status);
+        statusChanged.fire(item, update.status);
+    }
+}
+
+} // namespace phoenix::model
@@ -0,0 +1,602 @@
+/**
+ * @file project_binary.cpp
+ * @brief Chunked binary project format
+ *
+ * Layout (all integers little-endian):
+ *
+ *   "PHXB" u32 version
+ *   PROJ chunk   project settings, active sequence index
+ *   MEDI chunk   media items
+ *   MHSH chunk   media content hashes (items that have one)
+ *   SEQN chunk   one per sequence (header, then tracks and clips)
+ *
+ * Each chunk is tag + u64 payload length + payload, so readers skip
+ * unknown chunks. IDs are stored verbatim and preserved on load.
+ */
+
+#include <phoenix/model/io/project_io.hpp>
+#include <phoenix/model/io/binary_codec.hpp>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace phoenix::model {
+
+namespace {
+
+constexpr uint32_t kMagic = makeChunkTag('P', 'H', 'X', 'B');
+constexpr uint32_t kProjectChunk = makeChunkTag('P', 'R', 'O', 'J');
+constexpr uint32_t kMediaChunk = makeChunkTag('M', 'E', 'D', 'I');
+constexpr uint32_t kMediaHashChunk = makeChunkTag('M', 'H', 'S', 'H');
+constexpr uint32_t kSequenceChunk = makeChunkTag('S', 'E', 'Q', 'N');
+
+/// Smallest encoded clip and media item (empty strings); bounds the
+/// reservations made for counts read from the file
+constexpr size_t kMinClipSize = 2 * 16 + 4 + 4 + 4 * 8 + 4 + 1 + 4 + 4 + 1 + 1;
+constexpr size_t kMinMediaItemSize = 16 + 4 + 4 + 8 + 4 + 8 + 1 + 1 + 5 * 4 + 4 + 8 + 3 * 4 + 4 + 8 + 1;
+
+/// Read granularity when the stream length is unknown
+constexpr size_t kChunkReadStep = 1 << 20;
+
+/**
+ * @brief Bytes left in @p in, or -1 if the stream cannot tell
+ */
+std::streamoff remainingBytes(std::istream& in) {
+    auto pos = in.tellg();
+    if (pos < 0) return -1;
+
+    in.seekg(0, std::ios::end);
+    auto end = in.tellg();
+    in.seekg(pos);
+    if (end < 0 || !in) {
+        in.clear();
+        in.seekg(pos);
+        return -1;
+    }
+    return end - pos;
+}
+
+/**
+ * @brief Read a chunk payload whose size came from the file
+ *
+ * The size is checked against what the stream holds before anything
+ * is allocated; a stream that cannot tell is read in steps, so a
+ * corrupt size fails on truncation instead of allocating it up front.
+ */
+bool readPayload(std::istream& in, uint64_t size, std::string& payload) {
+    auto remaining = remainingBytes(in);
+    if (remaining >= 0) {
+        if (size > static_cast<uint64_t>(remaining)) return false;
+        payload.resize(static_cast<size_t>(size));
+        return static_cast<bool>(in.read(payload.data(), static_cast<std::streamsize>(size)));
+    }
+
+    payload.clear();
+    while (payload.size() < size) {
+        size_t offset = payload.size();
+        size_t step = static_cast<size_t>(std::min<uint64_t>(size - offset, kChunkReadStep));
+        payload.resize(offset + step);
+        if (!in.read(payload.data() + offset, static_cast<std::streamsize>(step))) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+namespace codec {
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+void writeSequenceSettings(BinaryWriter& w, const SequenceSettings& s) {
+    w.writeI32(s.resolution.width);
+    w.writeI32(s.resolution.height);
+    w.writeI32(s.frameRate.num);
+    w.writeI32(s.frameRate.den);
+    w.writeI32(s.sampleRate);
+    w.writeI32(s.audioChannels);
+}
+
+void writeMediaItem(BinaryWriter& w, const MediaItem& item) {
+    w.writeUUID(item.id());
+    w.writeString(item.name());
+    w.writeString(item.path().string());
+    w.writeU64(item.fileSize());
+    w.writeI32(static_cast<int32_t>(item.type()));
+    w.writeI64(item.duration());
+    w.writeBool(item.hasVideo());
+    w.writeBool(item.hasAudio());
+
+    const auto& v = item.videoProperties();
+    w.writeI32(v.resolution.width);
+    w.writeI32(v.resolution.height);
+    w.writeI32(v.frameRate.num);
+    w.writeI32(v.frameRate.den);
+    w.writeI32(static_cast<int32_t>(v.pixelFormat));
+    w.writeString(v.codec);
+    w.writeI64(v.bitrate);
+
+    const auto& a = item.audioProperties();
+    w.writeI32(a.sampleRate);
+    w.writeI32(a.channels);
+    w.writeI32(static_cast<int32_t>(a.sampleFormat));
+    w.writeString(a.codec);
+    w.writeI64(a.bitrate);
+
+    w.writeBool(item.isProbed());
+}
+
+void writeClip(BinaryWriter& w, const Clip& clip) {
+    w.writeUUID(clip.id());
+    w.writeUUID(clip.mediaItemId());
+    w.writeString(clip.name());
+    w.writeI32(static_cast<int32_t>(clip.type()));
+    w.writeI64(clip.timelineIn());
+    w.writeI64(clip.timelineOut());
+    w.writeI64(clip.sourceIn());
+    w.writeI64(clip.sourceOut());
+    w.writeF32(clip.speed());
+    w.writeBool(clip.reversed());
+    w.writeF32(clip.opacity());
+    w.writeF32(clip.volume());
+    w.writeBool(clip.muted());
+    w.writeBool(clip.disabled());
+}
+
+void writeTrack(BinaryWriter& w, const Track& track) {
+    w.writeUUID(track.id());
+    w.writeString(track.name());
+    w.writeBool(track.muted());
+    w.writeBool(track.locked());
+    w.writeBool(track.hidden());
+    w.writeBool(track.solo());
+
+    w.writeU32(static_cast<uint32_t>(track.clipCount()));
+    for (const auto& clip : track.clips()) {
+        writeClip(w, *clip);
+    }
+}
+
+void writeTrack(BinaryWriter& w, const TrackSnapshot& track) {
+    w.writeUUID(track.id());
+    w.writeString(track.name());
+    w.writeBool(track.muted());
+    w.writeBool(track.locked());
+    w.writeBool(track.hidden());
+    w.writeBool(track.solo());
+
+    w.writeU32(static_cast<uint32_t>(track.clips().size()));
+    for (const auto& clip : track.clips()) {
+        writeClip(w, *clip);
+    }
+}
+
+void writeSequence(BinaryWriter& w, const Sequence& seq) {
+    w.writeUUID(seq.id());
+    w.writeString(seq.name());
+    writeSequenceSettings(w, seq.settings());
+    w.writeI64(seq.playheadPosition());
+    w.writeI64(seq.inPoint());
+    w.writeI64(seq.outPoint());
+
+    w.writeU32(static_cast<uint32_t>(seq.videoTrackCount()));
+    for (const auto& track : seq.videoTracks()) {
+        writeTrack(w, *track);
+    }
+    w.writeU32(static_cast<uint32_t>(seq.audioTrackCount()));
+    for (const auto& track : seq.audioTracks()) {
+        writeTrack(w, *track);
+    }
+}
+
+void writeSequenceTracks(BinaryWriter& w, const SequenceSnapshot& snapshot) {
+    w.writeU32(static_cast<uint32_t>(snapshot.videoTracks().size()));
+    for (const auto& track : snapshot.videoTracks()) {
+        writeTrack(w, *track);
+    }
+    w.writeU32(static_cast<uint32_t>(snapshot.audioTracks().size()));
+    for (const auto& track : snapshot.audioTracks()) {
+        writeTrack(w, *track);
+    }
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+SequenceSettings readSequenceSettings(BinaryReader& r) {
+    SequenceSettings s;
+    s.resolution.width = r.readI32();
+    s.resolution.height = r.readI32();
+    s.frameRate.num = r.readI32();
+    s.frameRate.den = r.readI32();
+    s.sampleRate = r.readI32();
+    s.audioChannels = r.readI32();
+    return s;
+}
+
+std::shared_ptr<MediaItem> readMediaItem(BinaryReader& r) {
+    UUID id = r.readUUID();
+    std::string name = r.readString();
+    auto item = std::make_shared<MediaItem>(id, r.readString());
+    item->setName(name);
+    item->setFileSize(r.readU64());
+    item->setType(static_cast<MediaItemType>(r.readI32()));
+    item->setDuration(r.readI64());
+    item->setHasVideo(r.readBool());
+    item->setHasAudio(r.readBool());
+
+    auto& v = item->videoProperties();
+    v.resolution.width = r.readI32();
+    v.resolution.height = r.readI32();
+    v.frameRate.num = r.readI32();
+    v.frameRate.den = r.readI32();
+    v.pixelFormat = static_cast<PixelFormat>(r.readI32());
+    v.codec = r.readString();
+    v.bitrate = r.readI64();
+
+    auto& a = item->audioProperties();
+    a.sampleRate = r.readI32();
+    a.channels = r.readI32();
+    a.sampleFormat = static_cast<SampleFormat>(r.readI32());
+    a.codec = r.readString();
+    a.bitrate = r.readI64();
+
+    item->setProbed(r.readBool());
+    return item;
+}
+
+std::shared_ptr<Clip> readClip(BinaryReader& r) {
+    UUID clipId = r.readUUID();
+    UUID mediaId = r.readUUID();
+    auto clip = std::make_shared<Clip>(clipId, mediaId);
+    clip->setName(r.readString());
+    clip->setType(static_cast<ClipType>(r.readI32()));
+    clip->setTimelineIn(r.readI64());
+    clip->setTimelineOut(r.readI64());
+    clip->setSourceIn(r.readI64());
+    clip->setSourceOut(r.readI64());
+    clip->setSpeed(r.readF32());
+    clip->setReversed(r.readBool());
+    clip->setOpacity(r.readF32());
+    clip->setVolume(r.readF32());
+    clip->setMuted(r.readBool());
+    clip->setDisabled(r.readBool());
+    return clip;
+}
+
+std::shared_ptr<Track> readTrack(BinaryReader& r, TrackType type) {
+    auto track = std::make_shared<Track>(r.readUUID(), type);
+    track->setName(r.readString());
+    track->setMuted(r.readBool());
+    track->setLocked(r.readBool());
+    track->setHidden(r.readBool());
+    track->setSolo(r.readBool());
+
+    uint32_t clipCount = r.readU32();
+    track->reserveClips(std::min<size_t>(clipCount, r.remaining() / kMinClipSize));
+    for (uint32_t i = 0; i < clipCount; ++i) {
+        auto clip = readClip(r);
+        if (!track->addClip(clip)) {
+            throw std::runtime_error("Overlapping clip " + clip->id().toString() +
+                                     " on track " + track->id().toString());
+        }
+    }
+    return track;
+}
+
+void readSequenceHeader(BinaryReader& r, Sequence& seq) {
+    seq.settings() = readSequenceSettings(r);
+    seq.setPlayheadPosition(r.readI64());
+    seq.setInPoint(r.readI64());
+    seq.setOutPoint(r.readI64());
+}
+
+void readSequenceTracks(BinaryReader& r, Sequence& seq) {
+    uint32_t videoCount = r.readU32();
+    for (uint32_t i = 0; i < videoCount; ++i) {
+        seq.addTrack(readTrack(r, TrackType::Video));
+    }
+    uint32_t audioCount = r.readU32();
+    for (uint32_t i = 0; i < audioCount; ++i) {
+        seq.addTrack(readTrack(r, TrackType::Audio));
+    }
+}
+
+void readSequence(BinaryReader& r, Sequence& seq) {
+    r.readUUID();
+    seq.setName(r.readString());
+    readSequenceHeader(r, seq);
+    readSequenceTracks(r, seq);
+}
+
+} // namespace codec
+
+namespace {
+
+/**
+ * @brief Build a loader that decodes a sequence chunk on demand
+ *
+ * Only the chunk's own bytes are retained.
+ */
+Project::SequenceLoader makeSequenceLoader(std::shared_ptr<const std::string> chunk) {
+    return [chunk = std::move(chunk)](Sequence& seq) {
+        try {
+            BinaryReader r(*chunk);
+            codec::readSequence(r, seq);
+            return true;
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+    };
+}
+
+/**
+ * @brief Write the file header, project chunk and media chunks
+ */
+void writeProjectHeader(BinaryWriter& w,
+                        const ProjectSettings& settings,
+                        int activeSequenceIndex,
+                        const std::vector<std::shared_ptr<const MediaItem>>& media) {
+    w.writeU32(kMagic);
+    w.writeU32(ProjectIO::kBinaryFormatVersion);
+
+    // Project header
+    auto chunk = w.beginChunk(kProjectChunk);
+    w.writeString(settings.name);
+    codec::writeSequenceSettings(w, settings.defaultSequence);
+    w.writeString(settings.exportPreset);
+    w.writeBool(settings.autoSaveEnabled);
+    w.writeI32(settings.autoSaveIntervalMinutes);
+    w.writeString(settings.scratchDisk.string());
+    w.writeI32(activeSequenceIndex);
+    w.endChunk(chunk);
+
+    // Media items
+    chunk = w.beginChunk(kMediaChunk);
+    w.writeU32(static_cast<uint32_t>(media.size()));
+    for (const auto& item : media) {
+        codec::writeMediaItem(w, *item);
+    }
+    w.endChunk(chunk);
+
+    // Separate chunk so older readers skip it
+    auto hashCount = std::count_if(media.begin(), media.end(),
+        [](const auto& item) { return item->contentHash() != 0; });
+    if (hashCount > 0) {
+        chunk = w.beginChunk(kMediaHashChunk);
+        w.writeU32(static_cast<uint32_t>(hashCount));
+        for (const auto& item : media) {
+            if (item->contentHash() == 0) continue;
+            w.writeUUID(item->id());
+            w.writeU64(item->contentHash());
+        }
+        w.endChunk(chunk);
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ProjectIO Binary Implementation
+// ============================================================================
+
+Result<void, Error> ProjectIO::writeBinary(
+    const Project& project,
+    std::ostream& out)
+{
+    try {
+        BinaryWriter w(out);
+        std::vector<std::shared_ptr<const MediaItem>> media;
+        media.reserve(project.mediaBin().size());
+        project.mediaBin().forEach([&media](const MediaBin::ItemPtr& item) {
+            media.push_back(item);
+        });
+        writeProjectHeader(w, project.settings(), project.activeSequenceIndex(), media);
+
+        // Sequences, one chunk each
+        for (const auto& seq : project.sequences()) {
+            auto chunk = w.beginChunk(kSequenceChunk);
+            if (project.isSequenceLoaded(seq->id())) {
+                codec::writeSequence(w, *seq);
+            } else {
+                // Decode a private copy; the project stays untouched
+                Sequence copy(seq->id(), seq->name());
+                if (!project.loadSequenceInto(seq->id(), copy)) {
+                    return Error(ErrorCode::InvalidData,
+                        "Cannot decode deferred sequence: " + seq->name());
+                }
+                codec::writeSequence(w, copy);
+            }
+            w.endChunk(chunk);
+        }
+
+        if (!w.good()) {
+            return Error(ErrorCode::WriteError, "Failed to write binary project");
+        }
+        return Ok();
+    }
+    catch (const std::exception& e) {
+        return Error(ErrorCode::WriteError, e.what());
+    }
+}
+
+std::shared_ptr<const ProjectImage> ProjectIO::capture(const Project& project)
+{
+    auto image = std::make_shared<ProjectImage>();
+    image->settings = project.settings();
+    image->activeSequenceIndex = project.activeSequenceIndex();
+
+    // Copies, so later edits of the live items are not seen
+    image->media.reserve(project.mediaBin().size());
+    project.mediaBin().forEach([&image](const MediaBin::ItemPtr& item) {
+        image->media.push_back(std::make_shared<const MediaItem>(*item));
+    });
+
+    image->sequences.reserve(project.sequences().size());
+    for (const auto& seq : project.sequences()) {
+        ProjectImage::SequenceImage s;
+        s.id = seq->id();
+        s.name = seq->name();
+        s.settings = seq->settings();
+        s.playhead = seq->playheadPosition();
+        s.inPoint = seq->inPoint();
+        s.outPoint = seq->outPoint();
+        if (project.isSequenceLoaded(seq->id())) {
+            s.timeline = seq->snapshot();
+        } else {
+            s.loader = project.sequenceLoader(seq->id());
+        }
+        image->sequences.push_back(std::move(s));
+    }
+    return image;
+}
+
+Result<void, Error> ProjectIO::writeBinary(
+    const ProjectImage& image,
+    std::ostream& out)
+{
+    try {
+        BinaryWriter w(out);
+        writeProjectHeader(w, image.settings, image.activeSequenceIndex, image.media);
+
+        for (const auto& seq : image.sequences) {
+            auto chunk = w.beginChunk(kSequenceChunk);
+            if (seq.loader) {
+                Sequence copy(seq.id, seq.name);
+                if (!seq.loader(copy)) {
+                    return Error(ErrorCode::InvalidData,
+                        "Cannot decode deferred sequence: " + seq.name);
+                }
+                codec::writeSequence(w, copy);
+            } else {
+                // Same layout as codec::writeSequence()
+                w.writeUUID(seq.id);
+                w.writeString(seq.name);
+                codec::writeSequenceSettings(w, seq.settings);
+                w.writeI64(seq.playhead);
+                w.writeI64(seq.inPoint);
+                w.writeI64(seq.outPoint);
+                if (seq.timeline) {
+                    codec::writeSequenceTracks(w, *seq.timeline);
+                } else {
+                    w.writeU32(0);
+                    w.writeU32(0);
+                }
+            }
+            w.endChunk(chunk);
+        }
+
+        if (!w.good()) {
+            return Error(ErrorCode::WriteError, "Failed to write binary project");
+        }
+        return Ok();
+    }
+    catch (const std::exception& e) {
+        return Error(ErrorCode::WriteError, e.what());
+    }
+}
+
+Result<std::unique_ptr<Project>, Error> ProjectIO::readBinary(std::istream& in)
+{
+    try {
+        char header[8];
+        if (!in.read(header, sizeof(header))) {
+            return Error(ErrorCode::InvalidData, "Binary project header truncated");
+        }
+
+        BinaryReader hr(header, sizeof(header));
+        if (hr.readU32() != kMagic) {
+            return Error(ErrorCode::InvalidData, "Not a binary project file");
+        }
+
+        auto version = static_cast<int>(hr.readU32());
+        if (version > kBinaryFormatVersion) {
+            return Error(ErrorCode::NotSupported,
+                "Project file version " + std::to_string(version) +
+                " is newer than supported version " + std::to_string(kBinaryFormatVersion));
+        }
+
+        auto project = std::make_unique<Project>();
+        auto defaultSeqId = project->sequences()[0]->id();
+        int activeIdx = 0;
+        size_t loadedSequences = 0;
+
+        // Stream chunks one at a time
+        char chunkHeader[kChunkHeaderSize];
+        while (in.read(chunkHeader, sizeof(chunkHeader))) {
+            BinaryReader cr(chunkHeader, sizeof(chunkHeader));
+            uint32_t tag = cr.readU32();
+            uint64_t size = cr.readU64();
+
+            auto payload = std::make_shared<std::string>();
+            if (!readPayload(in, size, *payload)) {
+                return Error(ErrorCode::InvalidData, "Binary project chunk truncated");
+            }
+            BinaryReader r(*payload);
+
+            if (tag == kProjectChunk) {
+                auto& settings = project->settings();
+                settings.name = r.readString();
+                settings.defaultSequence = codec::readSequenceSettings(r);
+                settings.exportPreset = r.readString();
+                settings.autoSaveEnabled = r.readBool();
+                settings.autoSaveIntervalMinutes = r.readI32();
+                settings.scratchDisk = r.readString();
+                activeIdx = r.readI32();
+            }
+            else if (tag == kMediaChunk) {
+                uint32_t count = r.readU32();
+                std::vector<MediaBin::ItemPtr> items;
+                items.reserve(std::min<size_t>(count, r.remaining() / kMinMediaItemSize));
+                for (uint32_t i = 0; i < count; ++i) {
+                    items.push_back(codec::readMediaItem(r));
+                }
+                project->mediaBin().addItems(items);
+            }
+            else if (tag == kMediaHashChunk) {
+                uint32_t count = r.readU32();
+                for (uint32_t i = 0; i < count; ++i) {
+                    UUID id = r.readUUID();
+                    project->mediaBin().setContentHash(id, r.readU64());
+                }
+            }
+            else if (tag == kSequenceChunk) {
+                // Stub now, tracks on first activation
+                UUID id = r.readUUID();
+                auto seq = std::make_shared<Sequence>(id, r.readString());
+                codec::readSequenceHeader(r, *seq);
+                project->addSequence(seq);
+                project->setSequenceLoader(id, makeSequenceLoader(std::move(payload)));
+                ++loadedSequences;
+            }
+            // Unknown chunks are skipped
+        }
+
+        if (loadedSequences > 0) {
+            project->removeSequence(defaultSeqId);
+        }
+
+        // Decode the active sequence now; the rest stay deferred
+        if (activeIdx < 0 || activeIdx >= static_cast<int>(project->sequenceCount())) {
+            activeIdx = 0;
+        }
+        if (!project->loadSequence(project->sequences()[activeIdx]->id())) {
+            return Error(ErrorCode::InvalidData, "Cannot decode active sequence");
+        }
+        project->setActiveSequenceIndex(activeIdx);
+
+        project->clearModified();
+        return project;
+    }
+    catch (const std::exception& e) {
+        return Error(ErrorCode::InvalidData,
+            "Binary project parse error: " + std::string(e.what()));
+    }
+}
+
+} // namespace phoenix::model
@@ -5,8 +5,16 @@
 
 #include <phoenix/model/io/project_io.hpp>
 #include <nlohmann/json.hpp>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 using json = nlohmann::json;
 
@@ -94,6 +102,7 @@ json mediaItemToJson(const MediaItem& item) {
         {"name", item.name()},
         {"path", item.path().string()},
         {"fileSize", item.fileSize()},
+        {"contentHash", item.contentHash()},
         {"type", static_cast<int>(item.type())},
         {"duration", item.duration()},
         {"hasVideo", item.hasVideo()},
@@ -111,6 +120,7 @@ std::shared_ptr<MediaItem> mediaItemFromJson(const json& j) {
     item->setName(j.value("name", ""));
     item->setPath(j.value("path", ""));
     item->setFileSize(j.value("fileSize", uint64_t(0)));
+    item->setContentHash(j.value("contentHash", uint64_t(0)));
     item->setType(static_cast<MediaItemType>(j.value("type", 0)));
     item->setDuration(j.value("duration", Duration(0)));
     item->setHasVideo(j.value("hasVideo", false));
@@ -130,7 +140,7 @@ std::shared_ptr<MediaItem> mediaItemFromJson(const json& j) {
 
 // Clip
 json clipToJson(const Clip& clip) {
-    return {
+    json j = {
         {"id", uuidToJson(clip.id())},
         {"mediaItemId", uuidToJson(clip.mediaItemId())},
         {"name", clip.name()},
@@ -146,6 +156,13 @@ json clipToJson(const Clip& clip) {
         {"muted", clip.muted()},
         {"disabled", clip.disabled()}
     };
+    
+    // Remapped after all sequences are loaded
+    if (clip.isNested()) {
+        j["sequenceId"] = uuidToJson(clip.sequenceId());
+    }
+    
+    return j;
 }
 
 std::shared_ptr<Clip> clipFromJson(const json& j, 
@@ -172,6 +189,10 @@ std::shared_ptr<Clip> clipFromJson(const json& j,
     clip->setMuted(j.value("muted", false));
     clip->setDisabled(j.value("disabled", false));
     
+    if (clip->isNested() && j.contains("sequenceId")) {
+        clip->setSequenceId(uuidFromJson(j["sequenceId"]));
+    }
+    
     return clip;
 }
 
@@ -207,6 +228,7 @@ std::shared_ptr<Track> trackFromJson(const json& j,
     track->setSolo(j.value("solo", false));
     
     if (j.contains("clips")) {
+        track->reserveClips(j["clips"].size());
         for (const auto& clipJson : j["clips"]) {
             auto clip = clipFromJson(clipJson, idMap);
             track->addClip(clip);
@@ -278,38 +300,21 @@ std::shared_ptr<Sequence> sequenceFromJson(const json& j,
         seq->removeTrack(seq->audioTracks()[0]->id());
     }
     
-    // Load video tracks
+    // Tracks are complete before they are added, so the snapshot
+    // published by addTrack() includes their clips
     if (j.contains("videoTracks")) {
         for (const auto& trackJson : j["videoTracks"]) {
             auto track = trackFromJson(trackJson, idMap);
             track->setType(TrackType::Video);
-            // Add clips directly since we can't add a pre-made track
-            auto newTrack = seq->addVideoTrack();
-            newTrack->setName(track->name());
-            newTrack->setMuted(track->muted());
-            newTrack->setLocked(track->locked());
-            newTrack->setHidden(track->hidden());
-            newTrack->setSolo(track->solo());
-            for (const auto& clip : track->clips()) {
-                newTrack->addClip(clip);
-            }
+            seq->addTrack(track);
         }
     }
     
-    // Load audio tracks
     if (j.contains("audioTracks")) {
         for (const auto& trackJson : j["audioTracks"]) {
             auto track = trackFromJson(trackJson, idMap);
             track->setType(TrackType::Audio);
-            auto newTrack = seq->addAudioTrack();
-            newTrack->setName(track->name());
-            newTrack->setMuted(track->muted());
-            newTrack->setLocked(track->locked());
-            newTrack->setHidden(track->hidden());
-            newTrack->setSolo(track->solo());
-            for (const auto& clip : track->clips()) {
-                newTrack->addClip(clip);
-            }
+            seq->addTrack(track);
         }
     }
     
@@ -345,6 +350,20 @@ ProjectSettings projectSettingsFromJson(const json& j) {
     return s;
 }
 
+/// Force a written file to stable storage
+bool syncFile(const std::filesystem::path& path) {
+    std::FILE* file = std::fopen(path.string().c_str(), "rb+");
+    if (!file) return false;
+    
+#ifdef _WIN32
+    bool ok = _commit(_fileno(file)) == 0;
+#else
+    bool ok = ::fsync(fileno(file)) == 0;
+#endif
+    std::fclose(file);
+    return ok;
+}
+
 } // anonymous namespace
 
 // ============================================================================
@@ -353,29 +372,61 @@ ProjectSettings projectSettingsFromJson(const json& j) {
 
 Result<void, Error> ProjectIO::save(
     const Project& project,
-    const std::filesystem::path& path)
+    const std::filesystem::path& path,
+    ProjectFormat format)
 {
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    
+    // A failed save must not leave a partial temporary file behind
+    auto fail = [&tmpPath](Error error) -> Result<void, Error> {
+        std::error_code ec;
+        std::filesystem::remove(tmpPath, ec);
+        return error;
+    };
+    
     try {
-        std::string jsonStr = toJson(project);
-        
-        std::ofstream file(path);
-        if (!file.is_open()) {
-            return Error(ErrorCode::FileOpenFailed, 
-                "Cannot open file for writing: " + path.string());
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return fail(Error(ErrorCode::FileOpenFailed, 
+                    "Cannot open file for writing: " + tmpPath.string()));
+            }
+            
+            if (format == ProjectFormat::Binary) {
+                auto result = writeBinary(project, file);
+                if (!result.ok()) {
+                    return fail(result.error());
+                }
+            } else {
+                file << toJson(project);
+            }
+            
+            file.close();
+            if (file.fail()) {
+                return fail(Error(ErrorCode::WriteError, 
+                    "Failed to write project file: " + tmpPath.string()));
+            }
         }
         
-        file << jsonStr;
-        file.close();
+        // The data must be on disk before the rename can replace the
+        // previous project, or a crash may leave an empty file
+        if (!syncFile(tmpPath)) {
+            return fail(Error(ErrorCode::WriteError, 
+                "Failed to sync project file: " + tmpPath.string()));
+        }
         
-        if (file.fail()) {
-            return Error(ErrorCode::WriteError, 
-                "Failed to write project file: " + path.string());
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec) {
+            return fail(Error(ErrorCode::WriteError, 
+                "Failed to replace project file: " + path.string() + ": " + ec.message()));
         }
         
         return Ok();
     }
     catch (const std::exception& e) {
-        return Error(ErrorCode::WriteError, e.what());
+        return fail(Error(ErrorCode::WriteError, e.what()));
     }
 }
 
@@ -383,16 +434,26 @@ Result<std::unique_ptr<Project>, Error> ProjectIO::load(
     const std::filesystem::path& path)
 {
     try {
-        std::ifstream file(path);
+        auto format = detectFormat(path);
+        if (!format.ok()) {
+            return format.error();
+        }
+        
+        std::ifstream file(path, std::ios::binary);
         if (!file.is_open()) {
             return Error(ErrorCode::FileNotFound, 
                 "Cannot open project file: " + path.string());
         }
         
-        std::stringstream buffer;
-        buffer << file.rdbuf();
+        Result<std::unique_ptr<Project>, Error> result = Error(ErrorCode::Unknown);
+        if (format.value() == ProjectFormat::Binary) {
+            result = readBinary(file);
+        } else {
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            result = fromJson(buffer.str());
+        }
         
-        auto result = fromJson(buffer.str());
         if (result.ok()) {
             result.value()->setFilePath(path);
         }
@@ -403,18 +464,41 @@ Result<std::unique_ptr<Project>, Error> ProjectIO::load(
     }
 }
 
+Result<ProjectFormat, Error> ProjectIO::detectFormat(
+    const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return Error(ErrorCode::FileNotFound, 
+            "Cannot open project file: " + path.string());
+    }
+    
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+    if (file.gcount() == sizeof(magic) && std::string_view(magic, 4) == "PHXB") {
+        return ProjectFormat::Binary;
+    }
+    return ProjectFormat::Json;
+}
+
 std::string ProjectIO::toJson(const Project& project) {
     // Build media item list with ID mapping
     json mediaItemsJson = json::array();
-    for (const auto& item : project.mediaBin().items()) {
-        auto itemJson = mediaItemToJson(*item);
-        mediaItemsJson.push_back(itemJson);
-    }
+    project.mediaBin().forEach([&](const MediaBin::ItemPtr& item) {
+        mediaItemsJson.push_back(mediaItemToJson(*item));
+    });
     
     // Build sequences
     json sequencesJson = json::array();
     for (const auto& seq : project.sequences()) {
-        sequencesJson.push_back(sequenceToJson(*seq));
+        if (project.isSequenceLoaded(seq->id())) {
+            sequencesJson.push_back(sequenceToJson(*seq));
+        } else {
+            // Decode a private copy; the project stays untouched
+            Sequence copy(seq->id(), seq->name());
+            project.loadSequenceInto(seq->id(), copy);
+            sequencesJson.push_back(sequenceToJson(copy));
+        }
     }
     
     json root = {
@@ -453,63 +537,51 @@ Result<std::unique_ptr<Project>, Error> ProjectIO::fromJson(
         // Load media items and build ID mapping
         std::unordered_map<std::string, UUID> idMap;
         if (root.contains("mediaItems")) {
+            std::vector<MediaBin::ItemPtr> items;
+            items.reserve(root["mediaItems"].size());
             for (const auto& itemJson : root["mediaItems"]) {
                 std::string oldId = itemJson.value("id", "");
                 auto item = mediaItemFromJson(itemJson);
                 idMap[oldId] = item->id();
-                project->mediaBin().addItem(item);
+                items.push_back(std::move(item));
             }
+            project->mediaBin().addItems(items);
         }
         
-        // Clear default sequence
-        while (project->sequenceCount() > 0) {
-            project->removeSequence(project->sequences()[0]->id());
-        }
+        // The default sequence is removed once the loaded ones exist
+        // (a project always keeps at least one sequence)
+        auto defaultSeqId = project->sequences()[0]->id();
         
-        // Load sequences
+        // Load sequences (they get new IDs, like media items)
+        std::unordered_map<std::string, UUID> seqIdMap;
         if (root.contains("sequences")) {
             for (const auto& seqJson : root["sequences"]) {
                 auto seq = sequenceFromJson(seqJson, idMap);
-                // We need to add it manually since sequences is private
-                // For now, create new and copy settings
-                auto newSeq = project->createSequence(seq->name());
-                newSeq->settings() = seq->settings();
-                
-                // Copy tracks
-                // Clear default tracks first
-                while (newSeq->videoTrackCount() > 0) {
-                    newSeq->removeTrack(newSeq->videoTracks()[0]->id());
-                }
-                while (newSeq->audioTrackCount() > 0) {
-                    newSeq->removeTrack(newSeq->audioTracks()[0]->id());
-                }
-                
-                // Add video tracks
-                for (const auto& srcTrack : seq->videoTracks()) {
-                    auto track = newSeq->addVideoTrack();
-                    track->setName(srcTrack->name());
-                    track->setMuted(srcTrack->muted());
-                    track->setLocked(srcTrack->locked());
-                    track->setHidden(srcTrack->hidden());
-                    for (const auto& clip : srcTrack->clips()) {
-                        track->addClip(clip);
-                    }
-                }
-                
-                // Add audio tracks
-                for (const auto& srcTrack : seq->audioTracks()) {
-                    auto track = newSeq->addAudioTrack();
-                    track->setName(srcTrack->name());
-                    track->setMuted(srcTrack->muted());
-                    for (const auto& clip : srcTrack->clips()) {
-                        track->addClip(clip);
+                seqIdMap[seqJson.value("id", "")] = seq->id();
+                project->addSequence(seq);
+            }
+        }
+        
+        // Point nested clips at the new sequence IDs
+        for (const auto& seq : project->sequences()) {
+            auto change = SequenceChange::wholeTimeline();
+            for (const auto* tracks : {&seq->videoTracks(), &seq->audioTracks()}) {
+                for (const auto& track : *tracks) {
+                    for (const auto& clip : track->clips()) {
+                        if (!clip->isNested()) continue;
+                        auto it = seqIdMap.find(clip->sequenceId().toString());
+                        clip->setSequenceId(it != seqIdMap.end() ? it->second : UUID());
+                        change.clipIds.push_back(clip->id());
                     }
                 }
-                
-                newSeq->setPlayheadPosition(seq->playheadPosition());
-                newSeq->setInPoint(seq->inPoint());
-                newSeq->setOutPoint(seq->outPoint());
             }
+            if (!change.clipIds.empty()) {
+                seq->commitChange(std::move(change));
+            }
+        }
+        
+        if (project->sequenceCount() > 1) {
+            project->removeSequence(defaultSeqId);
         }
         
         // Set active sequence
@@ -219,6 +219,9 @@ constexpr int kMaxConsecutiveDecoderErrors = 10;
 /// Maximum decode loop iterations (safety limit)
 constexpr int kMaxDecodeLoopIterations = 100;
 
+/// Minimum interval between repeats of a per-frame error message
+constexpr int64_t kErrorLogIntervalMs = 1000;
+
 // ============================================================================
 // Buffering State (for Pre-roll State Machine)
 // ============================================================================
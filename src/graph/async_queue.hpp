@@ -20,7 +20,7 @@
 #include "node.hpp"
 #include "core/types.hpp"
 
-#include <spdlog/spdlog.h>
+#include <phoenix/core/logger.hpp>
 
 namespace phoenix {
 
@@ -92,7 +92,7 @@ public:
             workerLoop();
         });
         
-        spdlog::debug("[{}] Started", name_);
+        LOG_DEBUG("[{}] Started", name_);
     }
     
     /**
@@ -113,7 +113,7 @@ public:
             worker_.join();
         }
         
-        spdlog::debug("[{}] Stopped", name_);
+        LOG_DEBUG("[{}] Stopped", name_);
     }
     
     /**
@@ -123,7 +123,7 @@ public:
      */
     void flush() override {
         input.flush();
-        spdlog::debug("[{}] Flushed", name_);
+        LOG_DEBUG("[{}] Flushed", name_);
     }
     
     /**
@@ -151,14 +151,14 @@ private:
      * Handles EOF by propagating it downstream.
      */
     void workerLoop() {
-        spdlog::debug("[{}] Worker started", name_);
+        LOG_DEBUG("[{}] Worker started", name_);
         
         while (running_.load(std::memory_order_acquire)) {
             // Pop from input (blocking)
             auto [result, data] = input.pop(std::chrono::milliseconds(100));
             
             if (result == PopResult::Terminated) {
-                spdlog::debug("[{}] Received termination signal", name_);
+                LOG_DEBUG("[{}] Received termination signal", name_);
                 break;
             }
             
@@ -182,7 +182,7 @@ private:
                 auto pushResult = output.emit(std::move(*data));
                 if (!pushResult.ok()) {
                     if (running_.load(std::memory_order_acquire)) {
-                        spdlog::warn("[{}] Failed to emit: {}", name_, 
+                        LOG_WARN_EVERY(kErrorLogIntervalMs, "[{}] Failed to emit: {}", name_, 
                             pushResult.error().what());
                     }
                     break;
@@ -193,11 +193,11 @@ private:
             
             // If EOF, we can stop (but don't break - let Pipeline handle shutdown)
             if (isEof) {
-                spdlog::debug("[{}] Propagated EOF", name_);
+                LOG_DEBUG("[{}] Propagated EOF", name_);
             }
         }
         
-        spdlog::debug("[{}] Worker exited, processed {} items", 
+        LOG_DEBUG("[{}] Worker exited, processed {} items", 
             name_, itemsProcessed_.load());
     }
     
@@ -23,7 +23,7 @@
 #include "core/types.hpp"
 #include "core/clock.hpp"
 
-#include <spdlog/spdlog.h>
+#include <phoenix/core/logger.hpp>
 
 namespace phoenix {
 
@@ -119,7 +119,7 @@ public:
     template<Transferable T>
     void connect(SourceNode<T>* source, AsyncQueueNode<T>* queue) {
         source->output.connect(&queue->input);
-        spdlog::debug("Connected {} -> {}", source->name(), queue->name());
+        LOG_DEBUG("Connected {} -> {}", source->name(), queue->name());
     }
     
     /**
@@ -128,7 +128,7 @@ public:
     template<Transferable T, Transferable TOut>
     void connect(AsyncQueueNode<T>* queue, ProcessorNode<T, TOut>* processor) {
         queue->output.connect(&processor->input);
-        spdlog::debug("Connected {} -> {}", queue->name(), processor->name());
+        LOG_DEBUG("Connected {} -> {}", queue->name(), processor->name());
     }
     
     /**
@@ -137,7 +137,7 @@ public:
     template<Transferable TIn, Transferable T>
     void connect(ProcessorNode<TIn, T>* processor, AsyncQueueNode<T>* queue) {
         processor->output.connect(&queue->input);
-        spdlog::debug("Connected {} -> {}", processor->name(), queue->name());
+        LOG_DEBUG("Connected {} -> {}", processor->name(), queue->name());
     }
     
     /**
@@ -146,7 +146,7 @@ public:
     template<Transferable T>
     void connect(AsyncQueueNode<T>* queue, SinkNode<T>* sink) {
         queue->output.connect(&sink->input);
-        spdlog::debug("Connected {} -> {}", queue->name(), sink->name());
+        LOG_DEBUG("Connected {} -> {}", queue->name(), sink->name());
     }
     
     /**
@@ -155,7 +155,7 @@ public:
     template<Transferable T, Transferable TOut>
     void connect(SourceNode<T>* source, ProcessorNode<T, TOut>* processor) {
         source->output.connect(&processor->input);
-        spdlog::debug("Connected {} -> {} (direct)", source->name(), processor->name());
+        LOG_DEBUG("Connected {} -> {} (direct)", source->name(), processor->name());
     }
     
     /**
@@ -164,7 +164,7 @@ public:
     template<Transferable TIn, Transferable T>
     void connect(ProcessorNode<TIn, T>* processor, SinkNode<T>* sink) {
         processor->output.connect(&sink->input);
-        spdlog::debug("Connected {} -> {} (direct)", processor->name(), sink->name());
+        LOG_DEBUG("Connected {} -> {} (direct)", processor->name(), sink->name());
     }
     
     // ========== Lifecycle ==========
@@ -177,7 +177,7 @@ public:
      */
     void start() {
         if (state_ != PipelineState::Stopped) {
-            spdlog::warn("Pipeline::start() called in state {}", 
+            LOG_WARN("Pipeline::start() called in state {}", 
                 pipelineStateToString(state_));
             return;
         }
@@ -190,7 +190,7 @@ public:
             (*it)->start();
         }
         
-        spdlog::info("Pipeline started, waiting for pre-roll...");
+        LOG_INFO("Pipeline started, waiting for pre-roll...");
     }
     
     /**
@@ -204,7 +204,7 @@ public:
             return;
         }
         
-        spdlog::info("Pipeline stopping...");
+        LOG_INFO("Pipeline stopping...");
         
         // 1. Stop all InputPins first (wake blocked threads)
         // Note: Queue's input.stop() is called in queue->stop()
@@ -215,7 +215,7 @@ public:
         }
         
         setState(PipelineState::Stopped);
-        spdlog::info("Pipeline stopped");
+        LOG_INFO("Pipeline stopped");
     }
     
     /**
@@ -228,7 +228,7 @@ public:
         
         clock_.pause();
         setState(PipelineState::Paused);
-        spdlog::info("Pipeline paused");
+        LOG_INFO("Pipeline paused");
     }
     
     /**
@@ -241,7 +241,7 @@ public:
         
         clock_.resume();
         setState(PipelineState::Playing);
-        spdlog::info("Pipeline resumed");
+        LOG_INFO("Pipeline resumed");
     }
     
     /**
@@ -290,7 +290,7 @@ public:
         // Return to previous state (or Playing)
         setState(prevState == PipelineState::Paused ? PipelineState::Paused : PipelineState::Playing);
         
-        spdlog::info("Seeked to {} us", positionUs);
+        LOG_INFO("Seeked to {} us", positionUs);
     }
     
     // ========== Pre-roll ==========
@@ -332,7 +332,7 @@ public:
             startPlayback();
         } else if (videoOk && (timeout || !hasAudioStream_)) {
             // Video ready but audio timed out or no audio stream
-            spdlog::warn("Audio pre-roll timeout, using wall clock");
+            LOG_WARN("Audio pre-roll timeout, using wall clock");
             clock_.useWallClock();
             clock_.setAudioSource(false);
             startPlayback();
@@ -344,7 +344,7 @@ public:
      * @brief Handle EOF from source
      */
     void notifyEof() {
-        spdlog::info("Pipeline received EOF");
+        LOG_INFO("Pipeline received EOF");
         
         if (config_.loop) {
             seek(0);  // Loop back to start
@@ -418,7 +418,7 @@ private:
     void startPlayback() {
         clock_.start();
         setState(PipelineState::Playing);
-        spdlog::info("Pipeline playing");
+        LOG_INFO("Pipeline playing");
     }
     
     // Configuration
@@ -55,7 +55,7 @@ extern "C" {
 #include <SDL2/SDL.h>
 
 // Logging
-#include <spdlog/spdlog.h>
+#include <phoenix/core/logger.hpp>
 
 namespace phoenix {
 
@@ -1086,17 +1086,20 @@ int run(int argc, char* argv[]) {
 } // namespace phoenix
 
 int main(int argc, char* argv[]) {
+    // Console output goes through the async sink, off the render and
+    // decode threads
+    phoenix::initLogging("phoenix", spdlog::level::debug);
+    spdlog::set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
+    
+    int exitCode = 1;
     try {
-        // Configure logging
-        spdlog::set_level(spdlog::level::debug);
-        spdlog::set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
-        
-        return phoenix::run(argc, argv);
+        exitCode = phoenix::run(argc, argv);
     } catch (const std::exception& e) {
         spdlog::critical("Unhandled exception: {}", e.what());
-        return 1;
     } catch (...) {
         spdlog::critical("Unknown exception");
-        return 1;
     }
+    
+    phoenix::shutdownLogging();
+    return exitCode;
 }
@@ -4,7 +4,7 @@
  * 
  * Key features:
  * - SwrContext for format conversion (any format -> S16 stereo)
- * - Lock-free ring buffer for SDL callback
+ * - Lock-free ring buffer for SDL callback (resampled into in place)
  * - Audio callback drives MasterClock
  * - Pause outputs silence without updating clock
  * - Serial filtering for seek support
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <functional>
 #include <cstring>
+#include <algorithm>
 
 #include "graph/node.hpp"
 #include "core/types.hpp"
@@ -43,11 +44,11 @@ namespace phoenix {
 constexpr int kOutputSampleRate = 48000;
 constexpr int kOutputChannels = 2;
 constexpr int kOutputBytesPerSample = 2;  // 16-bit
+constexpr int kOutputFrameBytes = kOutputChannels * kOutputBytesPerSample;
 constexpr SDL_AudioFormat kOutputFormat = AUDIO_S16SYS;
 
-/// Ring buffer size: ~500ms of audio
-constexpr size_t kAudioRingBufferSize = 
-    kOutputSampleRate * kOutputChannels * kOutputBytesPerSample / 2;  // 96000 bytes
+/// Ring buffer size: ~500ms of audio (rounded up to 32768 frames, 128KB)
+constexpr size_t kAudioRingBufferFrames = kOutputSampleRate / 2;
 
 /// SDL audio buffer size (samples per callback)
 constexpr int kSDLAudioBufferSamples = 2048;
@@ -71,7 +72,7 @@ public:
                           size_t inputCapacity = kDefaultAudioQueueCapacity)
         : NodeBase(std::move(name))
         , input(inputCapacity)
-        , ringBuffer_(kAudioRingBufferSize)
+        , ringBuffer_(kAudioRingBufferFrames, kOutputChannels)
     {}
     
     ~AudioSinkNode() override {
@@ -189,6 +190,7 @@ public:
         eofReceived_ = false;
         input.reset();
         ringBuffer_.clear();
+        ringBuffer_.resetStats();
         
         // Start worker thread
         worker_ = std::thread([this] { workerLoop(); });
@@ -217,8 +219,10 @@ public:
             worker_.join();
         }
         
-        spdlog::info("[{}] Stopped. Samples written: {}", 
-            name_, samplesWritten_.load());
+        auto buffer = ringBuffer_.stats();
+        spdlog::info("[{}] Stopped. Samples written: {}, underruns: {}, buffer low/high: {}/{} frames", 
+            name_, samplesWritten_.load(), buffer.underruns,
+            buffer.lowWatermark, buffer.highWatermark);
     }
     
     void flush() override {
@@ -248,10 +252,14 @@ public:
             return;
         }
         
-        // Read from ring buffer
-        size_t read = ringBuffer_.read(stream, static_cast<size_t>(len));
+        // Copy straight out of the ring buffer
+        auto data = ringBuffer_.beginRead(static_cast<size_t>(len) / kOutputFrameBytes);
+        std::memcpy(stream, data.first.data(), data.first.size_bytes());
+        std::memcpy(stream + data.first.size_bytes(), data.second.data(), data.second.size_bytes());
+        ringBuffer_.commitRead(data.frames);
         
         // Fill remainder with silence if buffer underrun
+        size_t read = data.frames * kOutputFrameBytes;
         if (read < static_cast<size_t>(len)) {
             std::memset(stream + read, 0, len - read);
         }
@@ -264,7 +272,7 @@ public:
                 // Calculate elapsed time based on bytes played
                 // bytes = samples * channels * bytesPerSample
                 // time = samples / sampleRate
-                size_t samples = read / (kOutputChannels * kOutputBytesPerSample);
+                size_t samples = data.frames;
                 int64_t elapsedUs = static_cast<int64_t>(samples) * 1000000 / kOutputSampleRate;
                 
                 // Update clock with current audio position plus elapsed time
@@ -283,6 +291,13 @@ public:
         return ringBuffer_.fillRatio();
     }
     
+    /**
+     * @brief Ring buffer watermarks and underruns since start()
+     */
+    [[nodiscard]] RingBufferStats bufferStats() const {
+        return ringBuffer_.stats();
+    }
+    
 private:
     /**
      * @brief Create SwrContext for resampling
@@ -386,10 +401,6 @@ private:
     void workerLoop() {
         spdlog::debug("[{}] Worker started", name_);
         
-        // Temporary buffer for resampled audio
-        std::vector<uint8_t> resampleBuffer;
-        resampleBuffer.reserve(32768);  // 32KB initial
-        
         while (running_.load(std::memory_order_acquire)) {
             // If paused, just wait without processing frames
             // This prevents ring buffer overflow when SDL callback is paused
@@ -414,7 +425,7 @@ private:
             }
             
             // Process the frame
-            processFrame(std::move(*frame), resampleBuffer);
+            processFrame(std::move(*frame));
         }
         
         spdlog::debug("[{}] Worker exited", name_);
@@ -423,7 +434,7 @@ private:
     /**
      * @brief Process an audio frame
      */
-    void processFrame(AudioFrame frame, std::vector<uint8_t>& outBuffer) {
+    void processFrame(AudioFrame frame) {
         // Check for EOF
         if (frame.isEof()) {
             spdlog::info("[{}] Received EOF", name_);
@@ -487,68 +498,75 @@ private:
             return;
         }
         
-        // Calculate output buffer size
-        int outSamples = swr_get_out_samples(swrCtx_, avFrame->nb_samples);
-        if (outSamples <= 0) {
-            spdlog::warn("[{}] swr_get_out_samples returned {}", name_, outSamples);
+        // Resample straight into the ring buffer. Output that does not
+        // fit stays buffered in the resampler until space frees up.
+        const uint8_t** in = const_cast<const uint8_t**>(avFrame->data);
+        int inSamples = avFrame->nb_samples;
+        int pending = swr_get_out_samples(swrCtx_, inSamples);
+        if (pending <= 0) {
+            spdlog::warn("[{}] swr_get_out_samples returned {}", name_, pending);
             return;
         }
         
-        size_t outBufferSize = outSamples * kOutputChannels * kOutputBytesPerSample;
-        outBuffer.resize(outBufferSize);
-        
-        uint8_t* outPtr = outBuffer.data();
-        
-        // Resample
-        int samplesConverted = swr_convert(
-            swrCtx_,
-            &outPtr,
-            outSamples,
-            const_cast<const uint8_t**>(avFrame->data),
-            avFrame->nb_samples
-        );
-        
-        if (samplesConverted < 0) {
-            spdlog::warn("[{}] Resample error: {}", name_, ffmpegErrorString(samplesConverted));
-            return;
-        }
+        size_t samplesConverted = 0;
+        int spinCount = 0;
+        constexpr int kMaxSpinCount = 50;  // Reduced from 100
         
-        if (samplesConverted > 0) {
-            size_t bytesToWrite = samplesConverted * kOutputChannels * kOutputBytesPerSample;
-            
-            // Write to ring buffer (non-blocking when stopping)
-            size_t written = 0;
-            int spinCount = 0;
-            constexpr int kMaxSpinCount = 50;  // Reduced from 100
-            
-            while (written < bytesToWrite && running_.load(std::memory_order_acquire)) {
-                size_t n = ringBuffer_.write(outBuffer.data() + written, bytesToWrite - written);
-                written += n;
-                
-                if (n == 0) {
-                    // Buffer full, wait a bit but check running_ frequently
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                    if (++spinCount > kMaxSpinCount) {
-                        // Don't log if we're shutting down
-                        if (running_.load(std::memory_order_acquire)) {
-                            spdlog::warn("[{}] Ring buffer write timeout", name_);
-                        }
-                        break;
+        while (running_.load(std::memory_order_acquire)) {
+            auto space = ringBuffer_.beginWrite(static_cast<size_t>(pending));
+            if (space.empty()) {
+                // Buffer full, wait a bit but check running_ frequently
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                if (++spinCount > kMaxSpinCount) {
+                    // Don't log if we're shutting down
+                    if (running_.load(std::memory_order_acquire)) {
+                        spdlog::warn("[{}] Ring buffer write timeout", name_);
                     }
+                    break;
                 }
+                continue;
             }
             
-            // Only update stats if we actually wrote something
-            if (written > 0) {
-                uint64_t totalSamples = samplesWritten_.fetch_add(samplesConverted, std::memory_order_relaxed);
+            size_t converted = 0;
+            bool drained = false;
+            for (auto part : {space.first, space.second}) {
+                int capacity = static_cast<int>(part.size() / kOutputChannels);
+                if (capacity == 0) continue;
                 
-                // Log progress periodically (only if still running)
-                if (running_.load(std::memory_order_relaxed)) {
-                    if ((totalSamples / kOutputSampleRate) != ((totalSamples + samplesConverted) / kOutputSampleRate)) {
-                        spdlog::debug("[{}] Audio: {} seconds played, buffer fill: {:.1f}%", 
-                            name_, (totalSamples + samplesConverted) / kOutputSampleRate,
-                            ringBuffer_.fillRatio() * 100.0f);
-                    }
+                auto* outPtr = reinterpret_cast<uint8_t*>(part.data());
+                int n = swr_convert(swrCtx_, &outPtr, capacity, in, inSamples);
+                if (n < 0) {
+                    spdlog::warn("[{}] Resample error: {}", name_, ffmpegErrorString(n));
+                    drained = true;
+                    break;
+                }
+                
+                // The input is consumed (or buffered) by the first call; a
+                // non-null input of 0 samples drains without flushing
+                inSamples = 0;
+                converted += static_cast<size_t>(n);
+                if (n < capacity) {
+                    drained = true;
+                    break;
+                }
+            }
+            ringBuffer_.commitWrite(converted);
+            samplesConverted += converted;
+            
+            if (drained) break;
+            pending = std::max(swr_get_out_samples(swrCtx_, 0), 1);
+        }
+        
+        // Only update stats if we actually wrote something
+        if (samplesConverted > 0) {
+            uint64_t totalSamples = samplesWritten_.fetch_add(samplesConverted, std::memory_order_relaxed);
+            
+            // Log progress periodically (only if still running)
+            if (running_.load(std::memory_order_relaxed)) {
+                if ((totalSamples / kOutputSampleRate) != ((totalSamples + samplesConverted) / kOutputSampleRate)) {
+                    spdlog::debug("[{}] Audio: {} seconds played, buffer fill: {:.1f}%", 
+                        name_, (totalSamples + samplesConverted) / kOutputSampleRate,
+                        ringBuffer_.fillRatio() * 100.0f);
                 }
             }
         }
@@ -576,8 +594,8 @@ private:
     // Error tracking
     int consecutiveErrors_ = 0;
     
-    // Ring buffer
-    LockFreeRingBuffer ringBuffer_;
+    // Ring buffer (interleaved S16 stereo frames)
+    FrameRingBuffer<int16_t> ringBuffer_;
     
     // SDL audio
     SDL_AudioDeviceID audioDeviceId_ = 0;
@@ -21,7 +21,7 @@
 #include "core/clock.hpp"
 #include "render/renderer.hpp"
 
-#include <spdlog/spdlog.h>
+#include <phoenix/core/logger.hpp>
 
 namespace phoenix {
 
@@ -96,7 +96,7 @@ public:
         // Start worker thread
         worker_ = std::thread([this] { workerLoop(); });
         
-        spdlog::info("[{}] Started", name_);
+        LOG_INFO("[{}] Started", name_);
     }
     
     void stop() override {
@@ -110,14 +110,14 @@ public:
             worker_.join();
         }
         
-        spdlog::info("[{}] Stopped. Rendered: {}, Dropped: {}", 
+        LOG_INFO("[{}] Stopped. Rendered: {}, Dropped: {}", 
             name_, framesRendered_.load(), framesDropped_.load());
     }
     
     void flush() override {
         input.flush();
         firstFrame_ = true;
-        spdlog::debug("[{}] Flushed", name_);
+        LOG_DEBUG("[{}] Flushed", name_);
     }
     
     // ========== Statistics ==========
@@ -135,7 +135,7 @@ private:
      * @brief Worker thread loop
      */
     void workerLoop() {
-        spdlog::debug("[{}] Worker started", name_);
+        LOG_DEBUG("[{}] Worker started", name_);
         
         while (running_.load(std::memory_order_acquire)) {
             // Pop frame from input with short timeout for faster shutdown
@@ -162,7 +162,7 @@ private:
             consume(std::move(*frame));
         }
         
-        spdlog::debug("[{}] Worker exited", name_);
+        LOG_DEBUG("[{}] Worker exited", name_);
     }
     
     /**
@@ -171,7 +171,7 @@ private:
     void consume(VideoFrame frame) {
         // Check for EOF
         if (frame.isEof()) {
-            spdlog::info("[{}] Received EOF", name_);
+            LOG_INFO("[{}] Received EOF", name_);
             if (eofCallback_) {
                 eofCallback_();
             }
@@ -181,10 +181,13 @@ private:
         // Check for error frame
         if (frame.isError()) {
             consecutiveErrors_++;
-            spdlog::error("[{}] Received error frame (consecutive: {})", name_, consecutiveErrors_);
+            // A decoder in trouble sends one per packet: rate limit
+            LOG_ERROR_EVERY(kErrorLogIntervalMs, "[{}] Received error frame (consecutive: {})",
+                            name_, consecutiveErrors_);
             
             if (consecutiveErrors_ >= kMaxConsecutiveDecoderErrors) {
-                spdlog::error("[{}] Too many consecutive errors, notifying pipeline", name_);
+                LOG_ERROR_EVERY(kErrorLogIntervalMs, "[{}] Too many consecutive errors, notifying pipeline",
+                                name_);
                 if (errorCallback_) {
                     errorCallback_("Too many consecutive decode errors");
                 }
@@ -198,7 +201,7 @@ private:
         // Filter stale frames (from before seek)
         uint64_t expectedSerial = currentSerial_.load(std::memory_order_acquire);
         if (frame.serial != expectedSerial) {
-            spdlog::trace("[{}] Dropping stale frame (serial {} != {})", 
+            LOG_TRACE("[{}] Dropping stale frame (serial {} != {})", 
                 name_, frame.serial, expectedSerial);
             framesDropped_.fetch_add(1, std::memory_order_relaxed);
             return;
@@ -207,7 +210,7 @@ private:
         // Handle first frame (pre-roll)
         if (firstFrame_) {
             firstFrame_ = false;
-            spdlog::debug("[{}] First frame received, pts={}", name_, frame.pts);
+            LOG_DEBUG("[{}] First frame received, pts={}", name_, frame.pts);
             
             if (readyCallback_) {
                 readyCallback_();
@@ -221,7 +224,7 @@ private:
             switch (action) {
                 case SyncAction::Drop:
                     framesDropped_.fetch_add(1, std::memory_order_relaxed);
-                    spdlog::trace("[{}] Dropping late frame pts={}", name_, frame.pts);
+                    LOG_TRACE("[{}] Dropping late frame pts={}", name_, frame.pts);
                     return;
                     
                 case SyncAction::Wait:
@@ -297,7 +300,7 @@ private:
             renderer_->present();
             framesRendered_.fetch_add(1, std::memory_order_relaxed);
         } else {
-            spdlog::warn("[{}] Render failed: {}", name_, result.error().what());
+            LOG_WARN_EVERY(kErrorLogIntervalMs, "[{}] Render failed: {}", name_, result.error().what());
         }
     }
     